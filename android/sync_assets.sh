@@ -4,6 +4,8 @@
 # SDL_RWFromFile resolves relative paths inside the APK assets, so
 # asset_resolve()'s paths work unchanged. Only the shipped layers are copied
 # (common/ + locales); _inbox/ and _sources/ never ship, same as the web.
+# A root with a pack (make pack, which make android runs) ships as that one
+# file instead: the engine mounts it and never looks for the loose files.
 # Re-run after changing assets (make android does); the destination is
 # git-ignored and rebuilt from scratch every time.
 set -eu
@@ -21,15 +23,28 @@ copy_tree() {
   fi
 }
 
+copy_pack() {
+  mkdir -p "$DEST/$(dirname "$1")"
+  cp "$1.pack" "$DEST/$1.pack"
+}
+
 for adv in src/adventures/*/assets; do
+  if [ -f "$adv.pack" ]; then
+    copy_pack "$adv"
+    continue
+  fi
   copy_tree "$adv/common"
   copy_tree "$adv/it_IT"
   copy_tree "$adv/en_US"
 done
 # Engine-owned assets, shared by every adventure: the subtitle font and the
 # UI art (assets/index.json).
-copy_tree assets/fonts
-copy_tree assets/ui
-copy_tree assets/hub
+if [ -f assets.pack ]; then
+  copy_pack assets
+else
+  copy_tree assets/fonts
+  copy_tree assets/ui
+  copy_tree assets/hub
+fi
 
 echo "APK assets synced to $DEST ($(find "$DEST" -type f | wc -l) files)."
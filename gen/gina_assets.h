@@ -2,6 +2,8 @@
 #ifndef GEN_GINA_ASSETS_H
 #define GEN_GINA_ASSETS_H
 
+#include <SDL2/SDL.h>
+
 void scene_say(int index);
 
 // ── grapes ─────────────────────────────────────────────
@@ -441,6 +443,30 @@ static inline void say_basket_full(void) { scene_say(GINA_VINE_DIALOG_CHUNK_BASK
 #define GINA_VINE_DIALOG_CHUNKS_COUNT 3
 #define GINA_VINE_DIALOG_CHUNKS_INIT {GINA_VINE_DIALOG_CHUNK_ALREADY_GRAPES_INIT, GINA_VINE_DIALOG_CHUNK_NOTHING_TO_PICK_INIT, GINA_VINE_DIALOG_CHUNK_BASKET_FULL_INIT}
 
+// ── animation clip tables (the .anim files, compiled in) ──
+static const SDL_Rect GINA_CLIPS_COMMON_GRAPES_CELEBRATION[] = {{0, 0, 240, 240}, {0, 240, 240, 240}, {0, 480, 240, 240}, {0, 720, 240, 240}, {0, 960, 240, 240}, {0, 1200, 240, 240}, {0, 1440, 240, 240}, {0, 1680, 240, 240}};
+static const SDL_Rect GINA_CLIPS_COMMON_HEN_FLOATING[] = {{0, 0, 120, 120}, {0, 120, 120, 120}, {0, 240, 120, 120}};
+static const SDL_Rect GINA_CLIPS_COMMON_HEN_IDLE[] = {{0, 0, 120, 120}, {0, 120, 120, 120}};
+static const SDL_Rect GINA_CLIPS_COMMON_HEN_TALKING[] = {{0, 0, 120, 120}, {0, 120, 120, 120}, {0, 240, 120, 120}};
+static const SDL_Rect GINA_CLIPS_COMMON_HEN_WALKING[] = {{0, 0, 120, 120}, {0, 120, 120, 120}, {0, 240, 120, 120}, {0, 360, 120, 120}};
+static const SDL_Rect GINA_CLIPS_COMMON_ITEMS_FLOAT_BOIL[] = {{0, 0, 90, 60}, {0, 60, 90, 60}, {0, 120, 90, 60}};
+static const SDL_Rect GINA_CLIPS_COMMON_ITEMS_GOGGLES_BOIL[] = {{0, 0, 60, 30}, {0, 30, 60, 30}, {0, 60, 60, 30}};
+static const SDL_Rect GINA_CLIPS_COMMON_NAV_TO_POOL_BOIL[] = {{0, 0, 90, 90}, {0, 90, 90, 90}, {0, 180, 90, 90}};
+static const SDL_Rect GINA_CLIPS_COMMON_NAV_TO_TREE_BOIL[] = {{0, 0, 90, 90}, {0, 90, 90, 90}, {0, 180, 90, 90}};
+static const SDL_Rect GINA_CLIPS_COMMON_NAV_TO_VINE_BOIL[] = {{0, 0, 90, 90}, {0, 90, 90, 90}, {0, 180, 90, 90}};
+static const SDL_Rect GINA_CLIPS_COMMON_POOL_CELEBRATION[] = {{0, 0, 240, 240}, {0, 240, 240, 240}, {0, 480, 240, 240}, {0, 720, 240, 240}, {0, 960, 240, 240}, {0, 1200, 240, 240}, {0, 1440, 240, 240}, {0, 1680, 240, 240}};
+static const SDL_Rect GINA_CLIPS_COMMON_POOL_SUNSCREEN_BOIL[] = {{0, 0, 40, 60}, {0, 60, 40, 60}, {0, 120, 40, 60}};
+static const SDL_Rect GINA_CLIPS_COMMON_SUNSCREEN_CELEBRATION[] = {{0, 0, 240, 240}, {0, 240, 240, 240}, {0, 480, 240, 240}, {0, 720, 240, 240}, {0, 960, 240, 240}, {0, 1200, 240, 240}, {0, 1440, 240, 240}, {0, 1680, 240, 240}};
+static const SDL_Rect GINA_CLIPS_COMMON_TREE_CARLA_BOIL[] = {{0, 0, 70, 70}, {0, 70, 70, 70}, {0, 140, 70, 70}};
+static const SDL_Rect GINA_CLIPS_COMMON_TREE_CELEBRATION[] = {{0, 0, 240, 240}, {0, 240, 240, 240}, {0, 480, 240, 240}, {0, 720, 240, 240}, {0, 960, 240, 240}, {0, 1200, 240, 240}, {0, 1440, 240, 240}, {0, 1680, 240, 240}};
+static const SDL_Rect GINA_CLIPS_COMMON_VINE_GRAPES_BOIL[] = {{0, 0, 100, 120}, {0, 120, 100, 120}, {0, 240, 100, 120}};
+static const SDL_Rect GINA_CLIPS_EN_US_INTRO_EXIT_BUTTON[] = {{0, 0, 265, 96}, {0, 96, 265, 96}, {0, 192, 265, 96}};
+static const SDL_Rect GINA_CLIPS_EN_US_INTRO_PLAY_BUTTON[] = {{0, 0, 280, 120}, {0, 120, 280, 120}, {0, 240, 280, 120}};
+static const SDL_Rect GINA_CLIPS_IT_IT_INTRO_EXIT_BUTTON[] = {{0, 0, 265, 96}, {0, 96, 265, 96}, {0, 192, 265, 96}};
+static const SDL_Rect GINA_CLIPS_IT_IT_INTRO_PLAY_BUTTON[] = {{0, 0, 280, 120}, {0, 120, 280, 120}, {0, 240, 280, 120}};
+#define GINA_ANIM_CLIPS_COUNT 20
+#define GINA_ANIM_CLIPS_INIT {{"common/grapes/celebration.anim", 8, GINA_CLIPS_COMMON_GRAPES_CELEBRATION, NULL}, {"common/hen/floating.anim", 3, GINA_CLIPS_COMMON_HEN_FLOATING, NULL}, {"common/hen/idle.anim", 2, GINA_CLIPS_COMMON_HEN_IDLE, NULL}, {"common/hen/talking.anim", 3, GINA_CLIPS_COMMON_HEN_TALKING, NULL}, {"common/hen/walking.anim", 4, GINA_CLIPS_COMMON_HEN_WALKING, NULL}, {"common/items/float_boil.anim", 3, GINA_CLIPS_COMMON_ITEMS_FLOAT_BOIL, NULL}, {"common/items/goggles_boil.anim", 3, GINA_CLIPS_COMMON_ITEMS_GOGGLES_BOIL, NULL}, {"common/nav/to_pool_boil.anim", 3, GINA_CLIPS_COMMON_NAV_TO_POOL_BOIL, NULL}, {"common/nav/to_tree_boil.anim", 3, GINA_CLIPS_COMMON_NAV_TO_TREE_BOIL, NULL}, {"common/nav/to_vine_boil.anim", 3, GINA_CLIPS_COMMON_NAV_TO_VINE_BOIL, NULL}, {"common/pool/celebration.anim", 8, GINA_CLIPS_COMMON_POOL_CELEBRATION, NULL}, {"common/pool/sunscreen_boil.anim", 3, GINA_CLIPS_COMMON_POOL_SUNSCREEN_BOIL, NULL}, {"common/sunscreen/celebration.anim", 8, GINA_CLIPS_COMMON_SUNSCREEN_CELEBRATION, NULL}, {"common/tree/carla_boil.anim", 3, GINA_CLIPS_COMMON_TREE_CARLA_BOIL, NULL}, {"common/tree/celebration.anim", 8, GINA_CLIPS_COMMON_TREE_CELEBRATION, NULL}, {"common/vine/grapes_boil.anim", 3, GINA_CLIPS_COMMON_VINE_GRAPES_BOIL, NULL}, {"en_US/intro/exit_button.anim", 3, GINA_CLIPS_EN_US_INTRO_EXIT_BUTTON, NULL}, {"en_US/intro/play_button.anim", 3, GINA_CLIPS_EN_US_INTRO_PLAY_BUTTON, NULL}, {"it_IT/intro/exit_button.anim", 3, GINA_CLIPS_IT_IT_INTRO_EXIT_BUTTON, NULL}, {"it_IT/intro/play_button.anim", 3, GINA_CLIPS_IT_IT_INTRO_PLAY_BUTTON, NULL}}
+
 // ── sound effects (adventure-wide bank; play via play_<name>()) ──
 int sfx_play(int index);
 #define GINA_SFX_PLAY_BUTTON_CLICK 0
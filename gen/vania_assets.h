@@ -2,6 +2,8 @@
 #ifndef GEN_VANIA_ASSETS_H
 #define GEN_VANIA_ASSETS_H
 
+#include <SDL2/SDL.h>
+
 void scene_say(int index);
 
 // ── fox ─────────────────────────────────────────────
@@ -216,6 +218,21 @@ static inline void say_examine_slide_from_outside(void) { scene_say(VANIA_PLAYGR
 #define VANIA_PLAYGROUND_ENTRANCE_DIALOG_CHUNKS_COUNT 3
 #define VANIA_PLAYGROUND_ENTRANCE_DIALOG_CHUNKS_INIT {VANIA_PLAYGROUND_ENTRANCE_DIALOG_CHUNK_EXAMINE_GATE_1_INIT, VANIA_PLAYGROUND_ENTRANCE_DIALOG_CHUNK_EXAMINE_GATE_2_INIT, VANIA_PLAYGROUND_ENTRANCE_DIALOG_CHUNK_EXAMINE_SLIDE_FROM_OUTSIDE_INIT}
 
+// ── animation clip tables (the .anim files, compiled in) ──
+static const SDL_Rect VANIA_CLIPS_COMMON_FOX_SITTING[] = {{0, 0, 96, 135}, {96, 0, 96, 135}, {0, 135, 96, 135}};
+static const SDL_Rect VANIA_CLIPS_COMMON_FOX_TALKING[] = {{0, 0, 144, 117}, {0, 0, 144, 117}, {0, 234, 144, 117}, {0, 117, 144, 117}, {0, 117, 144, 117}, {0, 234, 144, 117}, {0, 234, 144, 117}};
+static const SDL_Rect VANIA_CLIPS_COMMON_FOX_WALKING[] = {{0, 0, 144, 117}, {0, 117, 144, 117}, {0, 234, 144, 117}, {0, 351, 144, 117}};
+static const SDL_Rect VANIA_CLIPS_COMMON_FOX_WAVING[] = {{0, 0, 93, 132}, {93, 0, 93, 132}, {0, 132, 93, 132}};
+static const SDL_Rect VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_EXCAVATOR[] = {{0, 0, 119, 56}, {0, 56, 119, 56}, {0, 112, 119, 56}, {0, 168, 119, 56}};
+static const SDL_Rect VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_GATE[] = {{0, 0, 182, 208}, {182, 0, 182, 208}, {0, 208, 182, 208}, {182, 208, 182, 208}, {0, 416, 182, 208}, {182, 416, 182, 208}, {0, 624, 182, 208}};
+static const SDL_Rect VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_SHOVEL[] = {{0, 0, 88, 67}, {88, 0, 88, 67}, {0, 67, 88, 67}, {88, 67, 88, 67}, {0, 134, 88, 67}};
+static const SDL_Rect VANIA_CLIPS_EN_US_INTRO_EXIT_BUTTON[] = {{0, 0, 265, 81}, {0, 81, 265, 81}, {0, 162, 265, 81}};
+static const SDL_Rect VANIA_CLIPS_EN_US_INTRO_PLAY_BUTTON[] = {{0, 0, 280, 162}, {0, 162, 280, 162}, {0, 324, 280, 162}};
+static const SDL_Rect VANIA_CLIPS_IT_IT_INTRO_EXIT_BUTTON[] = {{0, 0, 265, 81}, {0, 81, 265, 81}, {0, 162, 265, 81}};
+static const SDL_Rect VANIA_CLIPS_IT_IT_INTRO_PLAY_BUTTON[] = {{0, 0, 280, 162}, {0, 162, 280, 162}, {0, 324, 280, 162}};
+#define VANIA_ANIM_CLIPS_COUNT 11
+#define VANIA_ANIM_CLIPS_INIT {{"common/fox/sitting.anim", 3, VANIA_CLIPS_COMMON_FOX_SITTING, NULL}, {"common/fox/talking.anim", 7, VANIA_CLIPS_COMMON_FOX_TALKING, NULL}, {"common/fox/walking.anim", 4, VANIA_CLIPS_COMMON_FOX_WALKING, NULL}, {"common/fox/waving.anim", 3, VANIA_CLIPS_COMMON_FOX_WAVING, NULL}, {"common/playground_entrance/excavator.anim", 4, VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_EXCAVATOR, NULL}, {"common/playground_entrance/gate.anim", 7, VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_GATE, NULL}, {"common/playground_entrance/shovel.anim", 5, VANIA_CLIPS_COMMON_PLAYGROUND_ENTRANCE_SHOVEL, NULL}, {"en_US/intro/exit_button.anim", 3, VANIA_CLIPS_EN_US_INTRO_EXIT_BUTTON, NULL}, {"en_US/intro/play_button.anim", 3, VANIA_CLIPS_EN_US_INTRO_PLAY_BUTTON, NULL}, {"it_IT/intro/exit_button.anim", 3, VANIA_CLIPS_IT_IT_INTRO_EXIT_BUTTON, NULL}, {"it_IT/intro/play_button.anim", 3, VANIA_CLIPS_IT_IT_INTRO_PLAY_BUTTON, NULL}}
+
 // ── sound effects (adventure-wide bank; play via play_<name>()) ──
 int sfx_play(int index);
 #define VANIA_SFX_PLAY_BUTTON_CLICK 0
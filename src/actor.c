@@ -11,8 +11,10 @@
 #include <stdlib.h>
 
 #include "actor.h"
+#include "arena.h"
 #include "clock.h"
 #include "constants.h"
+#include "draw.h"
 #include "image.h"
 #include "sound.h"
 #include "subtitle.h"
@@ -152,7 +154,7 @@ static void touch_down(Actor *actor) {
 
 Actor *make_actor(const ActorSpec *spec, SDL_FPoint initial_position,
                   const ScaleRamp *scale_ramp) {
-  Actor *actor = malloc(sizeof(Actor));
+  Actor *actor = arena_scoped_alloc(sizeof(Actor));
   if (actor == NULL) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "make_actor: out of memory");
     return NULL;
@@ -193,6 +195,7 @@ Actor *make_actor(const ActorSpec *spec, SDL_FPoint initial_position,
   actor->drag_armed = false;
   actor->drag_grab = (SDL_FPoint){0, 0};
   actor->drag_offset_y = 0;
+  actor->holds_shadow = false;
   // Where she stands. No sprite is loaded yet, so the feet offset is still 0;
   // every grab sets this again from her real feet.
   actor->ground_y = actor_feet_y(actor);
@@ -221,7 +224,7 @@ float actor_feet_offset(const Actor *actor) {
   if (reference == NULL) {
     return 0.0F;
   }
-  return reference->sprite_clips[0].h / 2.0F;
+  return animation_frame_size(reference, 0).y / 2.0F;
 }
 
 float actor_feet_y(const Actor *actor) {
@@ -262,22 +265,97 @@ bool actor_shadow_visible(const Actor *actor) {
          actor_feet_y(actor) < actor->ground_y - ACTOR_ARRIVE_EPSILON;
 }
 
-void actor_render_shadow(const Actor *actor, SDL_Renderer *renderer) {
+// The landing shadow's art, generated once and shared by every actor: a black
+// disc whose alpha eases to zero over its outer rim. Each draw is then one
+// scaled, alpha-modulated copy instead of a line per scanline. Refcounted by
+// the actors that loaded media (Actor.holds_shadow), so the last actor_free
+// destroys it.
+#define SHADOW_TEXTURE_SIZE 64
+static SDL_Texture *shadow_texture = NULL;
+static int shadow_refs = 0;
+
+static SDL_Texture *make_shadow_texture(SDL_Renderer *renderer) {
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+      0, SHADOW_TEXTURE_SIZE, SHADOW_TEXTURE_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+  if (surface == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Failed to create the shadow surface: %s", SDL_GetError());
+    return NULL;
+  }
+  float radius = SHADOW_TEXTURE_SIZE / 2.0F;
+  for (int y = 0; y < SHADOW_TEXTURE_SIZE; y++) {
+    Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+    for (int x = 0; x < SHADOW_TEXTURE_SIZE; x++) {
+      // Distance from the centre in radii, sampled at the pixel centre.
+      float dx = ((float)x + 0.5F - radius) / radius;
+      float dy = ((float)y + 0.5F - radius) / radius;
+      float d = sqrtf(dx * dx + dy * dy);
+      // Solid out to 3/4 of the radius, then a smoothstep down to nothing.
+      float t = (d - 0.75F) / 0.25F;
+      t = t < 0.0F ? 0.0F : (t > 1.0F ? 1.0F : t);
+      float alpha = 1.0F - t * t * (3.0F - 2.0F * t);
+      row[x * 4 + 0] = 0;
+      row[x * 4 + 1] = 0;
+      row[x * 4 + 2] = 0;
+      row[x * 4 + 3] = (Uint8)(alpha * 255.0F + 0.5F);
+    }
+  }
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+  SDL_FreeSurface(surface);
+  if (texture == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Failed to create the shadow texture: %s", SDL_GetError());
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  return texture;
+}
+
+static bool acquire_shadow_texture(SDL_Renderer *renderer) {
+  if (shadow_texture == NULL) {
+    shadow_texture = make_shadow_texture(renderer);
+    if (shadow_texture == NULL) {
+      return false;
+    }
+  }
+  shadow_refs++;
+  return true;
+}
+
+static void release_shadow_texture(void) {
+  if (--shadow_refs == 0) {
+    SDL_DestroyTexture(shadow_texture);
+    shadow_texture = NULL;
+  }
+}
+
+SDL_Rect actor_shadow_rect(const Actor *actor) {
   AnimationData *reference = reference_animation((Actor *)actor);
   if (reference == NULL) {
-    return;
+    return (SDL_Rect){0, 0, 0, 0};
   }
   float scale = actor_scale(actor);
-  // An ellipse roughly the width of her footprint, flattened. Drawn as
-  // scanlines: SDL has no ellipse primitive, and this needs no art to ship.
-  int rx = (int)((float)reference->sprite_clips[0].w * 0.30F * scale);
+  // An ellipse roughly the width of her footprint, flattened.
+  float frame_w = (float)animation_frame_size(reference, 0).x;
+  int rx = (int)(frame_w * 0.30F * scale);
   int ry = (int)((float)rx * 0.32F);
   if (rx <= 0 || ry <= 0) {
+    return (SDL_Rect){0, 0, 0, 0};
+  }
+  int cx = (int)actor->current_position.x;
+  int cy = (int)actor->ground_y;
+  return (SDL_Rect){cx - rx, cy - ry, 2 * rx + 1, 2 * ry + 1};
+}
+
+void actor_render_shadow(const Actor *actor, SDL_Renderer *renderer) {
+  SDL_Rect quad = actor_shadow_rect(actor);
+  if (shadow_texture == NULL || quad.w <= 0 || quad.h <= 0) {
     return;
   }
+  // A raw texture copy, not a render_image: apply the camera offset here.
   SDL_Point offset = render_get_offset();
-  int cx = (int)actor->current_position.x + offset.x;
-  int cy = (int)actor->ground_y + offset.y;
+  quad.x += offset.x;
+  quad.y += offset.y;
   // Fade with height, so the gap between her and the shadow reads as lift.
   float lift = actor->ground_y - actor_feet_y(actor);
   float fade = 1.0F - lift / 400.0F;
@@ -287,16 +365,23 @@ void actor_render_shadow(const Actor *actor, SDL_Renderer *renderer) {
   if (fade > 1.0F) {
     fade = 1.0F;
   }
-  SDL_BlendMode previous;
-  SDL_GetRenderDrawBlendMode(renderer, &previous);
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, (Uint8)(90.0F * fade));
-  for (int dy = -ry; dy <= ry; dy++) {
-    float t = (float)dy / (float)ry;
-    int half = (int)((float)rx * sqrtf(1.0F - t * t));
-    SDL_RenderDrawLine(renderer, cx - half, cy + dy, cx + half, cy + dy);
+  SDL_SetTextureAlphaMod(shadow_texture, (Uint8)(90.0F * fade));
+  draw_copy(renderer, shadow_texture, NULL, &quad);
+}
+
+void actor_prefetch_media(const ActorSpec *spec, SDL_Renderer *renderer) {
+  for (int i = 0; i < spec->anims_length; i++) {
+    image_prefetch(renderer, (Asset){
+                                 .filename = spec->anims[i].sprite_filename,
+                                 .directory = spec->assets_dir,
+                             });
+  }
+  for (int i = 0; i < fidget_count(spec); i++) {
+    image_prefetch(renderer, (Asset){
+                                 .filename = spec->fidgets[i].sprite_filename,
+                                 .directory = spec->assets_dir,
+                             });
   }
-  SDL_SetRenderDrawBlendMode(renderer, previous);
 }
 
 bool actor_load_media(Actor *actor, SDL_Renderer *renderer) {
@@ -363,7 +448,7 @@ bool actor_load_media(Actor *actor, SDL_Renderer *renderer) {
             .directory = spec->assets_dir,
         },
         move_sound_path, sizeof(move_sound_path));
-    actor->move_sound = Mix_LoadWAV(move_sound_path);
+    actor->move_sound = load_wav_chunk(move_sound_path);
     if (actor->move_sound == NULL) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                    "Failed to load %s move sound: %s", spec->id,
@@ -374,6 +459,13 @@ bool actor_load_media(Actor *actor, SDL_Renderer *renderer) {
     Mix_VolumeChunk(actor->move_sound, spec->move_sound_volume);
   }
 
+  if (!actor->holds_shadow) {
+    if (!acquire_shadow_texture(renderer)) {
+      return false;
+    }
+    actor->holds_shadow = true;
+  }
+
   return true;
 }
 
@@ -539,10 +631,11 @@ void actor_render(Actor *actor, SDL_Renderer *renderer) {
     return;
   }
 
-  // Assumes that all animation frames have the same size.
-  SDL_Point position = (SDL_Point){
-      .x = (int)actor->current_position.x - reference->sprite_clips[0].w / 2,
-      .y = (int)actor->current_position.y - reference->sprite_clips[0].h / 2};
+  // Assumes that all animation frames have the same (untrimmed) size.
+  SDL_Point frame = animation_frame_size(reference, 0);
+  SDL_Point position =
+      (SDL_Point){.x = (int)actor->current_position.x - frame.x / 2,
+                  .y = (int)actor->current_position.y - frame.y / 2};
 
   // IDLE renders the actor's idle animation (e.g. the fox's sitting sprite);
   // FIDGETING renders the active fidget (they live outside the state table).
@@ -590,15 +683,15 @@ void actor_render_carried(const Actor *actor, SDL_Renderer *renderer,
                                                      : SDL_FLIP_NONE);
 }
 
-void actor_free(Actor *actor) {
+void actor_free_media(Actor *actor) {
   for (int i = 0; i < ACTOR_STATE_COUNT; i++) {
     if (actor->animations[i]) {
-      free_animation(actor->animations[i]);
+      free_image_texture(&actor->animations[i]->image);
     }
   }
   for (int i = 0; i < ACTOR_MAX_FIDGETS; i++) {
     if (actor->fidget_anims[i]) {
-      free_animation(actor->fidget_anims[i]);
+      free_image_texture(&actor->fidget_anims[i]->image);
     }
   }
   if (actor->move_sound) {
@@ -606,10 +699,30 @@ void actor_free(Actor *actor) {
     // (a use-after-free otherwise, especially on Emscripten's audio thread).
     if (actor->move_sound_channel >= 0) {
       Mix_HaltChannel(actor->move_sound_channel);
+      actor->move_sound_channel = -1;
     }
     Mix_FreeChunk(actor->move_sound);
+    actor->move_sound = NULL;
+  }
+  if (actor->holds_shadow) {
+    release_shadow_texture();
+    actor->holds_shadow = false;
+  }
+}
+
+void actor_free(Actor *actor) {
+  actor_free_media(actor);
+  for (int i = 0; i < ACTOR_STATE_COUNT; i++) {
+    if (actor->animations[i]) {
+      free_animation(actor->animations[i]);
+    }
+  }
+  for (int i = 0; i < ACTOR_MAX_FIDGETS; i++) {
+    if (actor->fidget_anims[i]) {
+      free_animation(actor->fidget_anims[i]);
+    }
   }
-  free(actor);
+  arena_scoped_free(actor);
 }
 
 void actor_place(Actor *actor, SDL_FPoint at) {
@@ -768,8 +881,9 @@ SDL_Rect actor_sprite_rect(const Actor *actor) {
     return (SDL_Rect){(int)actor->current_position.x,
                       (int)actor->current_position.y, 0, 0};
   }
-  int w = reference->sprite_clips[0].w;
-  int h = reference->sprite_clips[0].h;
+  SDL_Point frame = animation_frame_size(reference, 0);
+  int w = frame.x;
+  int h = frame.y;
   // The same natural origin, scale and ground anchor actor_render draws with,
   // so the grab box tracks the sprite instead of drifting off it by
   // (1 - scale) * h / 2. No render offset here: clicks arrive already
@@ -150,6 +150,9 @@ typedef struct actor {
   // from Scene.scale_ramp. NULL (the poster scenes and minigames) means she is
   // always drawn at scale 1.
   const ScaleRamp *scale_ramp;
+  // Whether actor_load_media took a reference on the shared shadow texture,
+  // which actor_free_media (or actor_free) then gives back.
+  bool holds_shadow;
 } Actor;
 
 // scale_ramp is borrowed, not copied: it must outlive the actor. Pass NULL for
@@ -185,9 +188,23 @@ float actor_scale(const Actor *actor);
 // draws her landing shadow there — the gap between her and it is the lift.
 bool actor_shadow_visible(const Actor *actor);
 void actor_render_shadow(const Actor *actor, SDL_Renderer *renderer);
+// Where the shadow's quad lands in scene space (before the camera offset), or
+// an empty rect when she has no sprite to size it from. Split out so the
+// geometry can be tested without a renderer.
+SDL_Rect actor_shadow_rect(const Actor *actor);
 
 bool actor_load_media(Actor *actor, SDL_Renderer *renderer);
 
+// Give back what actor_load_media loaded (sheet textures, the move sound, the
+// shadow reference) but keep the actor itself, so a later actor_load_media
+// brings her back as she was. How an evicted adventure's actors let go of
+// their media (adventure_free_media).
+void actor_free_media(Actor *actor);
+
+// Queue the sheets actor_load_media will load for parallel decode
+// (image_prefetch), in the same order.
+void actor_prefetch_media(const ActorSpec *spec, SDL_Renderer *renderer);
+
 void actor_update(Actor *actor, float delta_time);
 
 // Draws the actor alone. Scenes go through render_action_layer (scene.h)
@@ -9,10 +9,61 @@
 #include "adventure.h"
 
 #include "actor.h"
+#include "arena.h"
 #include "asset.h"
+#include "image.h"
 #include "scene.h"
+#include "trace.h"
+
+// Each adventure's arenas, claimed by the adventure on first use.
+typedef struct adventure_arenas {
+  const Adventure *adventure;
+  Arena objects; // adventure_init to adventure_deinit
+  Arena media;   // adventure_load_media to adventure_free_media
+} AdventureArenas;
+
+static AdventureArenas arenas[ADVENTURE_ARENAS_MAX];
+
+static AdventureArenas *arenas_of(const Adventure *adventure) {
+  for (int i = 0; i < ADVENTURE_ARENAS_MAX; i++) {
+    if (arenas[i].adventure == adventure) {
+      return &arenas[i];
+    }
+  }
+  for (int i = 0; i < ADVENTURE_ARENAS_MAX; i++) {
+    if (arenas[i].adventure == NULL) {
+      arenas[i].adventure = adventure;
+      return &arenas[i];
+    }
+  }
+  return NULL;
+}
+
+// Put one of the adventure's arenas in force; NULL (the heap) when it has
+// none.
+static Arena *use_arena(const Adventure *adventure, bool media) {
+  AdventureArenas *owned = arenas_of(adventure);
+  if (owned == NULL) {
+    return arena_use(NULL);
+  }
+  return arena_use(media ? &owned->media : &owned->objects);
+}
+
+AdventureMemory adventure_memory(const Adventure *adventure) {
+  AdventureArenas *owned = arenas_of(adventure);
+  if (owned == NULL) {
+    return (AdventureMemory){0};
+  }
+  return (AdventureMemory){owned->objects.used, owned->media.used,
+                           owned->objects.reserved + owned->media.reserved};
+}
 
 void adventure_init(const Adventure *adventure) {
+  register_animation_clips(adventure->assets_root, adventure->anim_clips,
+                           adventure->anim_clips_length);
+  // Everything made here — the declarative animations, the actors and what
+  // their makers allocate — lives until adventure_deinit.
+  Arena *previous = use_arena(adventure, false);
   for (int i = 0; i < adventure->scenes_length; i++) {
     Scene *scene = &adventure->scenes[i];
     // Make the scene's declarative animations before its init, so init can hand
@@ -29,14 +80,54 @@ void adventure_init(const Adventure *adventure) {
     }
     scene->init();
   }
+  arena_use(previous);
 }
 
-bool adventure_load_media(const Adventure *adventure, SDL_Renderer *renderer) {
+static void prefetch_image(const ImageData *image, SDL_Renderer *renderer) {
+  image_prefetch(renderer, (Asset){
+                               .filename = image->filename,
+                               .directory = image->directory,
+                           });
+}
+
+void adventure_prefetch_media(const Adventure *adventure,
+                              SDL_Renderer *renderer) {
+  asset_set_root(adventure->assets_root);
+  for (int i = 0; i < adventure->images_length; i++) {
+    prefetch_image(&adventure->images[i], renderer);
+  }
+  for (int i = 0; i < adventure->scenes_length; i++) {
+    const Scene *scene = &adventure->scenes[i];
+    if (scene->actor_spec != NULL) {
+      actor_prefetch_media(scene->actor_spec, renderer);
+    }
+    for (int j = 0; j < scene->images_length; j++) {
+      prefetch_image(&scene->images[j], renderer);
+    }
+    for (int j = 0; j < scene->bg_planes_length; j++) {
+      prefetch_image(&scene->bg_planes[j].image, renderer);
+    }
+    for (int j = 0; j < scene->fg_planes_length; j++) {
+      prefetch_image(&scene->fg_planes[j].image, renderer);
+    }
+    for (int j = 0; j < scene->anim_specs_length; j++) {
+      image_prefetch(renderer, scene->anim_specs[j].sprite);
+    }
+  }
+}
+
+static bool load_adventure_media(const Adventure *adventure,
+                                 SDL_Renderer *renderer) {
   // Resolve this adventure's assets from its own directory.
   asset_set_root(adventure->assets_root);
 
   // The shared banks: loaded once for the whole adventure, before its scenes.
-  if (!load_chunk_table(adventure->sfx, adventure->sfx_length)) {
+  // Chunks' dialogue sidecars go to the media arena, which
+  // adventure_free_media gives back whole.
+  Arena *previous = use_arena(adventure, true);
+  bool loaded = load_chunk_table(adventure->sfx, adventure->sfx_length);
+  arena_use(previous);
+  if (!loaded) {
     return false;
   }
   if (!load_image_table(renderer, adventure->images,
@@ -62,7 +153,10 @@ bool adventure_load_media(const Adventure *adventure, SDL_Renderer *renderer) {
     if (!load_scene_planes(scene, renderer)) {
       return false;
     }
-    if (!load_scene_chunks(scene)) {
+    previous = use_arena(adventure, true);
+    loaded = load_scene_chunks(scene);
+    arena_use(previous);
+    if (!loaded) {
       return false;
     }
     if (!load_scene_animations(scene, renderer)) {
@@ -72,9 +166,42 @@ bool adventure_load_media(const Adventure *adventure, SDL_Renderer *renderer) {
       return false;
     }
   }
+  AdventureMemory memory = adventure_memory(adventure);
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "%s: %zu bytes of engine data (%zu made at init, %zu with its "
+              "media) in %zu KB of arena blocks",
+              adventure->id, memory.objects + memory.media, memory.objects,
+              memory.media, memory.reserved / 1024);
   return true;
 }
 
+bool adventure_load_media(const Adventure *adventure, SDL_Renderer *renderer) {
+  TRACE_BEGIN_DETAIL("adventure_load_media", adventure->id);
+  bool loaded = load_adventure_media(adventure, renderer);
+  TRACE_END("adventure_load_media");
+  return loaded;
+}
+
+void adventure_free_media(const Adventure *adventure) {
+  for (int i = 0; i < adventure->scenes_length; i++) {
+    Scene *scene = &adventure->scenes[i];
+    if (scene->actor_spec != NULL) {
+      actor_free_media(*scene->actor);
+    }
+    free_scene_images(scene);
+    free_scene_planes(scene);
+    free_scene_chunks(scene);
+    unload_scene_animations(scene);
+    free_scene_music(scene);
+  }
+  free_chunk_table(adventure->sfx, adventure->sfx_length);
+  free_image_table(adventure->images, adventure->images_length);
+  AdventureArenas *owned = arenas_of(adventure);
+  if (owned != NULL) {
+    arena_reset(&owned->media);
+  }
+}
+
 void adventure_deinit(const Adventure *adventure) {
   for (int i = 0; i < adventure->scenes_length; i++) {
     Scene *scene = &adventure->scenes[i];
@@ -94,4 +221,11 @@ void adventure_deinit(const Adventure *adventure) {
   }
   free_chunk_table(adventure->sfx, adventure->sfx_length);
   free_image_table(adventure->images, adventure->images_length);
+  // Every object above was handed back one by one, a no-op for those in the
+  // arenas; this is where their memory goes.
+  AdventureArenas *owned = arenas_of(adventure);
+  if (owned != NULL) {
+    arena_reset(&owned->objects);
+    arena_reset(&owned->media);
+  }
 }
@@ -43,6 +43,13 @@ typedef struct adventure {
   ImageData *images;
   int images_length;
 
+  // Its .anim clip tables, compiled in from the generated asset header
+  // (<PREFIX>_ANIM_CLIPS_INIT): adventure_init registers them, and its
+  // animations then load without opening a file each. NULL/0 reads them all
+  // from disk.
+  const AnimationClips *anim_clips;
+  int anim_clips_length;
+
   // How this adventure shows up on the selection screen (see hub.c): the
   // picture in the middle of its cartridge, and the colour of the cartridge
   // body. The icon is text-bearing (it carries the adventure's name), so it is
@@ -60,11 +67,43 @@ typedef struct adventure {
 // Initialize every scene in the adventure.
 void adventure_init(const Adventure *adventure);
 
+// Queue the images adventure_load_media is about to load, in its order, for
+// the parallel decode pool (image_prefetch): the shared bank, then each
+// scene's actor sheets, images, planes and declarative animations. A scene's
+// own load_media is opaque; whatever it loads decodes when it asks.
+void adventure_prefetch_media(const Adventure *adventure,
+                              SDL_Renderer *renderer);
+
 // Load every scene's media (the adventure's own assets root is selected first).
 // Returns false as soon as any scene fails to load.
 bool adventure_load_media(const Adventure *adventure, SDL_Renderer *renderer);
 
+// Free what adventure_load_media loaded — every scene's images, planes,
+// animation sheets, chunks, music and actor media, and the shared banks — but
+// keep the scenes and their actors initialized, so adventure_load_media can
+// bring the adventure back. What a scene's own load_media loaded is not
+// known here and stays, so an evictable adventure declares its media in the
+// scene tables (every content adventure does).
+void adventure_free_media(const Adventure *adventure);
+
 // Deinitialize every scene and free its loaded media.
 void adventure_deinit(const Adventure *adventure);
 
+// Adventures that can hold engine data in arenas at once (arena.h); past this
+// an adventure's objects come from the heap as before.
+#define ADVENTURE_ARENAS_MAX 8
+
+// The engine-side memory an adventure holds in its arenas: what
+// adventure_init made (animations, actors), freed by adventure_deinit, and
+// what its media load made (dialogue line text, mouth cues, word timings),
+// freed by adventure_free_media. Bytes handed out, then bytes reserved in
+// blocks. Textures and sounds are counted by their own caches, not here.
+typedef struct adventure_memory {
+  size_t objects;
+  size_t media;
+  size_t reserved;
+} AdventureMemory;
+
+AdventureMemory adventure_memory(const Adventure *adventure);
+
 #endif /* adventure_h */
@@ -19,9 +19,10 @@
 //    scene, and clicking near a screen edge walks the fox toward ground the
 //    camera then scrolls into view.
 //  - Phase 4, planes + parallax: the field is built from planes instead of one
-//    background — a fixed sky (parallax 0), hills that drift slowly (0.4), the
-//    ground the fox walks on (1), and a foreground bush strip (1.15) she
-//    passes behind. The engine draws them; the scene only declares the tables.
+//    background — a fixed sky strip repeated across (parallax 0), hills that
+//    drift slowly (0.4), the ground the fox walks on (1), and a foreground
+//    bush strip (1.15) she passes behind. The engine draws them; the scene
+//    only declares the tables.
 //
 //  Toggle the debug overlay (D) to see the walk grid; the band boundary is
 //  where the far lawn meets the near lawn in the ground plane.
@@ -45,9 +46,12 @@ static ImageData images[1] = {
 // Parallax layers, back to front. The engine draws bg_planes behind the action
 // layer and fg_planes in front, each shifted by origin - camera * parallax.
 // The coverage rule (image must span WINDOW + parallax * (scene - WINDOW))
-// sets each image's width: sky 800, hills 1120, ground 1600, bushes 1720.
+// sets each image's width: hills 1120, ground 1600, bushes 1720. The sky's
+// gradient only changes downward, so it is a 64px strip repeated across.
 static Plane bg_planes[3] = {
-    {.image = {NULL, "sky.png", "field", 0, 0}, .parallax = 0.0F},
+    {.image = {NULL, "sky.png", "field", 0, 0},
+     .parallax = 0.0F,
+     .repeat = PLANE_REPEAT_X},
     {.image = {NULL, "hills.png", "field", 0, 0}, .parallax = 0.4F},
     {.image = {NULL, "ground.png", "field", 0, 0}, .parallax = 1.0F},
 };
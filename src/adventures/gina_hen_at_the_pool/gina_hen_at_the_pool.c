@@ -17,7 +17,7 @@
 #include "vine.h"
 
 // Asset declarations generated from the manifest (ASSETS.md): the shared
-// sound-effect bank.
+// sound-effect bank and the compiled-in .anim clip tables.
 #include "gina_assets.h"
 
 #define GINA_HEN_AT_THE_POOL_SCENES_LENGTH 7
@@ -28,6 +28,9 @@ static Scene scenes[GINA_HEN_AT_THE_POOL_SCENES_LENGTH];
 // splash, caw, pop). Loaded once for the whole adventure.
 static ChunkData sfx[GINA_SFX_COUNT] = GINA_SFX_INIT;
 
+static const AnimationClips anim_clips[GINA_ANIM_CLIPS_COUNT] =
+    GINA_ANIM_CLIPS_INIT;
+
 Adventure gina_hen_at_the_pool = {
     .id = "gina-hen-at-the-pool",
     .title = "Gina la Gallina in Piscina",
@@ -44,6 +47,8 @@ Adventure gina_hen_at_the_pool = {
     // from scene to scene (see gina_worn.h).
     .images = gina_worn_images,
     .images_length = GINA_ITEMS_IMAGES_COUNT,
+    .anim_clips = anim_clips,
+    .anim_clips_length = GINA_ANIM_CLIPS_COUNT,
     // Selection screen: pool blue, on a cartridge carrying the hen.
     .hub_icon = {"icon.png", "hub"},
     .cartridge_color = {0x4E, 0xA8, 0xD8, 0xFF},
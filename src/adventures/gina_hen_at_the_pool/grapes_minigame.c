@@ -178,6 +178,8 @@ static void on_scene_active(void) { reset_grapes(); }
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {GINA_VINE};
+
 Scene grapes_minigame_scene = {
     .init = init,
     .load_media = load_media,
@@ -195,4 +197,6 @@ Scene grapes_minigame_scene = {
     .animations_length = LEN(animations),
     .anim_specs = anim_specs,
     .anim_specs_length = LEN(anim_specs),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -121,6 +121,8 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {GINA_POOL};
+
 Scene gina_intro_scene = {
     .init = init,
     .process_input = process_input,
@@ -139,4 +141,6 @@ Scene gina_intro_scene = {
     .animations_length = LEN(animations),
     .anim_specs = anim_specs,
     .anim_specs_length = LEN(anim_specs),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
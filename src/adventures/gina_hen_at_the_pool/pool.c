@@ -537,6 +537,11 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+// On foot to the tree or the vine, into the sunscreen game, and to the end
+// card after the last dive.
+static const int exits[] = {GINA_TREE, GINA_VINE, GINA_SUNSCREEN_MINIGAME,
+                            GINA_OUTRO};
+
 Scene pool_scene = {
     .init = init,
     // Custom process_input for the dive input-lock; .actor still declared so
@@ -566,4 +571,6 @@ Scene pool_scene = {
     .anim_specs_length = LEN(anim_specs),
     .chunks = chunks,
     .chunks_length = LEN(chunks),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 
 #include "constants.h"
+#include "draw.h"
 #include "game.h"
 #include "image.h"
 #include "sound.h"
@@ -145,7 +146,7 @@ static void render(SDL_Renderer *renderer) {
         SDL_Rect cell = {GINA_X + c * (GINA_W / COLS),
                          GINA_Y + r * (GINA_H / ROWS), GINA_W / COLS,
                          GINA_H / ROWS};
-        SDL_RenderFillRect(renderer, &cell);
+        draw_fill_rect(renderer, &cell);
       }
     }
   }
@@ -162,6 +163,8 @@ static void on_scene_active(void) { reset_grid(); }
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {GINA_POOL};
+
 Scene sunscreen_minigame_scene = {
     .init = init,
     .load_media = load_media,
@@ -179,4 +182,6 @@ Scene sunscreen_minigame_scene = {
     .animations_length = LEN(animations),
     .anim_specs = anim_specs,
     .anim_specs_length = LEN(anim_specs),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
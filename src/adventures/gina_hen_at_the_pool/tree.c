@@ -336,6 +336,8 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {GINA_POOL, GINA_VINE};
+
 Scene tree_scene = {
     .init = init,
     .actor = &gina,
@@ -362,4 +364,6 @@ Scene tree_scene = {
     .anim_specs_length = LEN(anim_specs),
     .chunks = chunks,
     .chunks_length = LEN(chunks),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
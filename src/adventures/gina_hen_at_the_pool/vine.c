@@ -177,6 +177,9 @@ static void render(SDL_Renderer *renderer) {
   gina_render_worn(renderer, gina);
 }
 
+// Back along the path either way, or into the grapes with the basket.
+static const int exits[] = {GINA_TREE, GINA_POOL, GINA_GRAPES_MINIGAME};
+
 Scene vine_scene = {
     .init = init,
     .render = render,
@@ -202,4 +205,6 @@ Scene vine_scene = {
     .anim_specs_length = LEN(anim_specs),
     .chunks = chunks,
     .chunks_length = LEN(chunks),
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -121,6 +121,8 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {PLAYGROUND_ENTRANCE};
+
 Scene intro_scene = {
     .init = init,
     .process_input = process_input,
@@ -140,4 +142,6 @@ Scene intro_scene = {
     .anim_specs = anim_specs,
     .anim_specs_length = LEN(anim_specs),
     .music = VANIA_MUSIC_CHUNK_INTRO_ASSET_INIT,
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -355,6 +355,8 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {OUTRO};
+
 Scene playground_scene = {
     .init = init,
     // Custom process_input for the after-three-slides win check; .actor is
@@ -382,4 +384,6 @@ Scene playground_scene = {
     .chunks = chunks,
     .chunks_length = LEN(chunks),
     .music = VANIA_MUSIC_CHUNK_PLAYGROUND_ASSET_INIT,
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -217,6 +217,8 @@ static void on_scene_active(void) {
 
 static void on_scene_inactive(void) {}
 
+static const int exits[] = {PLAYGROUND};
+
 Scene playground_entrance_scene = {
     .init = init,
     .actor = &fox,
@@ -243,4 +245,6 @@ Scene playground_entrance_scene = {
     .anim_specs = anim_specs,
     .anim_specs_length = LEN(anim_specs),
     .music = VANIA_MUSIC_CHUNK_PLAYGROUND_ASSET_INIT,
+    .exits = exits,
+    .exits_length = LEN(exits),
 };
@@ -12,7 +12,7 @@
 #include "playground_entrance.h"
 
 // Asset declarations generated from the manifest (ASSETS.md), including the
-// shared sound-effect bank.
+// shared sound-effect bank and the compiled-in .anim clip tables.
 #include "vania_assets.h"
 
 #define VANIA_FOX_THE_SLIDE_SCENES_LENGTH 4
@@ -24,6 +24,9 @@ static Scene scenes[VANIA_FOX_THE_SLIDE_SCENES_LENGTH];
 // adventure.
 static ChunkData sfx[VANIA_SFX_COUNT] = VANIA_SFX_INIT;
 
+static const AnimationClips anim_clips[VANIA_ANIM_CLIPS_COUNT] =
+    VANIA_ANIM_CLIPS_INIT;
+
 Adventure vania_fox_the_slide = {
     .id = "vania-fox-the-slide",
     .title = "Vania Volpe - Lo Scivolo",
@@ -33,6 +36,8 @@ Adventure vania_fox_the_slide = {
     .entry_scene = INTRO,
     .sfx = sfx,
     .sfx_length = VANIA_SFX_COUNT,
+    .anim_clips = anim_clips,
+    .anim_clips_length = VANIA_ANIM_CLIPS_COUNT,
     // Selection screen: the fox's orange, on a cartridge carrying the slide.
     .hub_icon = {"icon.png", "hub"},
     .cartridge_color = {0xE2, 0x8A, 0x3C, 0xFF},
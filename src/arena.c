@@ -0,0 +1,138 @@
+//
+//  arena.c
+//  Bump allocation for engine data that shares one lifetime (see arena.h).
+//
+
+#include <SDL2/SDL.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// Every allocation is rounded up to this, so each starts aligned for any type
+// the engine stores (SDL_Rect, Uint32, pointers, doubles).
+#define ARENA_ALIGN 16
+
+struct arena_block {
+  ArenaBlock *next;
+  size_t size; // usable bytes after the header
+  size_t used;
+};
+
+// The block header, padded so the bytes after it stay aligned.
+#define BLOCK_HEADER                                                           \
+  ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+// Arenas holding at least one block, for arena_scoped_free to search.
+static Arena *live_arenas = NULL;
+
+static Arena *in_force = NULL;
+
+static Uint8 *block_bytes(ArenaBlock *block) {
+  return (Uint8 *)block + BLOCK_HEADER;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  size_t rounded = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  if (rounded < size) {
+    return NULL;
+  }
+  ArenaBlock *block = arena->blocks;
+  if (block == NULL || block->size - block->used < rounded) {
+    size_t size_of_block =
+        rounded > ARENA_BLOCK_SIZE ? rounded : ARENA_BLOCK_SIZE;
+    block = malloc(BLOCK_HEADER + size_of_block);
+    if (block == NULL) {
+      return NULL;
+    }
+    if (arena->blocks == NULL) {
+      arena->next = live_arenas;
+      live_arenas = arena;
+    }
+    block->size = size_of_block;
+    block->used = 0;
+    // A large allocation's own block goes behind the current one, so the
+    // current block's free tail is still used for what comes next.
+    if (arena->blocks != NULL && size_of_block > ARENA_BLOCK_SIZE) {
+      block->next = arena->blocks->next;
+      arena->blocks->next = block;
+    } else {
+      block->next = arena->blocks;
+      arena->blocks = block;
+    }
+    arena->reserved += size_of_block;
+  }
+  void *p = block_bytes(block) + block->used;
+  block->used += rounded;
+  arena->used += rounded;
+  memset(p, 0, size);
+  return p;
+}
+
+void arena_reset(Arena *arena) {
+  if (arena->blocks == NULL) {
+    return;
+  }
+  for (Arena **link = &live_arenas; *link != NULL; link = &(*link)->next) {
+    if (*link == arena) {
+      *link = arena->next;
+      break;
+    }
+  }
+  ArenaBlock *block = arena->blocks;
+  while (block != NULL) {
+    ArenaBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+  *arena = (Arena){0};
+}
+
+bool arena_owns(const Arena *arena, const void *p) {
+  uintptr_t at = (uintptr_t)p;
+  for (ArenaBlock *block = arena->blocks; block != NULL; block = block->next) {
+    uintptr_t start = (uintptr_t)block_bytes(block);
+    if (at >= start && at < start + block->size) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Arena *arena_use(Arena *arena) {
+  Arena *previous = in_force;
+  in_force = arena;
+  return previous;
+}
+
+void *arena_scoped_alloc(size_t size) {
+  if (in_force != NULL) {
+    return arena_alloc(in_force, size);
+  }
+  return calloc(1, size > 0 ? size : 1);
+}
+
+char *arena_scoped_strdup(const char *text) {
+  if (text == NULL) {
+    return NULL;
+  }
+  size_t size = strlen(text) + 1;
+  char *copy = arena_scoped_alloc(size);
+  if (copy != NULL) {
+    memcpy(copy, text, size);
+  }
+  return copy;
+}
+
+void arena_scoped_free(void *p) {
+  if (p == NULL) {
+    return;
+  }
+  for (const Arena *arena = live_arenas; arena != NULL; arena = arena->next) {
+    if (arena_owns(arena, p)) {
+      return;
+    }
+  }
+  free(p);
+}
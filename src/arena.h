@@ -0,0 +1,63 @@
+//
+//  arena.h
+//  Bump allocation for engine data that shares one lifetime. An adventure's
+//  animations and actors live from adventure_init to adventure_deinit, and its
+//  dialogue sidecars (line text, mouth cues, word timings) from a media load to
+//  the matching free; each of those sets is carved out of one arena's blocks
+//  and given back with a single arena_reset, instead of a malloc and a free per
+//  object. An arena's byte counts are then exactly what that set costs.
+//
+//  Code that makes such objects doesn't take an arena: it allocates with
+//  arena_scoped_alloc, which draws from whichever arena the caller has put in
+//  force with arena_use (adventure.c does, around init and the sidecar loads)
+//  and from the heap when there is none — so the same objects made in a test,
+//  or by the engine outside any adventure, are plain heap memory.
+//  arena_scoped_free tells the two apart. Main thread only.
+//
+
+#ifndef arena_h
+#define arena_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Bytes per block. A larger allocation gets a block of its own.
+#define ARENA_BLOCK_SIZE (16 * 1024)
+
+typedef struct arena_block ArenaBlock;
+
+// Zero-initialize ({0}, or a static): an arena takes no memory until its
+// first allocation.
+typedef struct arena {
+  ArenaBlock *blocks; // newest first
+  size_t used;        // bytes handed out, padding included
+  size_t reserved;    // bytes held in blocks
+  struct arena *next; // in the list of arenas holding blocks
+} Arena;
+
+// `size` zeroed bytes from the arena, aligned for any type; NULL when out of
+// memory. Valid until arena_reset.
+void *arena_alloc(Arena *arena, size_t size);
+
+// Free every block at once, leaving the arena empty and reusable.
+void arena_reset(Arena *arena);
+
+// Whether `p` points into one of the arena's blocks.
+bool arena_owns(const Arena *arena, const void *p);
+
+// Put `arena` in force for arena_scoped_alloc (NULL: the heap), returning the
+// one it replaces so the caller can put that back.
+Arena *arena_use(Arena *arena);
+
+// Zeroed memory from the arena in force, else from the heap.
+void *arena_scoped_alloc(size_t size);
+
+// A copy of `text` made with arena_scoped_alloc. NULL for NULL.
+char *arena_scoped_strdup(const char *text);
+
+// Give back what arena_scoped_alloc returned: freed if it came from the heap,
+// left alone if it came from any arena (its arena_reset frees it). NULL is
+// fine.
+void arena_scoped_free(void *p);
+
+#endif /* arena_h */
@@ -5,11 +5,20 @@
 //  Created by Giovanni Cappellotto on 1/26/25.
 //
 
+// stat is POSIX; -std=c99 hides its fields' time macros from glibc's headers.
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <SDL2/SDL.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 #include "asset.h"
+#include "constants.h"
+#include "pack.h"
 
 // Base directory prepended to every (non-iOS) asset path, e.g. an adventure's
 // assets directory. NULL means "no prefix" (paths relative to the CWD).
@@ -21,7 +30,32 @@ static const char *asset_locale = "it_IT";
 // Subdirectory holding locale-independent (shared) assets.
 #define ASSET_COMMON "common"
 
-void asset_set_root(const char *root) { asset_root = root; }
+// Root of the engine's own assets (fonts, UI art), which are addressed by
+// repo-relative path rather than through asset_root.
+#define ASSET_ENGINE_ROOT "assets"
+
+// Whether the engine root has been mounted. Engine assets load before any
+// adventure sets a root, so the first lookup mounts it.
+static SDL_atomic_t engine_mounted;
+
+// Existence probes by who answered: a mounted root's directory (an open()
+// saved each time) or the disk.
+static SDL_atomic_t probes_in_memory;
+static SDL_atomic_t probes_on_disk;
+
+static void mount_engine_root(void) {
+  if (SDL_AtomicGet(&engine_mounted) == 0) {
+    pack_mount(ASSET_ENGINE_ROOT);
+    SDL_AtomicSet(&engine_mounted, 1);
+  }
+}
+
+// Mounting indexes every layer of the root at once, so a later locale switch
+// finds its layer already indexed and has nothing to rebuild.
+void asset_set_root(const char *root) {
+  asset_root = root;
+  pack_mount(root);
+}
 
 const char *asset_get_root(void) { return asset_root; }
 
@@ -33,10 +67,18 @@ void asset_set_locale(const char *locale) {
 
 const char *asset_get_locale(void) { return asset_locale; }
 
-// True if a file exists at path. Uses SDL_RWFromFile (the same mechanism the
-// loaders use) rather than POSIX access(): portable (no <unistd.h>, which
-// Windows lacks) and correct on Emscripten's virtual filesystem.
-static bool file_exists(const char *path) {
+// True if a file exists at path. A mounted root's directory (its pack's, or
+// its listing) answers without touching the disk. Otherwise uses
+// SDL_RWFromFile (the same mechanism the loaders use) rather than POSIX
+// access(): portable (no <unistd.h>, which Windows lacks) and correct on
+// Emscripten's virtual filesystem.
+bool asset_file_exists(const char *path) {
+  mount_engine_root();
+  if (pack_covers(path)) {
+    SDL_AtomicAdd(&probes_in_memory, 1);
+    return pack_contains(path);
+  }
+  SDL_AtomicAdd(&probes_on_disk, 1);
   SDL_RWops *rw = SDL_RWFromFile(path, "rb");
   if (rw == NULL) {
     return false;
@@ -45,6 +87,56 @@ static bool file_exists(const char *path) {
   return true;
 }
 
+SDL_RWops *asset_open(const char *path) {
+  mount_engine_root();
+  if (pack_covers(path)) {
+    return pack_open(path);
+  }
+  return SDL_RWFromFile(path, "rb");
+}
+
+void *asset_load_file(const char *path, size_t *size) {
+  SDL_RWops *rw = asset_open(path);
+  return rw != NULL ? SDL_LoadFile_RW(rw, size, 1) : NULL;
+}
+
+bool asset_stamp(const char *path, AssetStamp *stamp) {
+  mount_engine_root();
+  *stamp = (AssetStamp){0};
+  if (pack_locate(path, &stamp->offset, &stamp->size, &stamp->time)) {
+    return true;
+  }
+  if (pack_covers(path) && !pack_contains(path)) {
+    return false;
+  }
+  struct stat info;
+  if (stat(path, &info) == 0) {
+    stamp->size = (Uint64)info.st_size;
+    stamp->time = (Sint64)info.st_mtime;
+    return true;
+  }
+  SDL_RWops *rw = SDL_RWFromFile(path, "rb");
+  if (rw == NULL) {
+    return false;
+  }
+  Sint64 size = SDL_RWsize(rw);
+  SDL_RWclose(rw);
+  stamp->size = size > 0 ? (Uint64)size : 0;
+  return size >= 0;
+}
+
+AssetLookupStats asset_lookup_stats(void) {
+  return (AssetLookupStats){SDL_AtomicGet(&probes_in_memory),
+                            SDL_AtomicGet(&probes_on_disk)};
+}
+
+void asset_log_report(void) {
+  AssetLookupStats stats = asset_lookup_stats();
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "Asset lookups: %d answered in memory, %d probed on disk",
+              stats.in_memory, stats.on_disk);
+}
+
 bool asset_swap_extension(const char *filename, const char *extension,
                           char *out, size_t out_size) {
   const char *dot = SDL_strrchr(filename, '.');
@@ -61,6 +153,31 @@ bool asset_swap_extension(const char *filename, const char *extension,
   return true;
 }
 
+// Faster-decoding stand-ins for a file type: a .qoi beside a .png holds the
+// same pixels and decodes several times faster (qoi.h), and the binary twin of
+// a lip-sync sidecar the same cues or words with nothing to parse (lipsync.h).
+// The caller still names the original; only the resolved path changes.
+static const struct {
+  const char *extension;
+  const char *fast;
+} fast_variants[] = {
+    {".png", ".qoi"}, {".cues", ".bcues"}, {".words", ".bwords"}};
+
+bool asset_prefer_fast(char *path, size_t n) {
+  const char *dot = SDL_strrchr(path, '.');
+  for (int i = 0; dot != NULL && i < (int)LEN(fast_variants); i++) {
+    char fast[ASSET_PATH_MAX];
+    if (SDL_strcasecmp(dot, fast_variants[i].extension) == 0 &&
+        asset_swap_extension(path, fast_variants[i].fast, fast,
+                             sizeof(fast)) &&
+        SDL_strlen(fast) < n && asset_file_exists(fast)) {
+      SDL_strlcpy(path, fast, n);
+      return true;
+    }
+  }
+  return asset_file_exists(path);
+}
+
 #if defined(__IPHONEOS__) || defined(__TVOS__)
 bool asset_resolve(Asset asset, char *buf, size_t n) {
   // iOS bundles assets flat (by filename). Localizing the iOS build needs
@@ -68,12 +185,13 @@ bool asset_resolve(Asset asset, char *buf, size_t n) {
   // the other platforms (tracked in the backlog). For now use the bare name;
   // there is no locale layer, so report the common fallback.
   snprintf(buf, n, "%s", asset.filename);
+  asset_prefer_fast(buf, n);
   return false;
 }
 
 bool asset_try_resolve(Asset asset, char *buf, size_t n) {
   snprintf(buf, n, "%s", asset.filename);
-  return file_exists(buf);
+  return asset_prefer_fast(buf, n);
 }
 
 bool asset_common_path(Asset asset, char *buf, size_t n) {
@@ -103,10 +221,10 @@ static bool build_path(char *buf, size_t n, const char *layer, Asset asset) {
 }
 
 bool asset_try_resolve(Asset asset, char *buf, size_t n) {
-  if (build_path(buf, n, asset_locale, asset) && file_exists(buf)) {
+  if (build_path(buf, n, asset_locale, asset) && asset_prefer_fast(buf, n)) {
     return true;
   }
-  return build_path(buf, n, ASSET_COMMON, asset) && file_exists(buf);
+  return build_path(buf, n, ASSET_COMMON, asset) && asset_prefer_fast(buf, n);
 }
 
 bool asset_common_path(Asset asset, char *buf, size_t n) {
@@ -115,12 +233,13 @@ bool asset_common_path(Asset asset, char *buf, size_t n) {
 
 bool asset_resolve(Asset asset, char *buf, size_t n) {
   // The active locale's asset wins when present; otherwise fall back to the
-  // shared "common" layer. Strict: no fallback to another language.
-  if (build_path(buf, n, asset_locale, asset) && file_exists(buf)) {
+  // shared "common" layer. Strict: no fallback to another language. Within a
+  // layer a fast-decoding variant wins over the file itself.
+  if (build_path(buf, n, asset_locale, asset) && asset_prefer_fast(buf, n)) {
     return true;
   }
   build_path(buf, n, ASSET_COMMON, asset);
-  if (!file_exists(buf)) {
+  if (!asset_prefer_fast(buf, n)) {
     // Neither layer has the file. Surface it here (with the resolved path)
     // instead of leaving it as a cryptic downstream "Couldn't open …".
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
@@ -8,6 +8,7 @@
 #ifndef asset_h
 #define asset_h
 
+#include <SDL2/SDL.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -25,7 +26,8 @@ typedef struct asset {
 // wins when present, else the common one (see asset_set_locale). Returns true
 // if the localized layer was used, false if it fell back to common. The caller
 // owns the storage, so two resolved paths can be live at once without
-// clobbering each other. Use a buffer of ASSET_PATH_MAX bytes.
+// clobbering each other. Use a buffer of ASSET_PATH_MAX bytes. An image's
+// .qoi twin in the same layer is preferred over its .png (asset_prefer_fast).
 bool asset_resolve(Asset asset, char *buf, size_t n);
 
 // Like asset_resolve, but for optional files (e.g. dialogue sidecars): true
@@ -33,9 +35,11 @@ bool asset_resolve(Asset asset, char *buf, size_t n);
 // false — silently, no error log — when absent in both.
 bool asset_try_resolve(Asset asset, char *buf, size_t n);
 
-// Set the base directory prepended to non-iOS asset paths (NULL to disable).
-// The pointer is stored, not copied, so the string must outlive the asset
-// system (true today: adventure roots are string literals).
+// Set the base directory prepended to non-iOS asset paths (NULL to disable),
+// mounting it (pack.h): its pack if it has one, else an index of its files,
+// every locale layer included. The pointer is stored, not copied,
+// so the string must outlive the asset system (true today: adventure roots are
+// string literals).
 void asset_set_root(const char *root);
 
 // The active asset root (as set by asset_set_root; may be NULL).
@@ -56,6 +60,53 @@ void asset_set_locale(const char *locale);
 // The active locale.
 const char *asset_get_locale(void);
 
+// Whether the file at an already-built path exists, switching `path` to its
+// fast-decoding variant (a .qoi for a .png, written by tools/gen_qoi.py; a
+// .bcues or .bwords for a lip-sync sidecar, by tools/gen_lipsync.py) when
+// that sits beside it. asset_resolve does this within each layer; callers with
+// repo-relative paths (load_image_from_path) call it directly.
+bool asset_prefer_fast(char *path, size_t n);
+
+// True if a file exists at an already-resolved path — for probing optional
+// siblings of a resolved asset (an image's resolution tiers) in the same layer.
+// Under a mounted root (pack.h) this is a lookup in memory, not an open().
+bool asset_file_exists(const char *path);
+
+// What a file's bytes are known by without reading them: its size and
+// modification time on disk, or, packed, its blob's place in the pack (and the
+// pack's time, where it has one). Two stamps alike found the same bytes, as
+// long as the build is the same one: a file only SDL can open (an app
+// bundle's, an APK's) is stamped by size alone, and changes only with the app.
+// The warm-start cache (warm_cache.h) keys its entries by it.
+typedef struct asset_stamp {
+  Uint64 size;
+  Sint64 time;   // seconds; 0 where there is none to read
+  Uint64 offset; // in its pack; 0 for a loose file
+} AssetStamp;
+
+// False if the file can't be found.
+bool asset_stamp(const char *path, AssetStamp *stamp);
+
+typedef struct asset_lookup_stats {
+  int in_memory; // probes a mounted root's directory answered
+  int on_disk;   // probes that had to open the file
+} AssetLookupStats;
+
+// Existence probes so far (asset_file_exists, and so every resolve).
+AssetLookupStats asset_lookup_stats(void);
+
+// Log the totals above; game_load_media calls this once media is up.
+void asset_log_report(void);
+
+// Open a resolved (or repo-relative) path for reading: from its root's pack
+// when one is mounted, else from disk. NULL (with SDL_GetError set) when it
+// can't be opened. Every loader reads through this, never SDL_RWFromFile.
+SDL_RWops *asset_open(const char *path);
+
+// Read a whole file through asset_open, NUL-terminated like SDL_LoadFile;
+// SDL_free it. NULL when it can't be read.
+void *asset_load_file(const char *path, size_t *size);
+
 // Derive a sibling filename by swapping the extension (the part after the
 // last '.'): "line.wav" + ".cues" -> "line.cues". False if filename has no
 // extension or the result doesn't fit. Used for dialogue sidecars, which sit
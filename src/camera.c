@@ -6,10 +6,7 @@
 #include "camera.h"
 #include "constants.h"
 
-// Where the camera wants to be: the view centred on the follow target,
-// clamped to the scene. A fixed camera (follow == NULL) targets its current
-// clamped position.
-static SDL_FPoint camera_target(const Camera *camera) {
+SDL_FPoint camera_target(const Camera *camera) {
   SDL_FPoint target = camera->pos;
   if (camera->follow != NULL) {
     target.x = camera->follow->current_position.x - WINDOW_WIDTH / 2.0F;
@@ -26,6 +26,11 @@ typedef struct camera {
 
 void camera_init(Camera *camera, SDL_Point scene_size, const Actor *follow);
 
+// Where the camera is heading: the view centred on the follow target,
+// clamped to the scene. A fixed camera (follow == NULL) targets its current
+// clamped position. Plane paging loads ahead toward it.
+SDL_FPoint camera_target(const Camera *camera);
+
 // Centre on the follow target immediately (scene entry; no smoothing).
 void camera_snap(Camera *camera);
 
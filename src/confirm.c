@@ -6,6 +6,7 @@
 #include "confirm.h"
 
 #include "constants.h"
+#include "draw.h"
 #include "image.h"
 
 // The panel, centred, and the two answers inside it. Both targets are far
@@ -141,10 +142,10 @@ static void render_answer(SDL_Renderer *renderer, AnimationData *animation,
   if (animation == NULL || animation->sprite_clips == NULL) {
     return;
   }
-  const SDL_Rect *clip = &animation->sprite_clips[animation->current_frame];
+  SDL_Point frame = animation_frame_size(animation, animation->current_frame);
   render_animation(renderer, animation,
-                   (SDL_Point){target.x + (target.w - clip->w) / 2,
-                               target.y + (target.h - clip->h) / 2});
+                   (SDL_Point){target.x + (target.w - frame.x) / 2,
+                               target.y + (target.h - frame.y) / 2});
 }
 
 void confirm_render(SDL_Renderer *renderer) {
@@ -159,7 +160,7 @@ void confirm_render(SDL_Renderer *renderer) {
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x99);
   SDL_Rect screen = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-  SDL_RenderFillRect(renderer, &screen);
+  draw_fill_rect(renderer, &screen);
   SDL_SetRenderDrawBlendMode(renderer, blend);
 
   // Panel, then the two answers on it. Each is a whole picture — the engine
@@ -8,8 +8,11 @@
 #include <SDL2/SDL.h>
 #include <stdbool.h>
 
+#include "clock.h"
 #include "constants.h"
+#include "draw.h"
 #include "game.h"
+#include "profile.h"
 #include "scene.h"
 
 #include "debug.h"
@@ -31,6 +34,19 @@ static bool is_painting_walk = false;
 // Mouse button held while painting (0 = none).
 static Uint8 paint_button = 0;
 
+// The blocked-cell shading, cached as a texture with one texel per cell and
+// stretched over the scene in a single copy. Rebuilt when the scene's grid
+// changes — another grid, or the same one rebuilt or reloaded (its
+// generation) — or paint mode edits a cell; until then the overlay costs one
+// blit however many cells are blocked.
+static SDL_Texture *walk_mask_texture = NULL;
+static const WalkGrid *walk_mask_grid = NULL;
+static Uint32 walk_mask_generation = 0;
+static bool walk_mask_dirty = true;
+// Fallback when the texture can't be made: the blocked cells, merged into
+// horizontal runs, submitted with a draw_fill_rects call per this many.
+#define WALK_MASK_RECT_BATCH 256
+
 static void paint_cell(WalkGrid *grid, int x, int y, Uint8 walkable) {
   // Coordinates arrive in scene space (the engine converts a camera scene's
   // input), so the bounds are the scene-sized grid's, not the window's.
@@ -38,7 +54,94 @@ static void paint_cell(WalkGrid *grid, int x, int y, Uint8 walkable) {
       y >= grid->h * WALK_CELL_SIZE) {
     return;
   }
-  grid->cells[y / WALK_CELL_SIZE][x / WALK_CELL_SIZE] = walkable;
+  Uint8 *cell = &grid->cells[y / WALK_CELL_SIZE][x / WALK_CELL_SIZE];
+  if (*cell != walkable) {
+    *cell = walkable;
+    walk_mask_dirty = true;
+  }
+}
+
+static SDL_Texture *make_walk_mask_texture(SDL_Renderer *renderer,
+                                           const WalkGrid *grid) {
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+      0, grid->w, grid->h, 32, SDL_PIXELFORMAT_RGBA32);
+  if (surface == NULL) {
+    return NULL;
+  }
+  for (int cy = 0; cy < grid->h; cy++) {
+    Uint8 *row = (Uint8 *)surface->pixels + cy * surface->pitch;
+    for (int cx = 0; cx < grid->w; cx++) {
+      bool blocked = !grid->cells[cy][cx];
+      row[cx * 4 + 0] = 0xFF;
+      row[cx * 4 + 1] = 0x33;
+      row[cx * 4 + 2] = 0x33;
+      row[cx * 4 + 3] = blocked ? 0x50 : 0x00;
+    }
+  }
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+  SDL_FreeSurface(surface);
+  if (texture == NULL) {
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  // Cells must stay crisp squares; the window's linear filtering would smear
+  // each texel into its neighbours.
+  SDL_SetTextureScaleMode(texture, SDL_ScaleModeNearest);
+  return texture;
+}
+
+static void render_walk_mask(SDL_Renderer *renderer, const WalkGrid *grid,
+                             SDL_Point off) {
+  if (grid != walk_mask_grid || grid->generation != walk_mask_generation ||
+      walk_mask_dirty) {
+    if (walk_mask_texture != NULL) {
+      SDL_DestroyTexture(walk_mask_texture);
+    }
+    walk_mask_texture = make_walk_mask_texture(renderer, grid);
+    if (walk_mask_texture == NULL) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Walk mask texture unavailable (%s); batching rects",
+                  SDL_GetError());
+    }
+    walk_mask_grid = grid;
+    walk_mask_generation = grid->generation;
+    walk_mask_dirty = false;
+  }
+
+  if (walk_mask_texture != NULL) {
+    draw_copy(renderer, walk_mask_texture, NULL,
+              &((SDL_Rect){off.x, off.y, grid->w * WALK_CELL_SIZE,
+                           grid->h * WALK_CELL_SIZE}));
+    return;
+  }
+
+  SDL_Rect rects[WALK_MASK_RECT_BATCH];
+  int count = 0;
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0xFF, 0x33, 0x33, 0x50);
+  for (int cy = 0; cy < grid->h; cy++) {
+    for (int cx = 0; cx < grid->w; cx++) {
+      if (grid->cells[cy][cx]) {
+        continue;
+      }
+      int run = cx;
+      while (run + 1 < grid->w && !grid->cells[cy][run + 1]) {
+        run++;
+      }
+      rects[count++] =
+          (SDL_Rect){cx * WALK_CELL_SIZE + off.x, cy * WALK_CELL_SIZE + off.y,
+                     (run - cx + 1) * WALK_CELL_SIZE, WALK_CELL_SIZE};
+      if (count == WALK_MASK_RECT_BATCH) {
+        draw_fill_rects(renderer, rects, count);
+        count = 0;
+      }
+      cx = run;
+    }
+  }
+  if (count > 0) {
+    draw_fill_rects(renderer, rects, count);
+  }
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 }
 
 bool debug_process_input(SDL_Event *event) {
@@ -113,50 +216,171 @@ bool debug_process_input(SDL_Event *event) {
   return false;
 }
 
+// How often the overlay logs the draw counters, which it otherwise only
+// shows as bars.
+#define DRAW_STATS_LOG_MS 1000
+// Bar scale: this many pixels per full screen of overdraw.
+#define OVERDRAW_BAR_PX 40
+
+static Uint32 draw_stats_logged_at = 0;
+
+// The last frame's draw counters (draw.h), as bars under the markers in
+// screen space: overdraw with a tick per full screen, then draw calls,
+// texture binds and blend changes at a pixel each (two for blend changes).
+// Logged in full once a second (true when it logged). They count the overlay's
+// own draws too.
+static bool render_draw_stats(SDL_Renderer *renderer) {
+  DrawStats stats = draw_stats_previous();
+  Uint64 screen = (Uint64)WINDOW_WIDTH * WINDOW_HEIGHT;
+  int overdraw_px = (int)(stats.pixels * OVERDRAW_BAR_PX / screen);
+  SDL_SetRenderDrawColor(renderer, 0xFF, 0x88, 0x00, 0xFF);
+  draw_fill_rect(renderer, &((SDL_Rect){0, 14, overdraw_px, 4}));
+  SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+  for (int x = OVERDRAW_BAR_PX; x < overdraw_px; x += OVERDRAW_BAR_PX) {
+    draw_line(renderer, x, 14, x, 17);
+  }
+  const struct {
+    int value;
+    int scale;
+    SDL_Color color;
+  } bars[] = {
+      {stats.draw_calls, 1, {0x33, 0xCC, 0x33, 0xFF}},
+      {stats.texture_binds, 1, {0x33, 0x99, 0xFF, 0xFF}},
+      {stats.blend_changes, 2, {0xFF, 0x33, 0xCC, 0xFF}},
+  };
+  for (int i = 0; i < (int)LEN(bars); i++) {
+    SDL_SetRenderDrawColor(renderer, bars[i].color.r, bars[i].color.g,
+                           bars[i].color.b, bars[i].color.a);
+    draw_fill_rect(renderer, &((SDL_Rect){0, 20 + 6 * i,
+                                          bars[i].value * bars[i].scale, 4}));
+  }
+
+  Uint32 now = clock_now_ms();
+  if (now - draw_stats_logged_at >= DRAW_STATS_LOG_MS) {
+    draw_stats_logged_at = now;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "Frame: %d draws, %d texture binds, %.2fx overdraw, %d blend "
+                "changes",
+                stats.draw_calls, stats.texture_binds,
+                (double)stats.pixels / (double)screen, stats.blend_changes);
+    return true;
+  }
+  return false;
+}
+
+// Frame-time graph: the last FRAME_GRAPH_FRAMES frames, a bar each, along the
+// bottom of the screen at this many pixels per millisecond, capped at
+// FRAME_GRAPH_MAX_PX so a hitch doesn't cover the scene.
+#define FRAME_GRAPH_FRAMES 120
+#define FRAME_GRAPH_BAR_PX 2
+#define FRAME_GRAPH_PX_PER_MS 3
+#define FRAME_GRAPH_MAX_PX 150
+// A frame that takes longer than this many frame budgets is a jank frame:
+// the player sees it, so the overlay logs where its time went.
+#define JANK_FRAME_BUDGETS 2
+
+static int frame_graph_height(float ms) {
+  return SDL_min((int)(ms * FRAME_GRAPH_PX_PER_MS), FRAME_GRAPH_MAX_PX);
+}
+
+static void frame_graph_line(SDL_Renderer *renderer, float ms, Uint8 r,
+                             Uint8 g, Uint8 b) {
+  int y = WINDOW_HEIGHT - frame_graph_height(ms);
+  SDL_SetRenderDrawColor(renderer, r, g, b, 0xFF);
+  draw_line(renderer, 0, y, FRAME_GRAPH_FRAMES * FRAME_GRAPH_BAR_PX - 1, y);
+}
+
+// Log one frame's phases, the outer four first, then what game_update and
+// game_render spent inside them.
+static void log_jank_frame(const ProfileFrame *frame) {
+  char phases[256];
+  int used = 0;
+  for (int i = 0; i < PROFILE_PHASE_COUNT && used < (int)sizeof(phases); i++) {
+    used += SDL_snprintf(phases + used, sizeof(phases) - (size_t)used,
+                         "%s%s %.1f", i == 0 ? "" : ", ",
+                         profile_phase_name((ProfilePhase)i),
+                         (double)frame->phase_ms[i]);
+  }
+  SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Jank frame: %.1f ms (%s)",
+              (double)frame->total_ms, phases);
+}
+
+// The profiler's ring (profile.h) as a frame-time graph in screen space,
+// newest frame on the right: green bars within the frame budget, orange
+// within JANK_FRAME_BUDGETS of it, red past that. White marks the budget;
+// green, yellow and red lines the p50, p95 and p99. The percentiles are logged
+// with the draw counters, and every jank frame is logged as it lands.
+static void render_frame_graph(SDL_Renderer *renderer, bool log_percentiles) {
+  int frames = SDL_min(profile_frame_count(), FRAME_GRAPH_FRAMES);
+  for (int age = 0; age < frames; age++) {
+    float ms = profile_frame(age)->total_ms;
+    if (ms <= FRAME_TARGET_TIME) {
+      SDL_SetRenderDrawColor(renderer, 0x33, 0xCC, 0x33, 0xFF);
+    } else if (ms <= FRAME_TARGET_TIME * JANK_FRAME_BUDGETS) {
+      SDL_SetRenderDrawColor(renderer, 0xFF, 0x88, 0x00, 0xFF);
+    } else {
+      SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+    }
+    int h = frame_graph_height(ms);
+    int x = (FRAME_GRAPH_FRAMES - 1 - age) * FRAME_GRAPH_BAR_PX;
+    draw_fill_rect(renderer,
+                   &((SDL_Rect){x, WINDOW_HEIGHT - h, FRAME_GRAPH_BAR_PX, h}));
+  }
+
+  float p50 = profile_percentile(50);
+  float p95 = profile_percentile(95);
+  float p99 = profile_percentile(99);
+  frame_graph_line(renderer, FRAME_TARGET_TIME, 0xFF, 0xFF, 0xFF);
+  frame_graph_line(renderer, p50, 0x33, 0xCC, 0x33);
+  frame_graph_line(renderer, p95, 0xFF, 0xDD, 0x00);
+  frame_graph_line(renderer, p99, 0xFF, 0x00, 0x00);
+
+  if (log_percentiles && frames > 0) {
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "Frame time: p50 %.1f ms, p95 %.1f ms, p99 %.1f ms over %d "
+                "frames",
+                (double)p50, (double)p95, (double)p99, profile_frame_count());
+  }
+  // Each frame is the newest exactly once, so each jank frame logs once.
+  const ProfileFrame *last = profile_frame(0);
+  if (last != NULL && last->total_ms > FRAME_TARGET_TIME * JANK_FRAME_BUDGETS) {
+    log_jank_frame(last);
+  }
+}
+
 void debug_render(SDL_Renderer *renderer) {
   // Marker to show that the debugging layer is active
   SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
-  SDL_RenderFillRect(renderer, &((SDL_Rect){0, 0, 10, 10}));
+  draw_fill_rect(renderer, &((SDL_Rect){0, 0, 10, 10}));
 
   // Paint mode: a yellow marker next to the red one, and a yellow frame
   // around the screen as an unmissable "you are editing" affordance.
   if (is_painting_walk) {
     SDL_SetRenderDrawColor(renderer, 0xFF, 0xDD, 0x00, 0xFF);
-    SDL_RenderFillRect(renderer, &((SDL_Rect){12, 0, 10, 10}));
-    SDL_RenderDrawRect(renderer,
-                       &((SDL_Rect){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}));
+    draw_fill_rect(renderer, &((SDL_Rect){12, 0, 10, 10}));
+    draw_rect(renderer, &((SDL_Rect){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}));
   }
 
+  bool logged = render_draw_stats(renderer);
+  render_frame_graph(renderer, logged);
+
   // Everything below is scene geometry drawn through raw SDL rects — which
   // the render offset in image.c doesn't touch — so the camera shift is
   // applied here explicitly. Zero for static scenes.
   SDL_Point off = render_get_offset();
 
   SDL_SetRenderDrawColor(renderer, 0x00, 0xCC, 0xFF, 0xFF);
-  SDL_RenderDrawRect(renderer, &((SDL_Rect){.x = m_pos_down.x + off.x,
-                                            .y = m_pos_down.y + off.y,
-                                            .w = m_pos_up.x - m_pos_down.x,
-                                            .h = m_pos_up.y - m_pos_down.y}));
+  draw_rect(renderer, &((SDL_Rect){.x = m_pos_down.x + off.x,
+                                   .y = m_pos_down.y + off.y,
+                                   .w = m_pos_up.x - m_pos_down.x,
+                                   .h = m_pos_up.y - m_pos_down.y}));
 
   const Scene *current_scene = scene_instance(game.current_scene);
 
   // Shade non-walkable cells so walk geometry is visible and clearly distinct
   // from the cyan hotspot outlines.
   if (current_scene->walk_grid != NULL) {
-    const WalkGrid *grid = current_scene->walk_grid;
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0xFF, 0x33, 0x33, 0x50);
-    for (int cy = 0; cy < grid->h; cy++) {
-      for (int cx = 0; cx < grid->w; cx++) {
-        if (!grid->cells[cy][cx]) {
-          SDL_RenderFillRect(renderer,
-                             &((SDL_Rect){cx * WALK_CELL_SIZE + off.x,
-                                          cy * WALK_CELL_SIZE + off.y,
-                                          WALK_CELL_SIZE, WALK_CELL_SIZE}));
-        }
-      }
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    render_walk_mask(renderer, current_scene->walk_grid, off);
   }
 
   // Draw hotspots: enabled ones bright, gated-off ones dimmed, so the
@@ -172,16 +396,25 @@ void debug_render(SDL_Renderer *renderer) {
     SDL_Rect rect = hotspot->rect;
     rect.x += off.x;
     rect.y += off.y;
-    SDL_RenderDrawRect(renderer, &rect);
+    draw_rect(renderer, &rect);
   }
 
   // Draw points of interest
   for (int i = 0; i < current_scene->pois_length; i++) {
     SDL_SetRenderDrawColor(renderer, 0xCC, 0x00, 0xFF, 0xFF);
-    SDL_RenderFillRect(renderer,
-                       &((SDL_Rect){.x = current_scene->pois[i].x - 2 + off.x,
-                                    .y = current_scene->pois[i].y - 2 + off.y,
-                                    .w = 4,
-                                    .h = 4}));
+    draw_fill_rect(renderer,
+                   &((SDL_Rect){.x = current_scene->pois[i].x - 2 + off.x,
+                                .y = current_scene->pois[i].y - 2 + off.y,
+                                .w = 4,
+                                .h = 4}));
+  }
+}
+
+void debug_free_media(void) {
+  if (walk_mask_texture != NULL) {
+    SDL_DestroyTexture(walk_mask_texture);
+    walk_mask_texture = NULL;
   }
+  walk_mask_grid = NULL;
+  walk_mask_dirty = true;
 }
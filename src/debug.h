@@ -18,4 +18,7 @@ bool debug_process_input(SDL_Event *event);
 
 void debug_render(SDL_Renderer *renderer);
 
+// Releases the overlay's cached walk-mask texture (see debug_render).
+void debug_free_media(void);
+
 #endif /* debug_h */
@@ -0,0 +1,112 @@
+//
+//  draw.c
+//  Counted draw calls (see draw.h).
+//
+
+#include "draw.h"
+#include "constants.h"
+
+static DrawStats frame;
+static DrawStats previous;
+// What the last copy bound and the last draw blended with; a frame starts
+// with neither, so its first draws count as a bind and a change.
+static SDL_Texture *last_texture = NULL;
+static SDL_BlendMode last_blend = SDL_BLENDMODE_INVALID;
+
+// The part of `rect` inside the window, in pixels; the whole window for NULL.
+static Uint64 covered(const SDL_Rect *rect) {
+  static const SDL_Rect window = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+  SDL_Rect visible;
+  if (rect == NULL) {
+    return (Uint64)WINDOW_WIDTH * WINDOW_HEIGHT;
+  }
+  if (!SDL_IntersectRect(rect, &window, &visible)) {
+    return 0;
+  }
+  return (Uint64)visible.w * (Uint64)visible.h;
+}
+
+static void count_draw(SDL_BlendMode blend, Uint64 pixels) {
+  frame.draw_calls++;
+  frame.pixels += pixels;
+  if (blend != last_blend) {
+    frame.blend_changes++;
+    last_blend = blend;
+  }
+}
+
+static void count_copy(SDL_Texture *texture, const SDL_Rect *dst) {
+  SDL_BlendMode blend = SDL_BLENDMODE_INVALID;
+  SDL_GetTextureBlendMode(texture, &blend);
+  if (texture != last_texture) {
+    frame.texture_binds++;
+    last_texture = texture;
+  }
+  count_draw(blend, covered(dst));
+}
+
+static SDL_BlendMode draw_blend(SDL_Renderer *renderer) {
+  SDL_BlendMode blend = SDL_BLENDMODE_INVALID;
+  SDL_GetRenderDrawBlendMode(renderer, &blend);
+  return blend;
+}
+
+int draw_copy(SDL_Renderer *renderer, SDL_Texture *texture,
+              const SDL_Rect *src, const SDL_Rect *dst) {
+  count_copy(texture, dst);
+  return SDL_RenderCopy(renderer, texture, src, dst);
+}
+
+int draw_copy_ex(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Rect *src, const SDL_Rect *dst, double angle,
+                 const SDL_Point *center, SDL_RendererFlip flip) {
+  // Rotation isn't accounted for: the engine only ever flips.
+  count_copy(texture, dst);
+  return SDL_RenderCopyEx(renderer, texture, src, dst, angle, center, flip);
+}
+
+int draw_fill_rect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+  count_draw(draw_blend(renderer), covered(rect));
+  return SDL_RenderFillRect(renderer, rect);
+}
+
+int draw_fill_rects(SDL_Renderer *renderer, const SDL_Rect *rects,
+                    int count) {
+  // One call to SDL, and one here: it is a single batched submission.
+  Uint64 pixels = 0;
+  for (int i = 0; i < count; i++) {
+    pixels += covered(&rects[i]);
+  }
+  count_draw(draw_blend(renderer), pixels);
+  return SDL_RenderFillRects(renderer, rects, count);
+}
+
+int draw_rect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+  // The outline's perimeter, ignoring clipping: outlines are debug art.
+  Uint64 pixels = (Uint64)WINDOW_WIDTH * 2 + (Uint64)WINDOW_HEIGHT * 2;
+  if (rect != NULL) {
+    int w = SDL_abs(rect->w);
+    int h = SDL_abs(rect->h);
+    pixels = w <= 1 || h <= 1 ? (Uint64)w * (Uint64)h
+                              : (Uint64)(2 * w + 2 * h - 4);
+  }
+  count_draw(draw_blend(renderer), pixels);
+  return SDL_RenderDrawRect(renderer, rect);
+}
+
+int draw_line(SDL_Renderer *renderer, int x1, int y1, int x2, int y2) {
+  int length = SDL_max(SDL_abs(x2 - x1), SDL_abs(y2 - y1)) + 1;
+  count_draw(draw_blend(renderer), (Uint64)length);
+  return SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
+
+void draw_stats_begin_frame(void) {
+  previous = frame;
+  frame = (DrawStats){0};
+  last_texture = NULL;
+  last_blend = SDL_BLENDMODE_INVALID;
+}
+
+DrawStats draw_stats_frame(void) { return frame; }
+
+DrawStats draw_stats_previous(void) { return previous; }
@@ -0,0 +1,48 @@
+//
+//  draw.h
+//  Counted draw calls. Every texture copy, fill and outline the engine issues
+//  goes through these thin wrappers over SDL_RenderCopy and friends, which
+//  tally what a frame costs: calls, texture switches, pixels covered (the
+//  overdraw) and blend-mode changes. The debug overlay shows the last frame's
+//  tally and the headless harness reads it, so a change that doubles a
+//  scene's overdraw shows up in CI instead of on a phone.
+//
+
+#ifndef draw_h
+#define draw_h
+
+#include <SDL2/SDL.h>
+
+typedef struct draw_stats {
+  int draw_calls; // copies, fills, outlines and lines issued
+  // Copies whose texture differs from the previous copy's: what a GPU back
+  // end must rebind (and where it can't batch).
+  int texture_binds;
+  // Destination pixels covered, clipped to the window, in logical pixels.
+  // Divided by WINDOW_WIDTH * WINDOW_HEIGHT it is the frame's overdraw.
+  Uint64 pixels;
+  // Draws whose blend mode differs from the previous draw's.
+  int blend_changes;
+} DrawStats;
+
+int draw_copy(SDL_Renderer *renderer, SDL_Texture *texture,
+              const SDL_Rect *src, const SDL_Rect *dst);
+int draw_copy_ex(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Rect *src, const SDL_Rect *dst, double angle,
+                 const SDL_Point *center, SDL_RendererFlip flip);
+int draw_fill_rect(SDL_Renderer *renderer, const SDL_Rect *rect);
+int draw_fill_rects(SDL_Renderer *renderer, const SDL_Rect *rects, int count);
+int draw_rect(SDL_Renderer *renderer, const SDL_Rect *rect); // outline
+int draw_line(SDL_Renderer *renderer, int x1, int y1, int x2, int y2);
+
+// Start counting a new frame; the finished one becomes draw_stats_previous.
+// game_render calls it first thing, so the clear before it isn't counted.
+void draw_stats_begin_frame(void);
+
+// This frame's tally so far — the whole frame once game_render has returned.
+DrawStats draw_stats_frame(void);
+
+// The last complete frame's tally (what the debug overlay shows).
+DrawStats draw_stats_previous(void);
+
+#endif /* draw_h */
@@ -15,10 +15,18 @@
 #include "constants.h"
 // Features for debugging the game
 #include "debug.h"
+// Per-frame draw counters (shown by the debug overlay)
+#include "draw.h"
 // Engine-owned UI art (the back-to-hub button)
 #include "image.h"
+// Frame-phase timings (graphed by the debug overlay)
+#include "profile.h"
+// Timeline scopes for the trace-event export
+#include "trace.h"
 // Dialogue text overlay (SPEECH.md Part 3)
 #include "subtitle.h"
+// Loads a previous launch kept (warm_cache.h)
+#include "warm_cache.h"
 
 Game game = {
     .is_running = false,
@@ -108,11 +116,332 @@ static void debug_hold_update(void) {
 }
 #endif /* PROD */
 
+// On-demand media (game.h): a record per registered adventure, by its index
+// in the registry.
+#define ADVENTURES_MAX 8
+typedef struct adventure_media {
+  bool loaded;
+  bool failed; // its last load failed: not streamed again unasked
+  // Image memory its last load took; until its first, an estimate from its
+  // images' headers once `sized`.
+  size_t bytes;
+  bool sized;
+  Uint32 entered; // media_clock when it was last entered: the eviction order
+} AdventureMedia;
+static AdventureMedia adventure_media[ADVENTURES_MAX];
+static Uint32 media_clock = 0;
+static size_t media_budget = (size_t)MEDIA_BUDGET_DEFAULT_MB * 1024 * 1024;
+// The renderer game_load_media was handed; switches load with it.
+static SDL_Renderer *media_renderer = NULL;
+
+// Background streaming (game.h): the adventure the decode pool is working
+// through, and the one a tapped cartridge is waiting on.
+#define STREAM_UPLOADS_PER_FRAME 2
+static bool media_streaming = true;
+// Set once a hub frame has been rendered (and so presented): nothing streams
+// before, so sizing and decoding never delay the first frame.
+static bool hub_shown = false;
+static const Adventure *streaming = NULL;
+static const Adventure *waiting = NULL;
+
+// The progress bar shown while waiting, centred over the dimmed hub.
+#define PROGRESS_W 320
+#define PROGRESS_H 24
+static const SDL_Rect PROGRESS_BAR = {(WINDOW_WIDTH - PROGRESS_W) / 2,
+                                      (WINDOW_HEIGHT - PROGRESS_H) / 2,
+                                      PROGRESS_W, PROGRESS_H};
+
 void register_adventures(const Adventure *hub, const Adventure **registered,
                          int count) {
+  SDL_assert(count <= ADVENTURES_MAX);
   adventures = registered;
   adventures_count = count;
   hub_adventure = hub;
+  SDL_memset(adventure_media, 0, sizeof(adventure_media));
+}
+
+static AdventureMedia *media_of(const Adventure *adventure) {
+  for (int a = 0; a < adventures_count; a++) {
+    if (adventures[a] == adventure) {
+      return &adventure_media[a];
+    }
+  }
+  return NULL;
+}
+
+// Loading resolves against the adventure being loaded; the current one's root
+// must be back in force after, for whatever it resolves next.
+static void restore_asset_root(void) {
+  if (game.current_adventure != NULL) {
+    asset_set_root(game.current_adventure->assets_root);
+  }
+}
+
+// Load an adventure's media, taking what the decode pool has decoded (and
+// joining it), and measure what it took. A failed load gives back whatever
+// did load.
+static bool finish_load(const Adventure *adventure, AdventureMedia *media) {
+  // A stream's uploads are already resident; the load only takes them.
+  size_t streamed = image_decode_uploaded_bytes();
+  size_t before = texture_cache_stats().bytes_resident;
+  bool loaded = adventure_load_media(adventure, media_renderer);
+  image_decode_finish();
+  restore_asset_root();
+  media->failed = !loaded;
+  if (!loaded) {
+    adventure_free_media(adventure);
+    return false;
+  }
+  size_t after = texture_cache_stats().bytes_resident;
+  media->loaded = true;
+  media->sized = true;
+  media->bytes = (after > before ? after - before : 0) + streamed;
+  // The per-adventure VRAM report: what this one took, what the content
+  // adventures now hold against the budget, and every texture resident
+  // (the hub's and shared art included).
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "%s: media loaded (%zu KB); adventures hold %zu of %zu KB, "
+              "textures %zu KB",
+              adventure->id, media->bytes / 1024, game_media_resident() / 1024,
+              media_budget / 1024, after / 1024);
+  return true;
+}
+
+// Load an adventure's media now, decoding on the worker pool as startup does;
+// `queued` when estimate_media has already queued its images.
+static bool load_adventure(const Adventure *adventure, AdventureMedia *media,
+                           bool queued) {
+  if (!queued) {
+    adventure_prefetch_media(adventure, media_renderer);
+  }
+  image_decode_start();
+  return finish_load(adventure, media);
+}
+
+size_t game_media_resident(void) {
+  size_t resident = 0;
+  for (int a = 0; a < adventures_count; a++) {
+    if (adventures[a] != hub_adventure && adventure_media[a].loaded) {
+      resident += adventure_media[a].bytes;
+    }
+  }
+  return resident;
+}
+
+// Evict the least recently entered content adventures, never `keep` nor the
+// hub, until what stays loaded plus `incoming` bytes fits the budget.
+static void evict_to_budget(const Adventure *keep, size_t incoming) {
+  while (game_media_resident() + incoming > media_budget) {
+    int oldest = -1;
+    for (int a = 0; a < adventures_count; a++) {
+      if (adventures[a] != hub_adventure && adventures[a] != keep &&
+          adventure_media[a].loaded &&
+          (oldest < 0 ||
+           adventure_media[a].entered < adventure_media[oldest].entered)) {
+        oldest = a;
+      }
+    }
+    if (oldest < 0) {
+      return;
+    }
+    adventure_free_media(adventures[oldest]);
+    adventure_media[oldest].loaded = false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s: media evicted (%zu KB)",
+                adventures[oldest]->id, adventure_media[oldest].bytes / 1024);
+  }
+}
+
+// Put the stream in flight aside, dropping what it decoded.
+static void cancel_stream(void) {
+  if (streaming != NULL) {
+    image_decode_finish();
+    streaming = NULL;
+  }
+}
+
+// Start the pool decoding an adventure in the background, from the queue
+// estimate_media left when `queued`. With no decode threads there is no
+// background to stream in: it is finished at once and streaming stops for the
+// run.
+static bool start_stream(const Adventure *adventure, bool queued) {
+  if (!queued) {
+    adventure_prefetch_media(adventure, media_renderer);
+    restore_asset_root();
+  }
+  AdventureMedia *media = media_of(adventure);
+  if (!media->sized) {
+    // The tap waited on skips next_to_stream's estimate: the queue is it.
+    media->bytes = image_decode_queued_bytes();
+    media->sized = true;
+  }
+  if (!image_decode_start_background()) {
+    image_decode_finish();
+    media_streaming = false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "No decode threads: adventures load when entered");
+    return false;
+  }
+  streaming = adventure;
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s: streaming media",
+              adventure->id);
+  return true;
+}
+
+// Load the streamed adventure from what the pool decoded.
+static bool finish_stream(void) {
+  const Adventure *adventure = streaming;
+  streaming = NULL;
+  return finish_load(adventure, media_of(adventure));
+}
+
+// Size an adventure never loaded from the headers of the images its load
+// would upload, without decoding any. They are left queued, for the load or
+// stream that follows to decode; a caller that doesn't go on drops the queue
+// with image_decode_finish.
+static void estimate_media(const Adventure *adventure, AdventureMedia *media) {
+  adventure_prefetch_media(adventure, media_renderer);
+  restore_asset_root();
+  media->bytes = image_decode_queued_bytes();
+  media->sized = true;
+}
+
+// What to stream next: the adventure waited on, else the first in hub order
+// that isn't loaded and would fit the budget — as last measured, or as
+// estimated for one never loaded. At most one is estimated a frame, the
+// header reads being the cost; `queued` says its images are queued already.
+static const Adventure *next_to_stream(bool *queued) {
+  *queued = false;
+  if (waiting != NULL) {
+    return waiting;
+  }
+  size_t resident = game_media_resident();
+  for (int a = 0; a < adventures_count; a++) {
+    AdventureMedia *media = &adventure_media[a];
+    if (adventures[a] == hub_adventure || media->loaded || media->failed ||
+        resident >= media_budget) {
+      continue;
+    }
+    if (!media->sized) {
+      estimate_media(adventures[a], media);
+      if (media->bytes <= media_budget - resident) {
+        *queued = true;
+        return adventures[a];
+      }
+      image_decode_finish();
+      return NULL; // the next frame looks further
+    }
+    if (media->bytes <= media_budget - resident) {
+      return adventures[a];
+    }
+  }
+  return NULL;
+}
+
+// A stream the tap isn't waiting on keeps what it holds within the budget;
+// one that outgrows its estimate is put aside, its size raised to what it
+// had reached so it isn't streamed again unasked.
+static bool stream_fits(void) {
+  size_t held = image_decode_held_bytes() + image_decode_uploaded_bytes();
+  size_t resident = game_media_resident();
+  if (streaming == waiting ||
+      (resident < media_budget && held <= media_budget - resident)) {
+    return true;
+  }
+  AdventureMedia *media = media_of(streaming);
+  media->bytes = SDL_max(media->bytes, held);
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "%s: outgrew the media budget while streaming (%zu KB)",
+              streaming->id, held / 1024);
+  cancel_stream();
+  return false;
+}
+
+// Drive the stream, once a frame while the hub is up (and has been shown):
+// start the next adventure, upload a couple of its decoded images, and once
+// the pool has been through all of it, load it — entering it when a tap is
+// waiting on it.
+static void stream_media(void) {
+  if (media_renderer == NULL || game.current_adventure != hub_adventure ||
+      !hub_shown) {
+    return;
+  }
+  if (streaming == NULL) {
+    bool queued = false;
+    const Adventure *next = media_streaming ? next_to_stream(&queued) : NULL;
+    if (next != NULL && start_stream(next, queued)) {
+      return;
+    }
+    // Streaming is off, or there turned out to be no background to stream
+    // in: a wait ends in an ordinary load.
+    if (waiting != NULL) {
+      adventure_switch_to(waiting);
+    }
+    return;
+  }
+  if (!stream_fits() ||
+      !image_decode_upload(media_renderer, STREAM_UPLOADS_PER_FRAME)) {
+    return;
+  }
+  if (streaming == waiting) {
+    adventure_switch_to(waiting); // finishes the stream
+  } else {
+    finish_stream();
+  }
+}
+
+void game_set_media_streaming(bool enabled) {
+  media_streaming = enabled;
+  if (!enabled) {
+    cancel_stream();
+  }
+}
+
+void adventure_open(const Adventure *adventure) {
+  const AdventureMedia *media = media_of(adventure);
+  if (!media_streaming || media == NULL || media->loaded ||
+      media_renderer == NULL) {
+    adventure_switch_to(adventure);
+    return;
+  }
+  if (streaming != NULL && streaming != adventure) {
+    cancel_stream();
+  }
+  waiting = adventure;
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s: waiting for its media",
+              adventure->id);
+}
+
+const Adventure *game_media_streaming(void) { return streaming; }
+
+const Adventure *game_media_waiting(void) { return waiting; }
+
+void game_set_media_budget(size_t bytes) {
+  media_budget = bytes;
+  // A background stream was started against the old budget.
+  if (streaming != waiting) {
+    cancel_stream();
+  }
+  evict_to_budget(game.current_adventure, 0);
+}
+
+size_t game_media_budget(void) { return media_budget; }
+
+bool adventure_media_loaded(const Adventure *adventure) {
+  const AdventureMedia *media = media_of(adventure);
+  return media != NULL && media->loaded;
+}
+
+// Release the tiles of every scene of the current adventure that is neither
+// the current scene nor one of its exits: a scene stays paged in while it is
+// a step away.
+static void page_out_cold_scenes(void) {
+  const Adventure *adventure = game.current_adventure;
+  const Scene *current = scene_instance(game.current_scene);
+  for (int i = 0; i < adventure->scenes_length; i++) {
+    if (i != game.current_scene && !scene_has_exit(current, i)) {
+      page_out_scene_planes(&adventure->scenes[i]);
+    }
+  }
 }
 
 // A newly active scene's camera snaps straight onto its target (no easing
@@ -130,11 +459,45 @@ void adventure_switch_to(const Adventure *adventure) {
     const Scene *previous = scene_instance(game.current_scene);
     previous->on_scene_inactive();
     scene_stop_music(previous);
+    // The exits warmed alongside it, too.
+    for (int i = 0; i < game.current_adventure->scenes_length; i++) {
+      page_out_scene_planes(&game.current_adventure->scenes[i]);
+    }
   }
   // A line spoken in the old adventure must not linger over the new one.
   subtitle_clear();
   // Any question was about the adventure being left.
   confirm_close();
+  // A stream in flight is finished if it is this adventure's, and put aside
+  // if not: streaming is for the hub.
+  waiting = NULL;
+  if (streaming != adventure) {
+    cancel_stream();
+  }
+  // Make room before loading, so the adventure being left and the one being
+  // entered needn't both fit: its size is known from its last load, or
+  // estimated before its first.
+  AdventureMedia *media = media_of(adventure);
+  if (media != NULL && !media->loaded && media_renderer != NULL) {
+    bool queued = false;
+    if (!media->sized) {
+      estimate_media(adventure, media);
+      queued = true;
+    }
+    evict_to_budget(adventure, media->bytes);
+    bool loaded = streaming == adventure
+                      ? finish_stream()
+                      : load_adventure(adventure, media, queued);
+    if (!loaded) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "%s: failed to load media; back to the hub", adventure->id);
+      adventure = hub_adventure;
+      media = media_of(adventure);
+    }
+  }
+  if (media != NULL) {
+    media->entered = ++media_clock;
+  }
   game.current_adventure = adventure;
   game.current_scene = adventure->entry_scene;
   asset_set_root(adventure->assets_root);
@@ -145,6 +508,8 @@ void adventure_switch_to(const Adventure *adventure) {
   current->on_scene_active();
   scene_start_music(current);
   snap_scene_camera();
+  // The first load of an adventure may have outgrown the room made for it.
+  evict_to_budget(adventure, 0);
 }
 
 const Scene *scene_instance(int scene) {
@@ -156,10 +521,20 @@ const Scene *scene_instance(int scene) {
 // Sets a new scene as the current scene, optionally placing its actor.
 static void activate_scene(int scene, const SDL_FPoint *actor_at) {
   const Scene *previous = scene_instance(game.current_scene);
+#ifndef PROD
+  // The warming is only as good as the declared graph: say where it's wrong.
+  if (!scene_has_exit(previous, scene)) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "%s: scene %d switched to scene %d, which is not among its "
+                "exits",
+                game.current_adventure->id, game.current_scene, scene);
+  }
+#endif
   previous->on_scene_inactive();
   scene_stop_music(previous);
   subtitle_clear();
   game.current_scene = scene;
+  page_out_cold_scenes();
   const Scene *current = scene_instance(game.current_scene);
   current->on_scene_active();
   // After on_scene_active, so the caller's placement wins over the scene's own
@@ -207,18 +582,41 @@ void game_init(void) {
   }
 }
 
-bool game_load_media(SDL_Renderer *renderer) {
+static bool load_game_media(SDL_Renderer *renderer) {
+  media_renderer = renderer;
+  const char *budget_mb = SDL_getenv("VANIA_MEDIA_BUDGET_MB");
+  if (budget_mb != NULL && SDL_atoi(budget_mb) >= 0) {
+    media_budget = (size_t)SDL_atoi(budget_mb) * 1024 * 1024;
+  }
   if (!load_image_from_path(renderer, &hub_button_image, HUB_BUTTON_PATH)) {
     return false;
   }
-  for (int a = 0; a < adventures_count; a++) {
-    if (!adventure_load_media(adventures[a], renderer)) {
-      return false;
-    }
+  // Only the hub loads up front, and stays: every other adventure loads when
+  // adventure_switch_to enters it (game.h). Decoded on a worker pool while
+  // this thread uploads (image.h), like every adventure load.
+  AdventureMedia *hub_media = media_of(hub_adventure);
+  if (hub_media == NULL || !load_adventure(hub_adventure, hub_media, false)) {
+    return false;
   }
+  // Shared art (boils reused across the hub's buttons) is decoded and uploaded
+  // once; say how much that saved.
+  texture_cache_log_report();
+  // And how many file opens resolving it all took, the .anim files the
+  // compiled-in clip tables stood in for, and the loads the warm-start cache
+  // spared.
+  asset_log_report();
+  animation_clips_log_report();
+  warm_cache_log_report();
   return true;
 }
 
+bool game_load_media(SDL_Renderer *renderer) {
+  TRACE_BEGIN("game_load_media");
+  bool loaded = load_game_media(renderer);
+  TRACE_END("game_load_media");
+  return loaded;
+}
+
 // Touch arrives twice: SDL reports the finger events *and* synthesizes mouse
 // events from the same touch. The engine listens to the synthesized ones and
 // ignores the finger events, so everything downstream deals in mouse events.
@@ -256,6 +654,14 @@ void game_process_input(SDL_Event *event) {
     return;
   }
 
+  // So does the wait for a tapped adventure: a second tap mustn't start
+  // another.
+  if (waiting != NULL &&
+      (event->type == SDL_MOUSEMOTION || event->type == SDL_MOUSEBUTTONDOWN ||
+       event->type == SDL_MOUSEBUTTONUP)) {
+    return;
+  }
+
 #ifndef PROD
   // Two ways into the debug layer, neither of which ships in a PROD build: the
   // D key, and a long press in the top-left corner for devices with no
@@ -331,28 +737,38 @@ void game_process_input(SDL_Event *event) {
 }
 
 void game_update(float delta_time) {
+  // First, so an adventure whose load completes is entered before this frame
+  // updates anything.
+  stream_media();
+
   // Match the hotspot active animations to their enabled state, then advance
   // the active scene's animations (which ticks any now playing) before its own
   // update. A ONE_SHOT end callback fired here may switch scene, so re-fetch
   // the current scene for the update() call (same re-entrancy as a scene switch
   // from process_input).
+  profile_begin(PROFILE_ANIMATIONS);
   sync_hotspot_active_anims(scene_instance(game.current_scene));
   update_scene_animations(*scene_instance(game.current_scene), clock_now_ms());
+  profile_end(PROFILE_ANIMATIONS);
   // A scene either updates itself or leaves update NULL and the framework ticks
   // its actor — the same optional-with-default shape as process_input.
+  profile_begin(PROFILE_SCENE_UPDATE);
   const Scene *scene = scene_instance(game.current_scene);
   if (scene->update != NULL) {
     scene->update(delta_time);
   } else if (scene->actor != NULL) {
     scene_default_update(scene, delta_time);
   }
+  profile_end(PROFILE_SCENE_UPDATE);
 
   // The camera eases after the scene has moved its actor, so it follows this
   // frame's position. Re-fetch: the update may have switched scene (a fresh
   // scene's camera was already snapped by the switch).
   Camera *camera = scene_instance(game.current_scene)->camera;
   if (camera != NULL) {
+    profile_begin(PROFILE_CAMERA);
     camera_update(camera, delta_time);
+    profile_end(PROFILE_CAMERA);
   }
 
   // The modal is engine UI, outside any scene, so it ticks its own animations.
@@ -363,7 +779,41 @@ void game_update(float delta_time) {
 #endif
 }
 
+// Tiles paged in for the current scene's exits each frame: one, so warming a
+// neighbour never costs a frame what entering it cold would.
+#define EXIT_TILE_UPLOADS_PER_FRAME 1
+
+// Warm the current scene's exits (scene.h): their planes' tiles at the view
+// each will open on, so stepping through one finds its backdrop resident.
+static void prepage_scene_exits(SDL_Renderer *renderer) {
+  const Scene *scene = scene_instance(game.current_scene);
+  int budget = EXIT_TILE_UPLOADS_PER_FRAME;
+  for (int i = 0; i < scene->exits_length && budget > 0; i++) {
+    budget -=
+        prepage_scene_planes(renderer, scene_instance(scene->exits[i]), budget);
+  }
+}
+
+// The wait for a tapped adventure: the hub dimmed, as under a question, and a
+// bar filling as the pool decodes. Nothing to read — the player can't.
+static void render_media_progress(SDL_Renderer *renderer) {
+  float progress = streaming == waiting ? image_decode_progress() : 0.0F;
+  SDL_Rect fill = PROGRESS_BAR;
+  fill.w = (int)((float)PROGRESS_BAR.w * progress);
+  SDL_BlendMode blend;
+  SDL_GetRenderDrawBlendMode(renderer, &blend);
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x99);
+  draw_fill_rect(renderer, NULL);
+  SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0x40);
+  draw_fill_rect(renderer, &PROGRESS_BAR);
+  SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+  draw_fill_rect(renderer, &fill);
+  SDL_SetRenderDrawBlendMode(renderer, blend);
+}
+
 void game_render(SDL_Renderer *renderer) {
+  draw_stats_begin_frame();
   const Scene *scene = scene_instance(game.current_scene);
   const Camera *camera = scene->camera;
   // Scene content (and the debug overlay over it) draws shifted by the
@@ -375,29 +825,38 @@ void game_render(SDL_Renderer *renderer) {
                      : (SDL_Point){0, 0};
 
   // Background planes (behind the action layer), each at its own parallax.
+  profile_begin(PROFILE_PLANES);
   render_scene_planes(renderer, scene->bg_planes, scene->bg_planes_length,
                       camera);
+  profile_end(PROFILE_PLANES);
 
   // The static sprite layer then the action layer, both in scene coordinates.
   // The framework draws the declared sprites first; the scene's own render
   // draws the dynamic action layer (the actor, tweens, overlays) on top.
   render_set_offset(camera_offset);
+  profile_begin(PROFILE_SPRITES);
   render_scene_sprites(renderer, scene->sprites, scene->sprites_length);
   render_hotspot_anims(renderer, scene);
+  profile_end(PROFILE_SPRITES);
   // A scene either draws its dynamic layer or leaves render NULL and the
   // framework draws its actor, after the static sprites and inside the
   // same camera offset.
+  profile_begin(PROFILE_ACTION_LAYER);
   if (scene->render != NULL) {
     scene->render(renderer);
   } else if (scene->actor != NULL) {
     scene_default_render(scene, renderer);
   }
+  profile_end(PROFILE_ACTION_LAYER);
   render_set_offset((SDL_Point){0, 0});
 
   // Foreground planes (in front of the action layer): a parallax > 1 strip
   // is a cheap walk-behind with no prop needed.
+  profile_begin(PROFILE_PLANES);
   render_scene_planes(renderer, scene->fg_planes, scene->fg_planes_length,
                       camera);
+  prepage_scene_exits(renderer);
+  profile_end(PROFILE_PLANES);
 
   // The debug overlay draws over everything, in scene coordinates.
   if (game.is_debugging) {
@@ -413,14 +872,27 @@ void game_render(SDL_Renderer *renderer) {
   }
 
   // The dialogue text overlay is screen-space UI, over everything.
+  profile_begin(PROFILE_SUBTITLES);
   subtitle_render(renderer);
+  profile_end(PROFILE_SUBTITLES);
 
   // The modal is over even that: while it is up, nothing else is live.
   confirm_render(renderer);
+
+  if (waiting != NULL) {
+    render_media_progress(renderer);
+  }
+  // Presented as soon as this returns: streaming may start next frame.
+  if (game.current_adventure == hub_adventure) {
+    hub_shown = true;
+  }
 }
 
 void game_deinit(void) {
+  waiting = NULL;
+  cancel_stream();
   free_image_texture(&hub_button_image);
+  debug_free_media();
   for (int a = 0; a < adventures_count; a++) {
     adventure_deinit(adventures[a]);
   }
@@ -30,12 +30,55 @@ void register_adventures(const Adventure *hub, const Adventure **registered,
                          int count);
 
 // Switch to another adventure: outgoing scene inactive (if one is active) ->
-// new adventure/scene set -> adventure on_enter -> incoming entry scene
-// active. Used both for the very first adventure at startup and later runtime
-// switches (hub selection, back-to-hub). Safe to call from a scene's
-// process_input, like set_active_scene.
+// new adventure's media loaded if it isn't -> new adventure/scene set ->
+// adventure on_enter -> incoming entry scene active -> other adventures'
+// media evicted down to the budget. Used both for the very first adventure at
+// startup and later runtime switches (hub selection, back-to-hub). Safe to
+// call from a scene's process_input, like set_active_scene. An adventure
+// whose media fails to load is not entered: the hub is, instead.
 void adventure_switch_to(const Adventure *adventure);
 
+// On-demand media. game_load_media loads only the hub's media, which stays
+// pinned; every other adventure's loads when it is entered, and stays loaded
+// after it is left until the budget needs the room — least recently entered
+// first. The budget is in image memory (TextureCacheStats.bytes_resident)
+// and counts content adventures only; it defaults to MEDIA_BUDGET_DEFAULT_MB,
+// or $VANIA_MEDIA_BUDGET_MB when set. 0 keeps nothing but the current
+// adventure, so peak memory is the hub plus one adventure.
+#define MEDIA_BUDGET_DEFAULT_MB 32
+void game_set_media_budget(size_t bytes);
+size_t game_media_budget(void);
+
+// Whether the adventure's media is loaded (always true for the hub once
+// game_load_media has run), and the image memory held by loaded content
+// adventures' media, as measured when each loaded.
+bool adventure_media_loaded(const Adventure *adventure);
+size_t game_media_resident(void);
+
+// Background streaming. While the hub is up, the adventures not yet loaded
+// stream in behind it, from the frame after its first is shown, one at a time
+// in hub order: the decode pool works through an adventure's images across
+// frames (image_decode_start_background), a couple of them are uploaded each
+// frame as they decode, and once all are in the adventure loads — sounds and
+// cache hits, so the frame that does it is short. At most one adventure never
+// loaded is sized a frame, from its images' headers, and the queue that sizes
+// it is the one it streams from. Nothing streams unasked that wouldn't fit the
+// budget, and what a stream holds counts against the room left. Nor does
+// anything stream while an adventure is being played. On by default; off, or
+// with no decode threads, adventures load when they are entered.
+void game_set_media_streaming(bool enabled);
+
+// Enter an adventure once its media is ready — what the hub's cartridges call.
+// Loaded (or with streaming off), it is adventure_switch_to at once. Otherwise
+// it streams ahead of the rest while the hub shows a progress bar, swallowing
+// taps, and is entered on the frame its load completes.
+void adventure_open(const Adventure *adventure);
+
+// The adventure streaming now, and the one adventure_open is waiting on; NULL
+// for none.
+const Adventure *game_media_streaming(void);
+const Adventure *game_media_waiting(void);
+
 // The current adventure's scene at this index. Asserts current_adventure is
 // set and the index is in range.
 const Scene *scene_instance(int scene);
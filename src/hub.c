@@ -92,7 +92,8 @@ static void start_content(int index) {
   if (index < content_count) {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Hub: starting adventure '%s'",
                 content_adventures[index]->title);
-    adventure_switch_to(content_adventures[index]);
+    // Entered as soon as its media has streamed in (game.h).
+    adventure_open(content_adventures[index]);
   }
 }
 
@@ -8,18 +8,37 @@
 #include <SDL2/SDL.h>
 #include <SDL2_image/SDL_image.h>
 #include <stdbool.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
+#include "arena.h"
 #include "clock.h"
+#include "constants.h"
+#include "draw.h"
 #include "image.h"
+#include "qoi.h"
+#include "trace.h"
+#include "warm_cache.h"
 
 AnimationData *make_animation_data(int frames, AnimationPlaybackStyle style) {
-  AnimationData *animation = malloc(sizeof(AnimationData));
+  AnimationData *animation = arena_scoped_alloc(sizeof(AnimationData));
   if (animation == NULL) {
     return NULL;
   }
-  SDL_Rect *sprite_clips = (SDL_Rect *)malloc(sizeof(SDL_Rect) * frames);
+  SDL_Rect *sprite_clips = arena_scoped_alloc(sizeof(SDL_Rect) * frames);
   if (sprite_clips == NULL) {
-    free(animation);
+    arena_scoped_free(animation);
+    return NULL;
+  }
+  // Zeroed: every frame starts untrimmed until a trimmed .anim row says
+  // otherwise.
+  SDL_Rect *frame_trims = arena_scoped_alloc(sizeof(SDL_Rect) * frames);
+  if (frame_trims == NULL) {
+    arena_scoped_free(sprite_clips);
+    arena_scoped_free(animation);
     return NULL;
   }
   animation->start_time = 0;
@@ -31,61 +50,1296 @@ AnimationData *make_animation_data(int frames, AnimationPlaybackStyle style) {
   animation->current_frame = 0;
   animation->ms_per_frame = DEFAULT_MS_PER_FRAME;
   animation->sprite_clips = sprite_clips;
-  animation->image = (ImageData){NULL, 0, 0};
+  animation->frame_trims = frame_trims;
+  animation->image = (ImageData){0};
   animation->flip = SDL_FLIP_NONE;
   animation->on_end = NULL;
   return animation;
 }
 
-// Free texture if it exists
-void free_image_texture(ImageData *image) {
+// Texture cache: every image is loaded through here, keyed by its resolved
+// path. The resolver already folds the locale into that path (a localized
+// override lives under its own locale directory, shared art under common/), so
+// one key per file on disk is one key per (asset, locale) pair. Two ImageData
+// naming the same file share one decode and one upload; each holds a
+// reference, and free_image_texture gives it back.
+//
+// Textures are shared, so per-texture state is too: a caller that changes a
+// color/alpha mod must restore it after its draw (as hub.c does).
+typedef struct texture_cache_entry {
+  char *path; // owned (SDL_strdup); NULL for a free slot
+  SDL_Texture *texture;
+  int width;  // logical, as handed to ImageData
+  int height;
+  float tier_scale;
+  int refs;
+  // Uploaded ahead by a background decode (image_decode_upload) and not yet
+  // claimed by a load: the first acquire is the load itself, not a share.
+  bool streamed;
+} TextureCacheEntry;
+
+static TextureCacheEntry texture_cache[TEXTURE_CACHE_MAX];
+static TextureCacheStats texture_cache_totals;
+
+static size_t texture_bytes(SDL_Texture *texture) {
+  Uint32 format;
+  int w;
+  int h;
+  if (SDL_QueryTexture(texture, &format, NULL, &w, &h) != 0) {
+    return 0;
+  }
+  return (size_t)w * (size_t)h * SDL_BYTESPERPIXEL(format);
+}
+
+// The bitwise AND of `count` 32-bit pixels: all-ones in the alpha bits only
+// when every pixel is opaque. Four pixels a step with SSE2 or NEON (every
+// desktop, phone and tablet target), so scanning a full-screen plate costs a
+// fraction of its upload even in an unoptimised build.
+static Uint32 and_pixels(const Uint32 *pixels, int count) {
+  int i = 0;
+  Uint32 all = 0xFFFFFFFF;
+#if defined(__SSE2__)
+  __m128i acc = _mm_set1_epi32(-1);
+  for (; i + 4 <= count; i += 4) {
+    acc = _mm_and_si128(acc, _mm_loadu_si128((const __m128i *)(pixels + i)));
+  }
+  acc = _mm_and_si128(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_and_si128(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  all = (Uint32)_mm_cvtsi128_si32(acc);
+#elif defined(__ARM_NEON)
+  uint32x4_t acc = vdupq_n_u32(0xFFFFFFFF);
+  for (; i + 4 <= count; i += 4) {
+    acc = vandq_u32(acc, vld1q_u32(pixels + i));
+  }
+  uint32x2_t half = vand_u32(vget_low_u32(acc), vget_high_u32(acc));
+  all = vget_lane_u32(half, 0) & vget_lane_u32(half, 1);
+#endif
+  for (; i < count; i++) {
+    all &= pixels[i];
+  }
+  return all;
+}
+
+bool surface_is_opaque(SDL_Surface *surface) {
+  const SDL_PixelFormat *format = surface->format;
+  Uint32 key;
+  // A colour key cuts holes just like alpha does. Palette images are left
+  // blended too: rare here (the pipeline writes RGBA), and their alpha lives
+  // in the palette rather than the pixels.
+  if (SDL_GetColorKey(surface, &key) == 0 || format->palette != NULL) {
+    return false;
+  }
+  if (format->Amask == 0) {
+    return true; // an RGB image has no transparency to blend
+  }
+  if (format->BytesPerPixel != 4) {
+    return false;
+  }
+  if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+    return false;
+  }
+  // Test the alpha bits once per row, on the AND of all its pixels. The first
+  // row with a transparent pixel ends the scan.
+  bool opaque = true;
+  for (int y = 0; y < surface->h && opaque; y++) {
+    const Uint32 *row =
+        (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+    opaque = (and_pixels(row, surface->w) & format->Amask) == format->Amask;
+  }
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+  return opaque;
+}
+
+// x * a / 255, rounded, for 8-bit x and a — exact for every input, with no
+// division (the same identity the SIMD paths below use lane-wise).
+static Uint8 mul_div_255(Uint8 x, Uint8 a) {
+  unsigned t = (unsigned)x * a + 128;
+  return (Uint8)((t + (t >> 8)) >> 8);
+}
+
+// Premultiply `count` 32-bit pixels in place: each colour byte times the
+// pixel's alpha byte (byte `alpha_byte` of the pixel in memory), which stays
+// as it is. Four pixels a step with SSE2, eight with NEON, for the layouts
+// the decoders produce — alpha first or last — and scalar otherwise.
+static void premultiply_pixels(Uint8 *pixels, int count, int alpha_byte) {
+  int i = 0;
+#if defined(__SSE2__)
+  if (alpha_byte == 0 || alpha_byte == 3) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i alpha_mask = _mm_set1_epi32((int)(0xFFu << (8 * alpha_byte)));
+    for (; i + 4 <= count; i += 4) {
+      __m128i px = _mm_loadu_si128((const __m128i *)(pixels + 4 * i));
+      __m128i lo = _mm_unpacklo_epi8(px, zero);
+      __m128i hi = _mm_unpackhi_epi8(px, zero);
+      // Each pixel's alpha in all four of its 16-bit lanes.
+      __m128i lo_a;
+      __m128i hi_a;
+      if (alpha_byte == 3) {
+        lo_a = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(3, 3, 3, 3));
+        hi_a = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(3, 3, 3, 3));
+      } else {
+        lo_a = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(lo, _MM_SHUFFLE(0, 0, 0, 0)),
+            _MM_SHUFFLE(0, 0, 0, 0));
+        hi_a = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(hi, _MM_SHUFFLE(0, 0, 0, 0)),
+            _MM_SHUFFLE(0, 0, 0, 0));
+      }
+      __m128i lo_t = _mm_add_epi16(_mm_mullo_epi16(lo, lo_a), half);
+      __m128i hi_t = _mm_add_epi16(_mm_mullo_epi16(hi, hi_a), half);
+      lo_t = _mm_srli_epi16(_mm_add_epi16(lo_t, _mm_srli_epi16(lo_t, 8)), 8);
+      hi_t = _mm_srli_epi16(_mm_add_epi16(hi_t, _mm_srli_epi16(hi_t, 8)), 8);
+      __m128i out = _mm_packus_epi16(lo_t, hi_t);
+      out = _mm_or_si128(_mm_andnot_si128(alpha_mask, out),
+                         _mm_and_si128(alpha_mask, px));
+      _mm_storeu_si128((__m128i *)(pixels + 4 * i), out);
+    }
+  }
+#elif defined(__ARM_NEON)
+  if (alpha_byte == 0 || alpha_byte == 3) {
+    for (; i + 8 <= count; i += 8) {
+      uint8x8x4_t px = vld4_u8(pixels + 4 * i);
+      uint8x8_t a = px.val[alpha_byte];
+      for (int c = 0; c < 4; c++) {
+        if (c != alpha_byte) {
+          uint16x8_t t = vmull_u8(px.val[c], a);
+          px.val[c] = vraddhn_u16(t, vrshrq_n_u16(t, 8));
+        }
+      }
+      vst4_u8(pixels + 4 * i, px);
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    Uint8 *px = pixels + 4 * i;
+    Uint8 a = px[alpha_byte];
+    for (int c = 0; c < 4; c++) {
+      if (c != alpha_byte) {
+        px[c] = mul_div_255(px[c], a);
+      }
+    }
+  }
+}
+
+bool premultiply_surface(SDL_Surface *surface) {
+  const SDL_PixelFormat *format = surface->format;
+  if (format->BytesPerPixel != 4 || format->Amask == 0 ||
+      format->palette != NULL || format->Aloss != 0) {
+    return false;
+  }
+  // Which byte of a pixel holds alpha, in memory order.
+  int alpha_byte = format->Ashift / 8;
+  if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+    alpha_byte = 3 - alpha_byte;
+  }
+  if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+    return false;
+  }
+  for (int y = 0; y < surface->h; y++) {
+    premultiply_pixels((Uint8 *)surface->pixels + y * surface->pitch,
+                       surface->w, alpha_byte);
+  }
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+  return true;
+}
+
+// The renderer the blend mode below was probed on, and the result.
+static SDL_Renderer *blend_probe_renderer = NULL;
+static bool blend_probe_premultiplied = false;
+
+SDL_BlendMode image_blend_mode(SDL_Renderer *renderer) {
+  SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+      SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+      SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+  if (renderer != blend_probe_renderer) {
+    // Custom modes are per back end: the GPU renderers take this one, the
+    // software renderer refuses every custom mode. Ask with a 1x1 texture.
+    SDL_Texture *probe =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                          SDL_TEXTUREACCESS_STATIC, 1, 1);
+    blend_probe_premultiplied =
+        probe != NULL && SDL_SetTextureBlendMode(probe, premultiplied) == 0;
+    SDL_DestroyTexture(probe);
+    blend_probe_renderer = renderer;
+    if (!blend_probe_premultiplied) {
+      SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                  "Renderer has no premultiplied blending; sprites load with "
+                  "straight alpha");
+    }
+  }
+  return blend_probe_premultiplied ? premultiplied : SDL_BLENDMODE_BLEND;
+}
+
+// Parallel decode (see image.h). Decoding a PNG is CPU-bound and independent
+// per file; uploading it is not (the renderer belongs to the main thread). So
+// at startup every image the media pass is about to load is queued, a worker
+// pool decodes the queue in order into surfaces, and upload_image takes the
+// surface for its file instead of calling IMG_Load — waiting if a worker is
+// part-way through it, decoding it itself if no worker has got to it yet.
+typedef enum decode_state {
+  DECODE_QUEUED,
+  DECODE_RUNNING,
+  DECODE_DONE,
+  DECODE_PARKED, // done, held for its load outside the lookahead (paged)
+  DECODE_TAKEN,
+} DecodeState;
+
+// A decoded file, ready to upload.
+typedef struct decoded_image {
+  SDL_Surface *surface; // NULL if the decode failed
+  bool opaque;
+  bool premultiplied; // colour already multiplied by alpha (image_blend_mode)
+} DecodedImage;
+
+typedef struct decode_job {
+  char *path; // owned (SDL_strdup)
+  bool premultiply;
+  DecodedImage result; // set when DONE
+  DecodeState state;
+  // From the file headers at queueing time: the logical size (0 if unread),
+  // the tier, the bytes its upload will take, and whether it loads paged.
+  int width;
+  int height;
+  float tier;
+  size_t bytes;
+  bool paged;
+  // Uploaded ahead by a background decode (image_decode_upload); the pool
+  // holds this reference until image_decode_finish.
+  SDL_Texture *texture;
+} DecodeJob;
+
+#define DECODE_MAX_WORKERS 8
+// Decoded surfaces the workers may hold before the uploads catch up: bounds
+// the pool's memory to a handful of images instead of all of them, in the
+// background as in the foreground.
+#define DECODE_LOOKAHEAD 16
+
+typedef struct decoder {
+  DecodeJob jobs[TEXTURE_CACHE_MAX];
+  int count;
+  int next;  // first job no worker has claimed yet
+  int ready; // DONE jobs whose surface hasn't been taken
+  int lookahead; // surfaces `ready` may reach: DECODE_LOOKAHEAD
+  bool background;
+  bool stopping;
+  SDL_mutex *lock; // non-NULL from image_decode_start to image_decode_finish
+  SDL_cond *changed;
+  SDL_Thread *workers[DECODE_MAX_WORKERS];
+  int worker_count;
+  // For the startup report, in performance-counter ticks.
+  Uint64 started;
+  Uint64 decode_ticks; // decode work, summed over every thread
+  Uint64 worker_ticks; // the part of it the workers did
+  Uint64 wait_ticks;   // the main thread blocked on a worker
+  int decoded;
+} Decoder;
+
+static Decoder decoder;
+
+// Whether `path` is a QOI file, which image.c decodes itself (qoi.h).
+static bool is_qoi(const char *path) {
+  const char *dot = SDL_strrchr(path, '.');
+  return dot != NULL && SDL_strcasecmp(dot, ".qoi") == 0;
+}
+
+// The opacity scan and premultiplication of freshly decoded pixels.
+static DecodedImage finish_decode(SDL_Surface *surface, bool premultiply) {
+  DecodedImage decoded = {surface, false, false};
+  if (surface != NULL) {
+    decoded.opaque = surface_is_opaque(surface);
+    // Opaque art is its own premultiplied form, and is drawn unblended.
+    decoded.premultiplied =
+        !decoded.opaque && premultiply && premultiply_surface(surface);
+  }
+  return decoded;
+}
+
+// A decoded image's warm-start entry (warm_cache.h): its width, height,
+// pixel format and DECODED_* flags as four Uint32s, then its rows, packed.
+// Only 32-bit surfaces are kept (every QOI's, nearly every PNG's); a palette
+// or 24-bit PNG is decoded each time.
+#define DECODED_HEADER_WORDS 4
+#define DECODED_OPAQUE 1U
+#define DECODED_PREMULTIPLIED 2U
+
+static bool warm_image_keeps(const SDL_Surface *surface) {
+  return surface != NULL && surface->format->BytesPerPixel == 4 &&
+         !SDL_ISPIXELFORMAT_INDEXED(surface->format->format);
+}
+
+static DecodedImage read_warm_image(const WarmKey *key) {
+  DecodedImage decoded = {NULL, false, false};
+  size_t size = 0;
+  Uint8 *payload = warm_cache_read(key, &size);
+  Uint32 header[DECODED_HEADER_WORDS];
+  if (payload != NULL && size >= sizeof(header)) {
+    SDL_memcpy(header, payload, sizeof(header));
+    size_t row = (size_t)header[0] * 4;
+    size_t pixels = size - sizeof(header);
+    if (header[0] > 0 && header[0] <= SDL_MAX_SINT32 / 4 && header[1] > 0 &&
+        header[1] <= SDL_MAX_SINT32 && pixels / row == header[1] &&
+        pixels % row == 0) {
+      decoded.surface = SDL_CreateRGBSurfaceWithFormat(
+          0, (int)header[0], (int)header[1], 32, header[2]);
+    }
+  }
+  if (decoded.surface != NULL) {
+    for (int y = 0; y < decoded.surface->h; y++) {
+      SDL_memcpy((Uint8 *)decoded.surface->pixels +
+                     (size_t)y * (size_t)decoded.surface->pitch,
+                 payload + sizeof(header) + (size_t)y * header[0] * 4,
+                 (size_t)header[0] * 4);
+    }
+    decoded.opaque = (header[3] & DECODED_OPAQUE) != 0;
+    decoded.premultiplied = (header[3] & DECODED_PREMULTIPLIED) != 0;
+  }
+  SDL_free(payload);
+  return decoded;
+}
+
+static void write_warm_image(const WarmKey *key, const DecodedImage *decoded) {
+  SDL_Surface *surface = decoded->surface;
+  if (!key->usable || !warm_image_keeps(surface)) {
+    return;
+  }
+  size_t row = (size_t)surface->w * 4;
+  Uint32 header[DECODED_HEADER_WORDS] = {
+      (Uint32)surface->w, (Uint32)surface->h, surface->format->format,
+      (decoded->opaque ? DECODED_OPAQUE : 0) |
+          (decoded->premultiplied ? DECODED_PREMULTIPLIED : 0)};
+  size_t size = sizeof(header) + row * (size_t)surface->h;
+  Uint8 *payload = SDL_malloc(size);
+  if (payload == NULL) {
+    return;
+  }
+  SDL_memcpy(payload, header, sizeof(header));
+  for (int y = 0; y < surface->h; y++) {
+    SDL_memcpy(payload + sizeof(header) + (size_t)y * row,
+               (const Uint8 *)surface->pixels + (size_t)y * surface->pitch,
+               row);
+  }
+  warm_cache_write(key, payload, size);
+  SDL_free(payload);
+}
+
+// Decoding, the opacity scan and premultiplication: the thread-safe part of
+// loading a file. Or, after the first launch, reading all three back from the
+// warm-start cache.
+static DecodedImage decode_file(const char *path, bool premultiply,
+                                Uint64 *ticks) {
+  // On a worker, this scope lands on the worker's own track.
+  TRACE_BEGIN_DETAIL("decode", path);
+  Uint64 start = SDL_GetPerformanceCounter();
+  WarmKey key = warm_cache_key(WARM_IMAGE, path, premultiply);
+  DecodedImage decoded = read_warm_image(&key);
+  if (decoded.surface == NULL) {
+    decoded = finish_decode(
+        is_qoi(path) ? qoi_load(path) : IMG_Load_RW(asset_open(path), 1),
+        premultiply);
+    write_warm_image(&key, &decoded);
+  }
+  *ticks = SDL_GetPerformanceCounter() - start;
+  TRACE_END("decode");
+  return decoded;
+}
+
+static int decode_worker(void *unused) {
+  (void)unused;
+  SDL_LockMutex(decoder.lock);
+  for (;;) {
+    while (decoder.next < decoder.count &&
+           decoder.jobs[decoder.next].state != DECODE_QUEUED) {
+      decoder.next++; // the main thread took it first
+    }
+    if (decoder.stopping || decoder.next >= decoder.count) {
+      break;
+    }
+    if (decoder.ready >= decoder.lookahead) {
+      SDL_CondWait(decoder.changed, decoder.lock);
+      continue;
+    }
+    DecodeJob *job = &decoder.jobs[decoder.next++];
+    job->state = DECODE_RUNNING;
+    SDL_UnlockMutex(decoder.lock);
+
+    Uint64 ticks;
+    DecodedImage result = decode_file(job->path, job->premultiply, &ticks);
+
+    SDL_LockMutex(decoder.lock);
+    job->result = result;
+    job->state = DECODE_DONE;
+    decoder.ready++;
+    decoder.decode_ticks += ticks;
+    decoder.worker_ticks += ticks;
+    decoder.decoded++;
+    SDL_CondBroadcast(decoder.changed);
+  }
+  SDL_UnlockMutex(decoder.lock);
+  return 0;
+}
+
+static DecodeJob *find_decode_job(const char *path) {
+  for (int i = 0; i < decoder.count; i++) {
+    if (SDL_strcmp(decoder.jobs[i].path, path) == 0) {
+      return &decoder.jobs[i];
+    }
+  }
+  return NULL;
+}
+
+// `path` decoded: the pool's result when it was queued, else decoded here.
+// The caller owns the surface.
+static DecodedImage decode_image(const char *path, bool premultiply) {
+  Uint64 ticks;
+  if (decoder.lock == NULL) {
+    return decode_file(path, premultiply, &ticks);
+  }
+  DecodeJob *job = find_decode_job(path);
+  DecodedImage decoded = {NULL, false, false};
+  SDL_LockMutex(decoder.lock);
+  if (job != NULL && job->state == DECODE_RUNNING) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    while (job->state == DECODE_RUNNING) {
+      SDL_CondWait(decoder.changed, decoder.lock);
+    }
+    decoder.wait_ticks += SDL_GetPerformanceCounter() - start;
+  }
+  if (job != NULL &&
+      (job->state == DECODE_DONE || job->state == DECODE_PARKED)) {
+    decoded = job->result;
+    job->result.surface = NULL;
+    if (job->state == DECODE_DONE) {
+      decoder.ready--;
+      SDL_CondBroadcast(decoder.changed);
+    }
+  }
+  if (job != NULL) {
+    job->state = DECODE_TAKEN; // a QUEUED job is decoded right here instead
+  }
+  SDL_UnlockMutex(decoder.lock);
+  if (decoded.surface != NULL) {
+    return decoded;
+  }
+  // Not queued, not reached yet, or failed on the worker (decode it again so
+  // IMG_GetError, which is per thread, explains the failure here).
+  decoded = decode_file(path, premultiply, &ticks);
+  SDL_LockMutex(decoder.lock);
+  decoder.decode_ticks += ticks;
+  decoder.decoded++;
+  SDL_UnlockMutex(decoder.lock);
+  return decoded;
+}
+
+// Upload a decoded surface (or one tile of it). `blend` is the mode for
+// translucent pixels; opaque ones never blend.
+static SDL_Texture *create_texture(SDL_Renderer *renderer,
+                                   SDL_Surface *surface, bool opaque,
+                                   SDL_BlendMode blend, const char *path) {
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+  if (texture == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Unable to create texture from %s: %s", path, SDL_GetError());
+    return NULL;
+  }
+  // Sprites carry a real alpha channel; blending is what makes them composite
+  // (and gives UI art its rounded corners and cut-out glyphs). Art with no
+  // transparent pixel at all — background plates, sky planes, the largest
+  // draws of a frame — is copied unblended, which saves the GPU's and the
+  // software renderer's blend on every pixel.
+  SDL_SetTextureBlendMode(texture, opaque ? SDL_BLENDMODE_NONE : blend);
+  return texture;
+}
+
+// The blend mode for a decoded image's translucent pixels: premultiplied
+// where the decode premultiplied them (image_blend_mode), else straight.
+static SDL_BlendMode decoded_blend_mode(const DecodedImage *decoded,
+                                        SDL_BlendMode premultiplied) {
+  return decoded->premultiplied ? premultiplied : SDL_BLENDMODE_BLEND;
+}
+
+// Decode and upload one file — the uncached path, which only the cache calls.
+static SDL_Texture *upload_image(SDL_Renderer *renderer, const char *path,
+                                 int *width, int *height) {
+  SDL_BlendMode blend = image_blend_mode(renderer);
+  DecodedImage decoded = decode_image(path, blend != SDL_BLENDMODE_BLEND);
+  if (decoded.surface == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s: %s",
+                 path, IMG_GetError());
+    return NULL;
+  }
+  SDL_Texture *texture =
+      create_texture(renderer, decoded.surface, decoded.opaque,
+                     decoded_blend_mode(&decoded, blend), path);
+  *width = decoded.surface->w;
+  *height = decoded.surface->h;
+  SDL_FreeSurface(decoded.surface);
+  return texture;
+}
+
+// Resolution tiers (see image.h), smallest first. Suffixes go before the
+// extension: "plate.png" -> "plate@0.5x.png".
+static const struct {
+  float scale;
+  const char *suffix;
+} image_tiers[] = {{0.5F, "@0.5x"}, {1.0F, ""}};
+
+float image_tier_for_scale(float display_scale) {
+  int last = (int)LEN(image_tiers) - 1;
+  for (int i = 0; i < last; i++) {
+    // A hair of slack so a window sized to exactly half the logical size,
+    // which SDL reports through integer sizes, still gets the half tier.
+    if (image_tiers[i].scale >= display_scale - 0.01F) {
+      return image_tiers[i].scale;
+    }
+  }
+  return image_tiers[last].scale;
+}
+
+float image_display_scale(SDL_Renderer *renderer) {
+  int out_w;
+  int out_h;
+  int logical_w;
+  int logical_h;
+  SDL_RenderGetLogicalSize(renderer, &logical_w, &logical_h);
+  if (logical_w <= 0 || logical_h <= 0 ||
+      SDL_GetRendererOutputSize(renderer, &out_w, &out_h) != 0) {
+    return 1.0F;
+  }
+  return SDL_min((float)out_w / (float)logical_w,
+                 (float)out_h / (float)logical_h);
+}
+
+// `path` with `suffix` spliced in before its extension. False if it won't fit
+// or the file name has no extension.
+static bool tier_variant_path(const char *path, const char *suffix, char *buf,
+                              size_t n) {
+  const char *dot = SDL_strrchr(path, '.');
+  const char *slash = SDL_strrchr(path, '/');
+  if (dot == NULL || (slash != NULL && dot < slash)) {
+    return false;
+  }
+  int written = SDL_snprintf(buf, n, "%.*s%s%s", (int)(dot - path), path,
+                             suffix, dot);
+  return written > 0 && (size_t)written < n;
+}
+
+static int read_be32(const Uint8 *bytes) {
+  return (int)(((Uint32)bytes[0] << 24) | ((Uint32)bytes[1] << 16) |
+               ((Uint32)bytes[2] << 8) | bytes[3]);
+}
+
+// An image's size from its header, without decoding it: the full-size image's
+// logical size when only a smaller tier is uploaded. Exact, where scaling the
+// tier back up would be off by one for odd sizes. PNG (the IHDR chunk is
+// always first) and QOI.
+static bool image_header_size(const char *path, int *width, int *height) {
+  static const Uint8 signature[8] = {0x89, 'P',  'N',  'G',
+                                     '\r', '\n', 0x1A, '\n'};
+  Uint8 header[24];
+  SDL_RWops *file = asset_open(path);
+  if (file == NULL) {
+    return false;
+  }
+  size_t read = SDL_RWread(file, header, 1, sizeof(header));
+  SDL_RWclose(file);
+  if (read >= 12 && SDL_memcmp(header, "qoif", 4) == 0) {
+    *width = read_be32(header + 4);
+    *height = read_be32(header + 8);
+  } else if (read == sizeof(header) &&
+             SDL_memcmp(header, signature, 8) == 0 &&
+             SDL_memcmp(header + 12, "IHDR", 4) == 0) {
+    *width = read_be32(header + 16);
+    *height = read_be32(header + 20);
+  } else {
+    return false;
+  }
+  return *width > 0 && *height > 0;
+}
+
+// The file to upload for `path` on this renderer: the variant of the tier the
+// display needs when it exists beside the original (same locale layer), else
+// the original at full size.
+static float choose_tier(SDL_Renderer *renderer, const char *path, char *buf,
+                         size_t n) {
+  float tier = image_tier_for_scale(image_display_scale(renderer));
+  for (int i = 0; i < (int)LEN(image_tiers); i++) {
+    if (image_tiers[i].scale == tier && image_tiers[i].suffix[0] != '\0' &&
+        tier_variant_path(path, image_tiers[i].suffix, buf, n) &&
+        asset_file_exists(buf)) {
+      return tier;
+    }
+  }
+  SDL_strlcpy(buf, path, n);
+  return 1.0F;
+}
+
+// Whether an image of this logical size (and these pixels at its tier) is
+// paged: it outgrows the window by more than a tile, or the renderer's largest
+// texture.
+static bool image_wants_tiles(SDL_Renderer *renderer, int width, int height,
+                              int pixels_w, int pixels_h) {
+  SDL_RendererInfo info;
+  if (SDL_GetRendererInfo(renderer, &info) == 0 &&
+      ((info.max_texture_width > 0 && pixels_w > info.max_texture_width) ||
+       (info.max_texture_height > 0 && pixels_h > info.max_texture_height))) {
+    return true;
+  }
+  return width > WINDOW_WIDTH + IMAGE_TILE_SIZE ||
+         height > WINDOW_HEIGHT + IMAGE_TILE_SIZE;
+}
+
+// Fill `image` from the cache, loading `path` (or its resolution tier) on a
+// miss.
+static bool acquire_texture(SDL_Renderer *renderer, ImageData *image,
+                            const char *requested) {
+  // The key is the file actually uploaded, so the same art at two tiers could
+  // never alias.
+  char path[ASSET_PATH_MAX];
+  float tier = choose_tier(renderer, requested, path, sizeof(path));
+  TextureCacheEntry *free_slot = NULL;
+  for (int i = 0; i < TEXTURE_CACHE_MAX; i++) {
+    TextureCacheEntry *entry = &texture_cache[i];
+    if (entry->path == NULL) {
+      if (free_slot == NULL) {
+        free_slot = entry;
+      }
+      continue;
+    }
+    if (SDL_strcmp(entry->path, path) == 0) {
+      entry->refs++;
+      if (entry->streamed) {
+        entry->streamed = false;
+      } else {
+        texture_cache_totals.hits++;
+        texture_cache_totals.bytes_saved += texture_bytes(entry->texture);
+      }
+      image->texture = entry->texture;
+      image->width = entry->width;
+      image->height = entry->height;
+      image->tier_scale = entry->tier_scale;
+      return true;
+    }
+  }
+
+  image->texture = upload_image(renderer, path, &image->width, &image->height);
   if (image->texture == NULL) {
+    return false;
+  }
+  texture_cache_totals.bytes_resident += texture_bytes(image->texture);
+  image->tier_scale = tier;
+  if (tier != 1.0F &&
+      !image_header_size(requested, &image->width, &image->height)) {
+    image->width = (int)((float)image->width / tier + 0.5F);
+    image->height = (int)((float)image->height / tier + 0.5F);
+  }
+  texture_cache_totals.loads++;
+  char *key = free_slot != NULL ? SDL_strdup(path) : NULL;
+  if (key == NULL) {
+    // Full (or out of memory): the image still works, it just isn't shared.
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Texture cache full; %s is loaded unshared", path);
+    return true;
+  }
+  *free_slot = (TextureCacheEntry){
+      .path = key,
+      .texture = image->texture,
+      .width = image->width,
+      .height = image->height,
+      .tier_scale = image->tier_scale,
+      .refs = 1,
+  };
+  texture_cache_totals.entries++;
+  return true;
+}
+
+static void release_texture(SDL_Texture *texture) {
+  for (int i = 0; i < TEXTURE_CACHE_MAX; i++) {
+    TextureCacheEntry *entry = &texture_cache[i];
+    if (entry->path != NULL && entry->texture == texture) {
+      if (--entry->refs > 0) {
+        return;
+      }
+      SDL_free(entry->path);
+      *entry = (TextureCacheEntry){.path = NULL};
+      texture_cache_totals.entries--;
+      break;
+    }
+  }
+  texture_cache_totals.bytes_resident -= texture_bytes(texture);
+  SDL_DestroyTexture(texture);
+}
+
+static bool texture_cached(const char *path) {
+  for (int i = 0; i < TEXTURE_CACHE_MAX; i++) {
+    if (texture_cache[i].path != NULL &&
+        SDL_strcmp(texture_cache[i].path, path) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// A sprite sheet's trimmed twins, when the build wrote them beside it
+// (tools/trim_sheets.py: name.trim.png, its tier and name.trim.anim): the same
+// frames cropped to their visible pixels, with their offsets in the authored
+// cells. Switches the resolved `sprite` to the twin (its .qoi, if any) and, if
+// `data` isn't NULL, fills it with the twin's .anim; false, changing nothing,
+// unless both are there. The .anim is written last, so it vouches for the rest.
+static bool prefer_trimmed_sheet(char *sprite, size_t n, char *data,
+                                 size_t data_n) {
+  char anim[ASSET_PATH_MAX];
+  char twin[ASSET_PATH_MAX];
+  if (!asset_swap_extension(sprite, ".trim.anim", anim, sizeof(anim)) ||
+      !asset_file_exists(anim) ||
+      !asset_swap_extension(sprite, ".trim.png", twin, sizeof(twin)) ||
+      !asset_prefer_fast(twin, sizeof(twin))) {
+    return false;
+  }
+  SDL_strlcpy(sprite, twin, n);
+  if (data != NULL) {
+    SDL_strlcpy(data, anim, data_n);
+  }
+  return true;
+}
+
+void image_prefetch(SDL_Renderer *renderer, Asset asset) {
+  char resolved[ASSET_PATH_MAX];
+  char path[ASSET_PATH_MAX];
+  // Queueing ends when the pool starts; a missing file is left for its load
+  // to report.
+  if (decoder.lock != NULL || asset.filename == NULL ||
+      decoder.count >= TEXTURE_CACHE_MAX ||
+      !asset_try_resolve(asset, resolved, sizeof(resolved))) {
+    return;
+  }
+  // The file acquire_texture will ask for, trimmed twin and tier included.
+  // Once per file: every other load of it is a cache hit.
+  prefer_trimmed_sheet(resolved, sizeof(resolved), NULL, 0);
+  float tier = choose_tier(renderer, resolved, path, sizeof(path));
+  if (find_decode_job(path) != NULL || texture_cached(path)) {
     return;
   }
+  char *key = SDL_strdup(path);
+  if (key == NULL) {
+    return;
+  }
+  // Sized from the headers: what its upload will take, and whether its load
+  // pages it.
+  int pixels_w = 0;
+  int pixels_h = 0;
+  int width = 0;
+  int height = 0;
+  bool sized = image_header_size(path, &pixels_w, &pixels_h);
+  if (sized && tier == 1.0F) {
+    width = pixels_w;
+    height = pixels_h;
+  } else if (sized && !image_header_size(resolved, &width, &height)) {
+    width = 0;
+    height = 0;
+  }
+  decoder.jobs[decoder.count++] = (DecodeJob){
+      .path = key,
+      .premultiply = image_blend_mode(renderer) != SDL_BLENDMODE_BLEND,
+      .width = width,
+      .height = height,
+      .tier = tier,
+      .bytes = (size_t)pixels_w * (size_t)pixels_h * 4,
+      .paged = width > 0 && image_wants_tiles(renderer, width, height,
+                                              pixels_w, pixels_h),
+  };
+}
+
+size_t image_decode_queued_bytes(void) {
+  size_t bytes = 0;
+  for (int i = 0; i < decoder.count; i++) {
+    bytes += decoder.jobs[i].bytes;
+  }
+  return bytes;
+}
 
-  SDL_DestroyTexture(image->texture);
+// Workers for the pool: the cores the main thread isn't using, within
+// DECODE_MAX_WORKERS, unless $VANIA_DECODE_THREADS says otherwise (0 decodes
+// everything on the main thread — the serial baseline for the report).
+static int decode_worker_count(void) {
+  const char *env = SDL_getenv("VANIA_DECODE_THREADS");
+  int count = env != NULL ? SDL_atoi(env) : SDL_max(SDL_GetCPUCount() - 1, 1);
+  return SDL_min(SDL_max(count, 0), DECODE_MAX_WORKERS);
+}
+
+// Start the pool on the queue; false if no worker thread could start.
+static bool start_decoder(int lookahead, bool background) {
+  decoder.started = SDL_GetPerformanceCounter();
+  decoder.lookahead = lookahead;
+  decoder.background = background;
+  decoder.lock = SDL_CreateMutex();
+  decoder.changed = SDL_CreateCond();
+  if (decoder.lock == NULL || decoder.changed == NULL) {
+    // No pool: every load decodes for itself, as it always did.
+    SDL_DestroyCond(decoder.changed);
+    SDL_DestroyMutex(decoder.lock);
+    decoder.lock = NULL;
+    decoder.changed = NULL;
+    return false;
+  }
+  int wanted = decode_worker_count();
+  for (int i = 0; i < wanted && decoder.count > 0; i++) {
+    SDL_Thread *thread = SDL_CreateThread(decode_worker, "decode", NULL);
+    if (thread == NULL) {
+      // No threads on this platform (a web build without pthreads): the
+      // queue is simply decoded on the main thread, load by load.
+      break;
+    }
+    decoder.workers[decoder.worker_count++] = thread;
+  }
+  return decoder.worker_count > 0 || decoder.count == 0;
+}
+
+void image_decode_start(void) { start_decoder(DECODE_LOOKAHEAD, false); }
+
+bool image_decode_start_background(void) {
+  return start_decoder(DECODE_LOOKAHEAD, true);
+}
+
+float image_decode_progress(void) {
+  if (decoder.lock == NULL || decoder.count == 0) {
+    return 1.0F;
+  }
+  int decoded = 0;
+  SDL_LockMutex(decoder.lock);
+  for (int i = 0; i < decoder.count; i++) {
+    decoded += decoder.jobs[i].state >= DECODE_DONE;
+  }
+  SDL_UnlockMutex(decoder.lock);
+  return (float)decoded / (float)decoder.count;
+}
+
+// Put a texture a background decode uploaded into the cache, holding one
+// reference for the pool; false if the cache is full.
+static bool cache_streamed(DecodeJob *job, SDL_Texture *texture, int width,
+                           int height) {
+  for (int i = 0; i < TEXTURE_CACHE_MAX; i++) {
+    TextureCacheEntry *entry = &texture_cache[i];
+    if (entry->path != NULL) {
+      continue;
+    }
+    char *key = SDL_strdup(job->path);
+    if (key == NULL) {
+      return false;
+    }
+    *entry = (TextureCacheEntry){
+        .path = key,
+        .texture = texture,
+        .width = width,
+        .height = height,
+        .tier_scale = job->tier,
+        .refs = 1,
+        .streamed = true,
+    };
+    texture_cache_totals.entries++;
+    texture_cache_totals.loads++;
+    texture_cache_totals.bytes_resident += texture_bytes(texture);
+    job->texture = texture;
+    return true;
+  }
+  return false;
+}
+
+bool image_decode_upload(SDL_Renderer *renderer, int max_uploads) {
+  if (decoder.lock == NULL || !decoder.background) {
+    return true;
+  }
+  SDL_BlendMode blend = image_blend_mode(renderer);
+  bool done = true;
+  for (int i = 0; i < decoder.count; i++) {
+    DecodeJob *job = &decoder.jobs[i];
+    DecodedImage decoded = {NULL, false, false};
+    SDL_LockMutex(decoder.lock);
+    bool ready = job->state == DECODE_DONE;
+    if (job->state < DECODE_DONE ||
+        (ready && !job->paged && max_uploads <= 0)) {
+      done = false;
+    } else if (ready) {
+      // A paged image's pixels stay decoded for its load to cut into tiles,
+      // outside the lookahead; any other is uploaded now.
+      decoder.ready--;
+      SDL_CondBroadcast(decoder.changed);
+      if (job->paged) {
+        job->state = DECODE_PARKED;
+      } else {
+        decoded = job->result;
+        job->result.surface = NULL;
+        job->state = DECODE_TAKEN;
+      }
+    }
+    SDL_UnlockMutex(decoder.lock);
+    // A failed decode is left for the load, which decodes it again to report.
+    if (decoded.surface == NULL) {
+      continue;
+    }
+    max_uploads--;
+    SDL_Texture *texture =
+        texture_cached(job->path)
+            ? NULL
+            : create_texture(renderer, decoded.surface, decoded.opaque,
+                             decoded_blend_mode(&decoded, blend), job->path);
+    int width = job->width > 0
+                    ? job->width
+                    : (int)((float)decoded.surface->w / job->tier + 0.5F);
+    int height = job->height > 0
+                     ? job->height
+                     : (int)((float)decoded.surface->h / job->tier + 0.5F);
+    if (texture != NULL && !cache_streamed(job, texture, width, height)) {
+      SDL_DestroyTexture(texture); // no room: the load uploads it itself
+    }
+    SDL_FreeSurface(decoded.surface);
+  }
+  return done;
+}
+
+size_t image_decode_held_bytes(void) {
+  if (decoder.lock == NULL) {
+    return 0;
+  }
+  size_t bytes = 0;
+  SDL_LockMutex(decoder.lock);
+  for (int i = 0; i < decoder.count; i++) {
+    const SDL_Surface *surface = decoder.jobs[i].result.surface;
+    if (surface != NULL) {
+      bytes += (size_t)surface->pitch * (size_t)surface->h;
+    }
+  }
+  SDL_UnlockMutex(decoder.lock);
+  return bytes;
+}
+
+size_t image_decode_uploaded_bytes(void) {
+  size_t bytes = 0;
+  for (int i = 0; i < decoder.count; i++) {
+    if (decoder.jobs[i].texture != NULL) {
+      bytes += texture_bytes(decoder.jobs[i].texture);
+    }
+  }
+  return bytes;
+}
+
+void image_decode_finish(void) {
+  if (decoder.lock != NULL) {
+    SDL_LockMutex(decoder.lock);
+    decoder.stopping = true;
+    SDL_CondBroadcast(decoder.changed);
+    SDL_UnlockMutex(decoder.lock);
+    for (int i = 0; i < decoder.worker_count; i++) {
+      SDL_WaitThread(decoder.workers[i], NULL);
+    }
+    double ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    double wall = (double)(SDL_GetPerformanceCounter() - decoder.started) * ms;
+    double work = (double)decoder.decode_ticks * ms;
+    // Serially, the main thread would have done the workers' share of the
+    // decoding itself, instead of the time it spent waiting on them.
+    double serial = wall - (double)decoder.wait_ticks * ms +
+                    (double)decoder.worker_ticks * ms;
+    // A background decode's wall time is mostly frames going by: only its
+    // work means anything.
+    if (decoder.background) {
+      SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                  "Media streamed: %d decodes on %d worker thread(s), %.0f ms "
+                  "of decode work",
+                  decoder.decoded, decoder.worker_count, work);
+    } else {
+      SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                  "Media loaded in %.0f ms: %d decodes on %d worker thread(s), "
+                  "%.0f ms of decode work (about %.0f ms serially)",
+                  wall, decoder.decoded, decoder.worker_count, work, serial);
+    }
+    SDL_DestroyCond(decoder.changed);
+    SDL_DestroyMutex(decoder.lock);
+  }
+  // Queued files that were never loaded (their load failed or was skipped),
+  // and the pool's references to what it uploaded: a load that took the
+  // texture keeps it, a cancelled stream's goes.
+  for (int i = 0; i < decoder.count; i++) {
+    SDL_FreeSurface(decoder.jobs[i].result.surface);
+    if (decoder.jobs[i].texture != NULL) {
+      release_texture(decoder.jobs[i].texture);
+    }
+    SDL_free(decoder.jobs[i].path);
+  }
+  decoder = (Decoder){0};
+}
+
+TextureCacheStats texture_cache_stats(void) { return texture_cache_totals; }
+
+void texture_cache_log_report(void) {
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "Texture cache: %d textures, %d loads, %d shared (%zu KB of "
+              "duplicate uploads saved)",
+              texture_cache_totals.entries, texture_cache_totals.loads,
+              texture_cache_totals.hits,
+              texture_cache_totals.bytes_saved / 1024);
+}
+
+// ── paged images ─────────────────────────────────────────────────────────────
+
+// A paged image (load_image_paged). The decoded pixels stay in memory while
+// any tile is resident, so a tile released as the view moves is cut again
+// from them; each tile is its own texture. Once every tile is released
+// (image_release_tiles: the scene went cold) the pixels go too, and the next
+// upload decodes the file again.
+typedef struct image_tiles {
+  char *path;           // owned; decoded again from here
+  SDL_Surface *surface; // the loaded tier's pixels; NULL while paged out
+  bool premultiply;     // as decode_image takes it
+  bool opaque;
+  SDL_BlendMode blend; // for translucent pixels, as create_texture takes it
+  float tier_scale;
+  int width; // logical, as handed to ImageData
+  int height;
+  int pixels_w; // the tier's, whether or not `surface` is held
+  int pixels_h;
+  int columns;
+  int rows;
+  int resident;
+  SDL_Texture **textures; // row-major; NULL where paged out
+} ImageTiles;
+
+// Tiles brought in ahead of the view per image_page_tiles call: a camera
+// crossing into a new column spreads its uploads over a few frames instead of
+// spiking one. Tiles already on screen are uploaded when drawn regardless.
+#define TILE_UPLOADS_PER_PAGE 2
+
+// Tile `index`'s pixels in the decoded surface.
+static SDL_Rect tile_pixels(const ImageTiles *tiles, int index) {
+  int x = index % tiles->columns * IMAGE_TILE_SIZE;
+  int y = index / tiles->columns * IMAGE_TILE_SIZE;
+  return (SDL_Rect){x, y, SDL_min(IMAGE_TILE_SIZE, tiles->pixels_w - x),
+                    SDL_min(IMAGE_TILE_SIZE, tiles->pixels_h - y)};
+}
+
+// What is uploaded for a tile: its pixels plus a one-pixel gutter from its
+// neighbours, so linear filtering samples across the seam as it would inside
+// one texture.
+static SDL_Rect tile_upload_pixels(const ImageTiles *tiles, int index) {
+  SDL_Rect core = tile_pixels(tiles, index);
+  int x0 = SDL_max(core.x - 1, 0);
+  int y0 = SDL_max(core.y - 1, 0);
+  int x1 = SDL_min(core.x + core.w + 1, tiles->pixels_w);
+  int y1 = SDL_min(core.y + core.h + 1, tiles->pixels_h);
+  return (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+}
+
+// A logical edge from a tier pixel edge; the image's far edge is its logical
+// size exactly (an odd size halves to a rounded tier).
+static int tile_edge(int pixels, int surface_pixels, int logical, float tier) {
+  return pixels == surface_pixels ? logical : (int)(pixels / tier + 0.5F);
+}
+
+// Tile `index` in logical image coordinates. Each edge is computed once, so
+// neighbours meet without a gap or overlap at any tier.
+static SDL_Rect tile_quad(const ImageTiles *tiles, int index) {
+  SDL_Rect px = tile_pixels(tiles, index);
+  float tier = tiles->tier_scale;
+  int x0 = tile_edge(px.x, tiles->pixels_w, tiles->width, tier);
+  int y0 = tile_edge(px.y, tiles->pixels_h, tiles->height, tier);
+  int x1 = tile_edge(px.x + px.w, tiles->pixels_w, tiles->width, tier);
+  int y1 = tile_edge(px.y + px.h, tiles->pixels_h, tiles->height, tier);
+  return (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+}
+
+// What a paged image holds between pages: its decoded pixels, when it holds
+// them.
+static size_t paged_bytes(const ImageTiles *tiles) {
+  return tiles->surface != NULL ? (size_t)tiles->surface->pitch *
+                                      (size_t)tiles->surface->h
+                                : 0;
+}
+
+// A decoded image as tiles are cut from it: views into its pixels, which a
+// palette can't follow. Takes the surface; NULL on failure.
+static SDL_Surface *tile_source(SDL_Surface *surface) {
+  if (surface == NULL || surface->format->palette == NULL) {
+    return surface;
+  }
+  SDL_Surface *converted =
+      SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+  SDL_FreeSurface(surface);
+  return converted;
+}
+
+// Decode a paged image's pixels again, image_release_tiles having let them go.
+static bool reload_tile_source(ImageTiles *tiles) {
+  tiles->surface =
+      tile_source(decode_image(tiles->path, tiles->premultiply).surface);
+  if (tiles->surface == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to page %s again: %s",
+                 tiles->path, SDL_GetError());
+    return false;
+  }
+  texture_cache_totals.bytes_resident += paged_bytes(tiles);
+  return true;
+}
+
+// Tile `index`'s texture, uploading it if it is paged out. NULL on failure.
+static SDL_Texture *upload_tile(SDL_Renderer *renderer, ImageTiles *tiles,
+                                int index) {
+  if (tiles->textures[index] != NULL) {
+    return tiles->textures[index];
+  }
+  if (tiles->surface == NULL && !reload_tile_source(tiles)) {
+    return NULL;
+  }
+  // A view into the decoded pixels, not a copy.
+  SDL_Rect px = tile_upload_pixels(tiles, index);
+  SDL_Surface *surface = tiles->surface;
+  SDL_Surface *piece = SDL_CreateRGBSurfaceWithFormatFrom(
+      (Uint8 *)surface->pixels + px.y * surface->pitch +
+          px.x * surface->format->BytesPerPixel,
+      px.w, px.h, surface->format->BitsPerPixel, surface->pitch,
+      surface->format->format);
+  if (piece == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Unable to cut a tile of %s: %s", tiles->path,
+                 SDL_GetError());
+    return NULL;
+  }
+  tiles->textures[index] = create_texture(renderer, piece, tiles->opaque,
+                                          tiles->blend, tiles->path);
+  SDL_FreeSurface(piece);
+  if (tiles->textures[index] != NULL) {
+    tiles->resident++;
+  }
+  return tiles->textures[index];
+}
+
+static void release_tile(ImageTiles *tiles, int index) {
+  if (tiles->textures[index] != NULL) {
+    SDL_DestroyTexture(tiles->textures[index]);
+    tiles->textures[index] = NULL;
+    tiles->resident--;
+  }
+}
+
+static void free_image_tiles(ImageTiles *tiles) {
+  if (tiles->textures != NULL) {
+    for (int i = 0; i < tiles->columns * tiles->rows; i++) {
+      release_tile(tiles, i);
+    }
+  }
+  SDL_free(tiles->textures);
+  SDL_FreeSurface(tiles->surface);
+  SDL_free(tiles->path);
+  SDL_free(tiles);
+}
+
+// Upload up to `max_uploads` of the tiles overlapping `want`, and release
+// those well outside it. Returns the uploads made.
+static int page_tiles(SDL_Renderer *renderer, ImageTiles *tiles, SDL_Rect want,
+                      int max_uploads) {
+  // Half a tile of slack before a tile is let go, so a view resting on a tile
+  // edge doesn't upload and release the same tile every frame.
+  SDL_Rect keep = {want.x - IMAGE_TILE_SIZE / 2, want.y - IMAGE_TILE_SIZE / 2,
+                   want.w + IMAGE_TILE_SIZE, want.h + IMAGE_TILE_SIZE};
+  int uploads = 0;
+  for (int i = 0; i < tiles->columns * tiles->rows; i++) {
+    SDL_Rect quad = tile_quad(tiles, i);
+    if (SDL_HasIntersection(&quad, &want)) {
+      if (tiles->textures[i] == NULL && uploads < max_uploads) {
+        upload_tile(renderer, tiles, i);
+        uploads++;
+      }
+    } else if (!SDL_HasIntersection(&quad, &keep)) {
+      release_tile(tiles, i);
+    }
+  }
+  return uploads;
+}
+
+void image_page_tiles(SDL_Renderer *renderer, const ImageData *image,
+                      SDL_Rect want) {
+  if (image->tiles != NULL) {
+    page_tiles(renderer, image->tiles, want, TILE_UPLOADS_PER_PAGE);
+  }
+}
+
+int image_prepage_tiles(SDL_Renderer *renderer, const ImageData *image,
+                        SDL_Rect want, int max_uploads) {
+  if (image->tiles == NULL || max_uploads <= 0) {
+    return 0;
+  }
+  return page_tiles(renderer, image->tiles, want, max_uploads);
+}
+
+void image_release_tiles(const ImageData *image) {
+  ImageTiles *tiles = image->tiles;
+  if (tiles == NULL) {
+    return;
+  }
+  for (int i = 0; i < tiles->columns * tiles->rows; i++) {
+    release_tile(tiles, i);
+  }
+  texture_cache_totals.bytes_resident -= paged_bytes(tiles);
+  SDL_FreeSurface(tiles->surface);
+  tiles->surface = NULL;
+}
+
+ImageTileStats image_tile_stats(const ImageData *image) {
+  if (image->tiles == NULL) {
+    return (ImageTileStats){0, 0};
+  }
+  return (ImageTileStats){image->tiles->columns * image->tiles->rows,
+                          image->tiles->resident};
+}
+
+// Give back the image's texture reference, if it holds one
+void free_image_texture(ImageData *image) {
+  if (image->texture == NULL && image->tiles == NULL) {
+    return;
+  }
+
+  if (image->tiles != NULL) {
+    texture_cache_totals.bytes_resident -= paged_bytes(image->tiles);
+    free_image_tiles(image->tiles);
+    image->tiles = NULL;
+  } else {
+    release_texture(image->texture);
+  }
   image->texture = NULL;
   image->width = 0;
   image->height = 0;
+  image->tier_scale = 0;
 }
 
 // Free animation created with make_animation_data
 void free_animation(AnimationData *animation) {
   free_image_texture(&animation->image);
-  free(animation->sprite_clips);
-  free(animation);
+  arena_scoped_free(animation->sprite_clips);
+  arena_scoped_free(animation->frame_trims);
+  arena_scoped_free(animation);
 }
 
-// Load image from file and create texture in image
 bool load_image_from_path(SDL_Renderer *renderer, ImageData *image,
                           const char *path) {
   free_image_texture(image);
-  SDL_Surface *loaded_surface = IMG_Load(path);
-  if (loaded_surface == NULL) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s: %s",
-                 path, IMG_GetError());
-    return false;
-  }
-  image->texture = SDL_CreateTextureFromSurface(renderer, loaded_surface);
-  if (image->texture == NULL) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                 "Unable to create texture from %s: %s", path, SDL_GetError());
-    SDL_FreeSurface(loaded_surface);
-    return false;
-  }
-  // Alpha is what gives these their shape (rounded corners, cut-out glyphs).
-  SDL_SetTextureBlendMode(image->texture, SDL_BLENDMODE_BLEND);
-  image->width = loaded_surface->w;
-  image->height = loaded_surface->h;
-  SDL_FreeSurface(loaded_surface);
-  return true;
+  // The same preference asset_resolve applies: a .qoi twin beats the .png.
+  char fast[ASSET_PATH_MAX];
+  SDL_strlcpy(fast, path, sizeof(fast));
+  asset_prefer_fast(fast, sizeof(fast));
+  return acquire_texture(renderer, image, fast);
 }
 
 bool load_image(SDL_Renderer *renderer, ImageData *image) {
   // Free texture if it exists
   free_image_texture(image);
 
-  // Load image at specified path
   char image_path[ASSET_PATH_MAX];
   asset_resolve(
       (Asset){
@@ -93,32 +1347,10 @@ bool load_image(SDL_Renderer *renderer, ImageData *image) {
           .directory = image->directory,
       },
       image_path, sizeof(image_path));
-  SDL_Surface *loaded_surface = IMG_Load(image_path);
-  if (loaded_surface == NULL) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s: %s",
-                 image_path, IMG_GetError());
-    return false;
-  }
-
-  // Create texture from surface pixels
-  image->texture = SDL_CreateTextureFromSurface(renderer, loaded_surface);
-  if (image->texture == NULL) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                 "Unable to create texture from %s: %s", image_path,
-                 SDL_GetError());
-    return false;
-  }
-  // Sprites carry a real alpha channel; blending is what makes them composite.
-  SDL_SetTextureBlendMode(image->texture, SDL_BLENDMODE_BLEND);
-  // Get image dimensions
-  image->width = loaded_surface->w;
-  image->height = loaded_surface->h;
-
-  // Get rid of old loaded surface
-  SDL_FreeSurface(loaded_surface);
-
-  // Return success
-  return true;
+  TRACE_BEGIN_DETAIL("load_image", image_path);
+  bool loaded = acquire_texture(renderer, image, image_path);
+  TRACE_END("load_image");
+  return loaded;
 }
 
 bool load_image_table(SDL_Renderer *renderer, ImageData *images, int length) {
@@ -134,37 +1366,133 @@ bool load_image_table(SDL_Renderer *renderer, ImageData *images, int length) {
   return true;
 }
 
+bool load_image_paged(SDL_Renderer *renderer, ImageData *image) {
+  free_image_texture(image);
+
+  char requested[ASSET_PATH_MAX];
+  asset_resolve(
+      (Asset){
+          .filename = image->filename,
+          .directory = image->directory,
+      },
+      requested, sizeof(requested));
+  char path[ASSET_PATH_MAX];
+  float tier = choose_tier(renderer, requested, path, sizeof(path));
+  int width;
+  int height;
+  int pixels_w;
+  int pixels_h;
+  if (!image_header_size(requested, &width, &height) ||
+      !image_header_size(path, &pixels_w, &pixels_h) ||
+      !image_wants_tiles(renderer, width, height, pixels_w, pixels_h)) {
+    return acquire_texture(renderer, image, requested);
+  }
+
+  SDL_BlendMode blend = image_blend_mode(renderer);
+  DecodedImage decoded = decode_image(path, blend != SDL_BLENDMODE_BLEND);
+  if (decoded.surface == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s: %s",
+                 path, IMG_GetError());
+    return false;
+  }
+  decoded.surface = tile_source(decoded.surface);
+  ImageTiles *tiles = SDL_calloc(1, sizeof(*tiles));
+  if (tiles == NULL || decoded.surface == NULL) {
+    SDL_free(tiles);
+    SDL_FreeSurface(decoded.surface);
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to page %s: %s", path,
+                 SDL_GetError());
+    return false;
+  }
+  *tiles = (ImageTiles){
+      .path = SDL_strdup(path),
+      .surface = decoded.surface,
+      .premultiply = blend != SDL_BLENDMODE_BLEND,
+      .opaque = decoded.opaque,
+      .blend = decoded_blend_mode(&decoded, blend),
+      .tier_scale = tier,
+      .width = width,
+      .height = height,
+      .pixels_w = decoded.surface->w,
+      .pixels_h = decoded.surface->h,
+      .columns = (decoded.surface->w + IMAGE_TILE_SIZE - 1) / IMAGE_TILE_SIZE,
+      .rows = (decoded.surface->h + IMAGE_TILE_SIZE - 1) / IMAGE_TILE_SIZE,
+  };
+  tiles->textures =
+      SDL_calloc((size_t)(tiles->columns * tiles->rows), sizeof(SDL_Texture *));
+  if (tiles->path == NULL || tiles->textures == NULL) {
+    free_image_tiles(tiles);
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to page %s: %s", path,
+                 SDL_GetError());
+    return false;
+  }
+  image->tiles = tiles;
+  image->width = width;
+  image->height = height;
+  image->tier_scale = tier;
+  texture_cache_totals.bytes_resident += paged_bytes(tiles);
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "Paging %s (%dx%d) as %d tiles of %d px", path, width, height,
+              tiles->columns * tiles->rows, IMAGE_TILE_SIZE);
+  return true;
+}
+
 void free_image_table(ImageData *images, int length) {
   for (int i = 0; i < length; i++) {
     free_image_texture(&images[i]);
   }
 }
 
-// Load animation sprite clips
+// Store one parsed .anim row: a plain clip (4 fields), or a trimmed one whose
+// last four fields place it inside its untrimmed cell.
+static bool store_animation_row(AnimationData *animation, int row,
+                                const int *fields, int count) {
+  if ((count != 4 && count != 8) || row >= animation->frames) {
+    return false;
+  }
+  animation->sprite_clips[row] = (SDL_Rect){
+      .x = fields[0],
+      .y = fields[1],
+      .w = fields[2],
+      .h = fields[3],
+  };
+  animation->frame_trims[row] = (SDL_Rect){0, 0, 0, 0};
+  if (count == 8) {
+    // The clip has to fit inside the cell it was cut from, or the renderers
+    // would draw it past the frame's bounds.
+    if (fields[6] <= 0 || fields[7] <= 0 || fields[4] + fields[2] > fields[6] ||
+        fields[5] + fields[3] > fields[7]) {
+      return false;
+    }
+    animation->frame_trims[row] = (SDL_Rect){
+        .x = fields[4],
+        .y = fields[5],
+        .w = fields[6],
+        .h = fields[7],
+    };
+  }
+  return true;
+}
+
+// Parse animation sprite clips
 //
 // Data format:
-// * One sprite clip per row: "x,y,w,h"
+// * One sprite clip per row: "x,y,w,h", or "x,y,w,h,ox,oy,cw,ch" for a frame
+//   trimmed to its alpha bounds (the clip sits at ox,oy in a cw x ch cell)
 // * Rows are delimited by '\n' (a trailing '\r' is tolerated)
 // * Exactly `animation->frames` rows, no more, no less
 //
 // Strict on purpose: a malformed .anim (stray field, too many digits, wrong
 // row/field count, garbage byte) rejects the whole file loudly instead of
-// silently overflowing `num`/`rect`/`sprite_clips` or half-working.
-static bool load_animation_data(AnimationData *animation, const char *path) {
-  size_t size;
-  char *data = SDL_LoadFile(path, &size);
-  if (data == NULL) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                 "Failed to load animation data %s", path);
-    return false;
-  }
-
+// silently overflowing `num`/`fields`/`sprite_clips` or half-working.
+bool parse_animation_data(AnimationData *animation, const char *data,
+                          size_t size) {
   // Support coordinates up to 99999 (5 digits + NUL).
   char num[6];
-  int rect[4];
+  int fields[8];
   int row = 0;
   int num_i = 0;
-  int rect_i = 0;
+  int field_i = 0;
   bool ok = true;
 
   for (size_t i = 0; i < size && ok; i++) {
@@ -173,25 +1501,16 @@ static bool load_animation_data(AnimationData *animation, const char *path) {
       continue;
     }
     if (c == ',' || c == '\n') {
-      if (num_i == 0 || rect_i >= 4) {
+      if (num_i == 0 || field_i >= 8) {
         ok = false;
         break;
       }
       num[num_i] = '\0';
-      rect[rect_i++] = atoi(num);
+      fields[field_i++] = atoi(num);
       num_i = 0;
       if (c == '\n') {
-        if (rect_i != 4 || row >= animation->frames) {
-          ok = false;
-          break;
-        }
-        animation->sprite_clips[row++] = (SDL_Rect){
-            .x = rect[0],
-            .y = rect[1],
-            .w = rect[2],
-            .h = rect[3],
-        };
-        rect_i = 0;
+        ok = store_animation_row(animation, row++, fields, field_i);
+        field_i = 0;
       }
     } else if (c >= '0' && c <= '9') {
       if (num_i >= (int)sizeof(num) - 1) {
@@ -207,61 +1526,181 @@ static bool load_animation_data(AnimationData *animation, const char *path) {
 
   // Flush a final row with no trailing newline.
   if (ok && num_i > 0) {
-    if (rect_i >= 4) {
+    if (field_i >= 8) {
       ok = false;
     } else {
       num[num_i] = '\0';
-      rect[rect_i++] = atoi(num);
-      if (rect_i != 4 || row >= animation->frames) {
-        ok = false;
-      } else {
-        animation->sprite_clips[row++] = (SDL_Rect){
-            .x = rect[0],
-            .y = rect[1],
-            .w = rect[2],
-            .h = rect[3],
-        };
+      fields[field_i++] = atoi(num);
+      ok = store_animation_row(animation, row++, fields, field_i);
+    }
+  }
+
+  return ok && row == animation->frames;
+}
+
+// Clip tables compiled in from the generated asset headers, by the root their
+// paths are relative to. Filled by adventure_init before any load and only
+// read after, so it needs no lock.
+typedef struct clip_root {
+  const char *root;
+  const AnimationClips *clips;
+  int length;
+} ClipRoot;
+
+static ClipRoot clip_roots[ANIMATION_CLIP_ROOTS_MAX];
+static int clip_roots_length;
+
+static SDL_atomic_t clips_compiled_in;
+static SDL_atomic_t clips_parsed;
+
+void register_animation_clips(const char *root, const AnimationClips *clips,
+                              int length) {
+  if (root == NULL || clips == NULL) {
+    return;
+  }
+  for (int i = 0; i < clip_roots_length; i++) {
+    if (clip_roots[i].root == root) {
+      clip_roots[i].clips = clips;
+      clip_roots[i].length = length;
+      return;
+    }
+  }
+  if (clip_roots_length == ANIMATION_CLIP_ROOTS_MAX) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Too many clip tables; %s's .anim files load from disk", root);
+    return;
+  }
+  clip_roots[clip_roots_length++] = (ClipRoot){root, clips, length};
+}
+
+// The compiled-in table for a resolved path ("<root>/<layer>/<dir>/<file>"),
+// or NULL. The resolver has already picked the layer, so a localized table is
+// found under its own path just as the file would have been.
+static const AnimationClips *find_animation_clips(const char *path) {
+  for (int i = 0; i < clip_roots_length; i++) {
+    size_t length = SDL_strlen(clip_roots[i].root);
+    if (SDL_strncmp(path, clip_roots[i].root, length) != 0 ||
+        path[length] != '/') {
+      continue;
+    }
+    for (int j = 0; j < clip_roots[i].length; j++) {
+      if (SDL_strcmp(path + length + 1, clip_roots[i].clips[j].path) == 0) {
+        return &clip_roots[i].clips[j];
       }
     }
   }
+  return NULL;
+}
 
-  SDL_free(data);
+AnimationClipStats animation_clip_stats(void) {
+  return (AnimationClipStats){SDL_AtomicGet(&clips_compiled_in),
+                              SDL_AtomicGet(&clips_parsed)};
+}
 
-  if (!ok || row != animation->frames) {
+void animation_clips_log_report(void) {
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "Animation clips: %d compiled in, %d parsed from .anim files",
+              SDL_AtomicGet(&clips_compiled_in), SDL_AtomicGet(&clips_parsed));
+}
+
+static bool load_animation_data(AnimationData *animation, const char *path) {
+  const AnimationClips *compiled = find_animation_clips(path);
+  if (compiled != NULL) {
+    // The generator checked the rows as strictly as parse_animation_data
+    // would; only the frame count the animation was made with is left.
+    if (compiled->frames != animation->frames) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Malformed animation data %s: %d frames, expected %d", path,
+                   compiled->frames, animation->frames);
+      return false;
+    }
+    size_t bytes = sizeof(SDL_Rect) * (size_t)compiled->frames;
+    SDL_memcpy(animation->sprite_clips, compiled->clips, bytes);
+    if (compiled->trims != NULL) {
+      SDL_memcpy(animation->frame_trims, compiled->trims, bytes);
+    } else {
+      SDL_memset(animation->frame_trims, 0, bytes);
+    }
+    SDL_AtomicAdd(&clips_compiled_in, 1);
+    return true;
+  }
+  SDL_AtomicAdd(&clips_parsed, 1);
+  // Parsed on an earlier launch: the warm-start cache kept the clips, then
+  // the trims.
+  size_t bytes = sizeof(SDL_Rect) * (size_t)animation->frames;
+  WarmKey key = warm_cache_key(WARM_CLIPS, path, (Uint64)animation->frames);
+  size_t size = 0;
+  Uint8 *parsed = warm_cache_read(&key, &size);
+  if (parsed != NULL && size == 2 * bytes) {
+    SDL_memcpy(animation->sprite_clips, parsed, bytes);
+    SDL_memcpy(animation->frame_trims, parsed + bytes, bytes);
+    SDL_free(parsed);
+    return true;
+  }
+  SDL_free(parsed);
+  char *data = asset_load_file(path, &size);
+  if (data == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Failed to load animation data %s", path);
+    return false;
+  }
+  bool ok = parse_animation_data(animation, data, size);
+  SDL_free(data);
+  if (!ok) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed animation data %s",
                  path);
     return false;
   }
+  Uint8 *table = key.usable ? SDL_malloc(2 * bytes) : NULL;
+  if (table != NULL) {
+    SDL_memcpy(table, animation->sprite_clips, bytes);
+    SDL_memcpy(table + bytes, animation->frame_trims, bytes);
+    warm_cache_write(&key, table, 2 * bytes);
+    SDL_free(table);
+  }
   return true;
 }
 
 bool load_animation(SDL_Renderer *renderer, AnimationData *animation,
                     Asset sprite_asset, Asset data_asset) {
+  TRACE_BEGIN_DETAIL("load_animation", sprite_asset.filename);
   animation->image.filename = sprite_asset.filename;
   animation->image.directory = sprite_asset.directory;
-  if (!load_image(renderer, &animation->image)) {
+  free_image_texture(&animation->image);
+  // load_image's resolve, but the sheet and its clips come as a pair: the
+  // trimmed twins together, or the authored files.
+  char sprite_path[ASSET_PATH_MAX];
+  char data_path[ASSET_PATH_MAX];
+  asset_resolve(sprite_asset, sprite_path, sizeof(sprite_path));
+  bool trimmed = prefer_trimmed_sheet(sprite_path, sizeof(sprite_path),
+                                      data_path, sizeof(data_path));
+  bool loaded = acquire_texture(renderer, &animation->image, sprite_path);
+  if (!loaded) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                  "Failed to load animation texture %s", sprite_asset.filename);
-    return false;
-  }
-
-  char data_path[ASSET_PATH_MAX];
-  asset_resolve(data_asset, data_path, sizeof(data_path));
-  if (!load_animation_data(animation, data_path)) {
-    return false;
+  } else {
+    if (!trimmed) {
+      asset_resolve(data_asset, data_path, sizeof(data_path));
+    }
+    loaded = load_animation_data(animation, data_path);
   }
-
-  return true;
+  TRACE_END("load_animation");
+  return loaded;
 }
 
 bool load_animation_from_path(SDL_Renderer *renderer, AnimationData *animation,
                               const char *sprite_path, const char *data_path) {
-  if (!load_image_from_path(renderer, &animation->image, sprite_path)) {
+  char sprite[ASSET_PATH_MAX];
+  char data[ASSET_PATH_MAX];
+  SDL_strlcpy(sprite, sprite_path, sizeof(sprite));
+  SDL_strlcpy(data, data_path, sizeof(data));
+  prefer_trimmed_sheet(sprite, sizeof(sprite), data, sizeof(data));
+  if (!load_image_from_path(renderer, &animation->image, sprite)) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                  "Failed to load animation texture %s", sprite_path);
     return false;
   }
-  return load_animation_data(animation, data_path);
+  return load_animation_data(animation, data);
 }
 
 void play_animation(AnimationData *animation, void (*on_end)(void)) {
@@ -318,6 +1757,53 @@ void render_set_offset(SDL_Point offset) { render_offset = offset; }
 
 SDL_Point render_get_offset(void) { return render_offset; }
 
+SDL_Point animation_frame_size(const AnimationData *animation, int frame) {
+  const SDL_Rect *clip = &animation->sprite_clips[frame];
+  if (animation->frame_trims == NULL || animation->frame_trims[frame].w == 0) {
+    return (SDL_Point){clip->w, clip->h};
+  }
+  return (SDL_Point){animation->frame_trims[frame].w,
+                     animation->frame_trims[frame].h};
+}
+
+SDL_Rect animation_frame_quad(const AnimationData *animation, SDL_Point point) {
+  int frame = animation->current_frame;
+  const SDL_Rect *clip = &animation->sprite_clips[frame];
+  if (animation->frame_trims == NULL || animation->frame_trims[frame].w == 0) {
+    return (SDL_Rect){point.x, point.y, clip->w, clip->h};
+  }
+  // SDL flips the clip within its own quad, so a mirrored sprite needs its
+  // trim offset mirrored about the cell too.
+  const SDL_Rect *trim = &animation->frame_trims[frame];
+  int x = trim->x;
+  int y = trim->y;
+  if (animation->flip & SDL_FLIP_HORIZONTAL) {
+    x = trim->w - trim->x - clip->w;
+  }
+  if (animation->flip & SDL_FLIP_VERTICAL) {
+    y = trim->h - trim->y - clip->h;
+  }
+  return (SDL_Rect){point.x + x, point.y + y, clip->w, clip->h};
+}
+
+// Clips are authored against the full-size sheet; a sheet loaded at a smaller
+// resolution tier has its clips scaled to match, while the destination quads
+// stay logical. An edge that falls between tier pixels moves inward: the clip
+// may lose a sliver of its own frame, but never samples its neighbour's.
+SDL_Rect animation_texture_clip(const AnimationData *animation) {
+  SDL_Rect clip = animation->sprite_clips[animation->current_frame];
+  float tier = animation->image.tier_scale;
+  if (tier <= 0 || tier == 1.0F) {
+    return clip;
+  }
+  int x0 = (int)SDL_ceilf((float)clip.x * tier);
+  int y0 = (int)SDL_ceilf((float)clip.y * tier);
+  int x1 = (int)SDL_floorf((float)(clip.x + clip.w) * tier);
+  int y1 = (int)SDL_floorf((float)(clip.y + clip.h) * tier);
+  // A frame narrower than two tier pixels still draws its one.
+  return (SDL_Rect){x0, y0, SDL_max(x1 - x0, 1), SDL_max(y1 - y0, 1)};
+}
+
 void render_animation(SDL_Renderer *renderer, AnimationData *animation,
                       SDL_Point point) {
   // Failed/!loaded animations have no texture; skip them instead of asking SDL
@@ -328,18 +1814,69 @@ void render_animation(SDL_Renderer *renderer, AnimationData *animation,
 
   // Pure draw: blit the frame chosen by animation_update. No timing here, so
   // playback speed is independent of how often the scene is rendered.
-  SDL_Rect *clip = &animation->sprite_clips[animation->current_frame];
-  SDL_Rect render_quad = {point.x + render_offset.x, point.y + render_offset.y,
-                          clip->w, clip->h};
-  SDL_RenderCopyEx(renderer, animation->image.texture, clip, &render_quad, 0,
-                   NULL, animation->flip);
+  SDL_Rect clip = animation_texture_clip(animation);
+  SDL_Rect render_quad = animation_frame_quad(animation, point);
+  render_quad.x += render_offset.x;
+  render_quad.y += render_offset.y;
+  draw_copy_ex(renderer, animation->image.texture, &clip, &render_quad, 0,
+               NULL, animation->flip);
+}
+
+// Where logical offset `at` along an image `logical` long lands in a quad
+// `size` long. Neighbouring tiles map their shared edge to the same pixel, so
+// a scaled plane opens no seams.
+static int tile_dest_edge(int at, int logical, int size) {
+  return (int)((Sint64)at * size / logical);
+}
+
+// A paged image drawn into `dest` (its whole quad, camera offset applied),
+// mirrored by `flip`: the tiles on screen, uploading any the paging hasn't
+// brought in yet.
+static void render_tiles(SDL_Renderer *renderer, const ImageData *image,
+                         SDL_Rect dest, SDL_RendererFlip flip) {
+  static const SDL_Rect screen = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+  ImageTiles *tiles = image->tiles;
+  for (int i = 0; i < tiles->columns * tiles->rows; i++) {
+    SDL_Rect local = tile_quad(tiles, i);
+    int x0 = tile_dest_edge(local.x, image->width, dest.w);
+    int y0 = tile_dest_edge(local.y, image->height, dest.h);
+    int x1 = tile_dest_edge(local.x + local.w, image->width, dest.w);
+    int y1 = tile_dest_edge(local.y + local.h, image->height, dest.h);
+    SDL_Rect quad = {dest.x + x0, dest.y + y0, x1 - x0, y1 - y0};
+    if (flip & SDL_FLIP_HORIZONTAL) {
+      quad.x = dest.x + dest.w - x1;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+      quad.y = dest.y + dest.h - y1;
+    }
+    if (!SDL_HasIntersection(&quad, &screen)) {
+      continue;
+    }
+    SDL_Texture *texture = upload_tile(renderer, tiles, i);
+    if (texture != NULL) {
+      // The tile's own pixels, inside the gutter it was uploaded with.
+      SDL_Rect core = tile_pixels(tiles, i);
+      SDL_Rect uploaded = tile_upload_pixels(tiles, i);
+      SDL_Rect clip = {core.x - uploaded.x, core.y - uploaded.y, core.w,
+                       core.h};
+      if (flip == SDL_FLIP_NONE) {
+        draw_copy(renderer, texture, &clip, &quad);
+      } else {
+        draw_copy_ex(renderer, texture, &clip, &quad, 0, NULL, flip);
+      }
+    }
+  }
 }
 
 void render_image(SDL_Renderer *renderer, const ImageData *image,
                   SDL_Point point) {
   SDL_Rect render_quad = {point.x + render_offset.x, point.y + render_offset.y,
                           image->width, image->height};
-  SDL_RenderCopy(renderer, image->texture, NULL, &render_quad);
+  if (image->tiles != NULL) {
+    render_tiles(renderer, image, render_quad, SDL_FLIP_NONE);
+    return;
+  }
+  draw_copy(renderer, image->texture, NULL, &render_quad);
 }
 
 // Destination rect for a draw of natural size w x h at `point`, scaled around
@@ -365,11 +1902,14 @@ void render_animation_scaled_about(SDL_Renderer *renderer,
   if (animation->image.texture == NULL) {
     return;
   }
-  SDL_Rect *clip = &animation->sprite_clips[animation->current_frame];
-  SDL_Rect render_quad =
-      scaled_quad_about(point, clip->w, clip->h, scale, anchor);
-  SDL_RenderCopyEx(renderer, animation->image.texture, clip, &render_quad, 0,
-                   NULL, animation->flip);
+  // The frame is scaled as a whole, so its trimmed clip keeps its place in
+  // the cell: the quad's corners go through the same mapping as the cell's.
+  SDL_Rect clip = animation_texture_clip(animation);
+  SDL_Rect quad = animation_frame_quad(animation, point);
+  SDL_Rect render_quad = scaled_quad_about((SDL_Point){quad.x, quad.y}, quad.w,
+                                           quad.h, scale, anchor);
+  draw_copy_ex(renderer, animation->image.texture, &clip, &render_quad, 0,
+               NULL, animation->flip);
 }
 
 void render_image_scaled_about(SDL_Renderer *renderer, const ImageData *image,
@@ -377,7 +1917,11 @@ void render_image_scaled_about(SDL_Renderer *renderer, const ImageData *image,
                                SDL_RendererFlip flip) {
   SDL_Rect render_quad =
       scaled_quad_about(point, image->width, image->height, scale, anchor);
-  SDL_RenderCopyEx(renderer, image->texture, NULL, &render_quad, 0, NULL, flip);
+  if (image->tiles != NULL) {
+    render_tiles(renderer, image, render_quad, flip);
+    return;
+  }
+  draw_copy_ex(renderer, image->texture, NULL, &render_quad, 0, NULL, flip);
 }
 
 void render_animation_scaled(SDL_Renderer *renderer, AnimationData *animation,
@@ -385,14 +1929,29 @@ void render_animation_scaled(SDL_Renderer *renderer, AnimationData *animation,
   if (animation->image.texture == NULL) {
     return;
   }
-  SDL_Rect *clip = &animation->sprite_clips[animation->current_frame];
-  SDL_Rect render_quad = scaled_quad(point, clip->w, clip->h, scale);
-  SDL_RenderCopyEx(renderer, animation->image.texture, clip, &render_quad, 0,
-                   NULL, animation->flip);
+  SDL_Rect clip = animation_texture_clip(animation);
+  SDL_Rect quad = animation_frame_quad(animation, point);
+  SDL_Point cell = animation_frame_size(animation, animation->current_frame);
+  SDL_Rect render_quad;
+  if (quad.w == cell.x && quad.h == cell.y) {
+    render_quad = scaled_quad(point, quad.w, quad.h, scale);
+  } else {
+    // A trimmed frame scales about its whole cell's centre, like an untrimmed
+    // one, rather than about the centre of what's left after trimming.
+    SDL_Point centre = {point.x + cell.x / 2, point.y + cell.y / 2};
+    render_quad = scaled_quad_about((SDL_Point){quad.x, quad.y}, quad.w,
+                                    quad.h, scale, centre);
+  }
+  draw_copy_ex(renderer, animation->image.texture, &clip, &render_quad, 0,
+               NULL, animation->flip);
 }
 
 void render_image_scaled(SDL_Renderer *renderer, const ImageData *image,
                          SDL_Point point, float scale) {
   SDL_Rect render_quad = scaled_quad(point, image->width, image->height, scale);
-  SDL_RenderCopy(renderer, image->texture, NULL, &render_quad);
+  if (image->tiles != NULL) {
+    render_tiles(renderer, image, render_quad, SDL_FLIP_NONE);
+    return;
+  }
+  draw_copy(renderer, image->texture, NULL, &render_quad);
 }
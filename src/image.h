@@ -25,6 +25,14 @@ typedef struct image_data {
   const char *directory;
   int width;
   int height;
+  // Set by the loader: the resolution tier the texture was loaded at (0.5 for
+  // a name@0.5x.png variant). width/height stay in logical pixels whatever the
+  // tier; the renderers scale source clips by this. 0 or 1 is full size.
+  float tier_scale;
+  // Set by load_image_paged for an image too large to upload whole: its
+  // tiles, paged in and out around the view. texture stays NULL; the
+  // render_image* functions draw it tile by tile, scaled or not.
+  struct image_tiles *tiles;
 } ImageData;
 
 typedef enum animation_playback_style {
@@ -46,6 +54,12 @@ typedef struct animation_data {
   // Milliseconds per frame (defaults to DEFAULT_MS_PER_FRAME).
   int ms_per_frame;
   SDL_Rect *sprite_clips;
+  // Per frame, for sheets whose frames were trimmed to their alpha bounds
+  // (tools/trim_sheets.py): x/y is where the clip sits inside its untrimmed
+  // cell and w/h is the cell's size. All zero for an untrimmed frame, whose
+  // clip is the whole cell. The renderers apply it, so a trimmed sheet draws
+  // exactly where its untrimmed original did.
+  SDL_Rect *frame_trims;
   ImageData image;
   SDL_RendererFlip flip;
   // Fired once when the animation stops (a ONE_SHOT reaching its loop count,
@@ -57,6 +71,69 @@ typedef struct animation_data {
 
 AnimationData *make_animation_data(int frames, AnimationPlaybackStyle style);
 
+// Distinct files the texture cache can hold at once. Past this an image still
+// loads, it just isn't shared.
+#define TEXTURE_CACHE_MAX 512
+
+// Running totals for the shared texture cache behind load_image and
+// load_image_from_path (see image.c).
+typedef struct texture_cache_stats {
+  int entries;        // distinct textures currently cached
+  int loads;          // decodes + uploads performed
+  int hits;           // loads served by an already-cached texture
+  size_t bytes_saved; // texture memory those hits would have uploaded again
+  // Image memory held right now: every loaded texture, and the decoded pixels
+  // a paged image keeps to cut its tiles from while it is paged in (the tiles
+  // themselves come and go with the view). What the on-demand media budget is
+  // measured in.
+  size_t bytes_resident;
+} TextureCacheStats;
+
+TextureCacheStats texture_cache_stats(void);
+
+// Log the totals above; game_load_media calls this once media is up.
+void texture_cache_log_report(void);
+
+// Parallel decode for the startup media pass (game_load_media). Queue the
+// images about to be loaded with image_prefetch, then image_decode_start
+// hands the queue to a worker pool that decodes the PNGs into surfaces while
+// the main thread uploads them, in the same order, through the usual
+// load_image calls. Anything not queued still loads — it just decodes on the
+// main thread. image_decode_finish joins the pool, frees whatever was never
+// loaded and logs the timing; $VANIA_DECODE_THREADS=0 makes it serial, for
+// comparison.
+void image_prefetch(SDL_Renderer *renderer, Asset asset);
+void image_decode_start(void);
+void image_decode_finish(void);
+
+// The upload size of everything queued, from the files' headers: what an
+// adventure's load is about to take, before anything is decoded.
+size_t image_decode_queued_bytes(void);
+
+// The same pool decoding in the background, for an adventure streamed in while
+// the hub is up (game.h), frames going on meanwhile. It holds no more decoded
+// surfaces than the startup pass does; image_decode_upload, called once a
+// frame, drains them into the texture cache a few at a time, where the
+// adventure's load finds them. False — the pool started but useless — when no
+// worker thread could start; finish it either way. image_decode_progress is
+// the share of the queue decoded so far, 1 when nothing is queued or no pool
+// is running.
+bool image_decode_start_background(void);
+float image_decode_progress(void);
+
+// Upload up to `max_uploads` of what a background decode has decoded. The
+// pool holds a reference to each texture until image_decode_finish, which a
+// load's own references outlive. A paged image stays decoded for its load to
+// cut into tiles. True once every queued image is decoded and dealt with (and
+// for no background decode).
+bool image_decode_upload(SDL_Renderer *renderer, int max_uploads);
+
+// What a background decode holds for an adventure not loaded yet: decoded
+// surfaces waiting, and the textures it has uploaded.
+size_t image_decode_held_bytes(void);
+size_t image_decode_uploaded_bytes(void);
+
+// Drop the image's texture reference; the texture is destroyed with its last.
 void free_image_texture(ImageData *image);
 
 void free_animation(AnimationData *animation);
@@ -69,20 +146,123 @@ bool load_image(SDL_Renderer *renderer, ImageData *image);
 bool load_image_from_path(SDL_Renderer *renderer, ImageData *image,
                           const char *path);
 
+// Resolution tiers: an image may ship scaled-down siblings beside it
+// (background@0.5x.png next to background.png, written by
+// tools/gen_asset_tiers.py). The loader picks the smallest tier that still
+// covers the display scale — the renderer's output size over its logical size
+// — so a small window or a low-density phone uploads a quarter of the pixels.
+// Images without the variant load at full size. Everything past the loader
+// stays in logical coordinates.
+float image_tier_for_scale(float display_scale);
+
+// Output pixels per logical pixel on the smaller axis; 1 with no logical size.
+float image_display_scale(SDL_Renderer *renderer);
+
+// Whether a decoded image has no transparent pixel (no alpha below 255, no
+// colour key). Such images are uploaded with SDL_BLENDMODE_NONE instead of
+// BLEND. Split out so the scan can be tested without a renderer.
+bool surface_is_opaque(SDL_Surface *surface);
+
+// Multiply a 32-bit surface's colour channels by its alpha, in place (SSE2 or
+// NEON where available). False, untouched, for formats without 8 bits of
+// alpha in each 4-byte pixel.
+bool premultiply_surface(SDL_Surface *surface);
+
+// The blend mode for premultiplied textures on renderer (ONE,
+// ONE_MINUS_SRC_ALPHA), or SDL_BLENDMODE_BLEND where it can't do that — the
+// software renderer can't — in which case sprites keep straight alpha.
+// Translucent sprites are premultiplied at load and drawn with it: no per
+// pixel divide, and no dark fringes where filtering mixes in transparent
+// texels. Fading one with an alpha mod needs the same colour mod too.
+SDL_BlendMode image_blend_mode(SDL_Renderer *renderer);
+
+// Paged images are cut into squares of this many (tier) pixels.
+#define IMAGE_TILE_SIZE 512
+
+// load_image for the scrolling planes. An image that outgrows the window by
+// more than a tile on either axis, or the renderer's largest texture, stays
+// decoded in memory and is uploaded as IMAGE_TILE_SIZE tiles, only those near
+// the view resident (image_page_tiles) — a 4096px backdrop costs the GPU a
+// few tiles, not a texture it may refuse. Anything smaller loads exactly as
+// load_image does. Paged images bypass the texture cache.
+bool load_image_paged(SDL_Renderer *renderer, ImageData *image);
+
+// Upload a paged image's tiles overlapping `want` (logical image coordinates;
+// a few per call, see image.c) and release those more than half a tile
+// outside it. No-op for an unpaged image, as is the next.
+void image_page_tiles(SDL_Renderer *renderer, const ImageData *image,
+                      SDL_Rect want);
+
+// image_page_tiles for an image not on screen yet (a neighbouring scene's
+// plane): at most `max_uploads` uploads, and how many it made.
+int image_prepage_tiles(SDL_Renderer *renderer, const ImageData *image,
+                        SDL_Rect want, int max_uploads);
+
+// Release every resident tile of a paged image, and the decoded pixels they
+// are cut from; drawing it decodes the file again and brings the visible
+// ones back.
+void image_release_tiles(const ImageData *image);
+
+typedef struct image_tile_stats {
+  int tiles;    // in the grid; 0 for an unpaged image
+  int resident; // uploaded right now
+} ImageTileStats;
+
+ImageTileStats image_tile_stats(const ImageData *image);
+
 // Load (or free) a whole table of images — a scene's, or an adventure's shared
 // bank. On the first failure the images that already loaded are freed, so the
 // caller can fail the media pass without leaking textures.
 bool load_image_table(SDL_Renderer *renderer, ImageData *images, int length);
 void free_image_table(ImageData *images, int length);
 
+// Load a sprite sheet and its clip table. When the build wrote the sheet's
+// trimmed twins beside it (tools/trim_sheets.py), those are loaded instead,
+// both of them: the data asset then goes unused.
 bool load_animation(SDL_Renderer *renderer, AnimationData *animation,
                     Asset sprite_asset, Asset data_asset);
 
+// Parse .anim text into animation's clips: one "x,y,w,h" row per frame, or
+// "x,y,w,h,ox,oy,cw,ch" for a frame trimmed out of a cw x ch cell at (ox, oy).
+// Strict: exactly animation->frames rows, anything malformed rejects the lot.
+// Split out of load_animation so the format can be tested without a file.
+bool parse_animation_data(AnimationData *animation, const char *data,
+                          size_t size);
+
 // Load an animation from repo-relative paths, the load_image_from_path
 // counterpart: for engine-owned art under assets/, outside any adventure.
 bool load_animation_from_path(SDL_Renderer *renderer, AnimationData *animation,
                               const char *sprite_path, const char *data_path);
 
+// An .anim file compiled in: the generated asset headers emit one per file
+// under an adventure's root (<PREFIX>_ANIM_CLIPS_INIT), so loading its
+// animations copies these rects instead of opening and parsing the file.
+typedef struct animation_clips {
+  const char *path; // layer-relative: "<layer>/<dir>/<name>.anim"
+  int frames;
+  const SDL_Rect *clips;
+  const SDL_Rect *trims; // as AnimationData.frame_trims; NULL if untrimmed
+} AnimationClips;
+
+// Most roots with compiled-in clip tables at once.
+#define ANIMATION_CLIP_ROOTS_MAX 8
+
+// Serve the .anim files under `root` from `clips` from now on. Called from
+// adventure_init, before any media loads; the table and root are stored, not
+// copied. A file with no entry is still read from disk.
+void register_animation_clips(const char *root, const AnimationClips *clips,
+                              int length);
+
+typedef struct animation_clip_stats {
+  int compiled_in; // clip tables copied from a registered table
+  int parsed;      // .anim files read and parsed
+} AnimationClipStats;
+
+AnimationClipStats animation_clip_stats(void);
+
+// Log the totals above; game_load_media calls this once media is up.
+void animation_clips_log_report(void);
+
 void play_animation(AnimationData *animation, void (*on_end)(void));
 
 void stop_animation(AnimationData *animation);
@@ -93,6 +273,19 @@ void stop_animation(AnimationData *animation);
 // how often the frame is drawn, and so end callbacks don't fire mid-render.
 void animation_update(AnimationData *animation, int now_ms);
 
+// A frame's full (untrimmed) size as x = width, y = height — what layout,
+// hit boxes and anchors should measure, rather than its clip.
+SDL_Point animation_frame_size(const AnimationData *animation, int frame);
+
+// Where the current frame's clip lands, at natural size and before the camera
+// offset, for an animation drawn at `point`: shifted by its trim offset
+// (mirrored with the sprite's flip). The whole cell for an untrimmed frame.
+SDL_Rect animation_frame_quad(const AnimationData *animation, SDL_Point point);
+
+// The current frame's clip in the loaded texture's pixels: the .anim clip,
+// scaled to the sheet's resolution tier and kept inside its frame.
+SDL_Rect animation_texture_clip(const AnimationData *animation);
+
 void render_animation(SDL_Renderer *renderer, AnimationData *animation,
                       SDL_Point point);
 
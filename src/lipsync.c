@@ -1,14 +1,18 @@
 //
 //  lipsync.c
-//  Parsing and playback of the .cues / .words sidecars (see SPEECH.md).
-//  Parsers are strict on purpose (the .anim parser's lesson): a bad byte
-//  rejects the whole file loudly instead of half-working.
+//  Parsing and playback of the .cues / .words sidecars and their binary
+//  twins (see SPEECH.md). Parsers are strict on purpose (the .anim parser's
+//  lesson): a bad byte rejects the whole file loudly instead of half-working.
 //
 
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "lipsync.h"
+#include "pack.h"
+#include "trace.h"
+#include "warm_cache.h"
 
 // Rhubarb's letters mapped to frames; the extended shapes G (F/V) and H (L)
 // are accepted defensively and collapsed onto near equivalents, so
@@ -90,14 +94,20 @@ static bool parse_ms(const char **p, const char *end, Uint32 *out) {
   return true;
 }
 
+// Both parsers read a file twice: a first pass checks every line and counts
+// what it holds, so the second can store it in one allocation of exactly that
+// size. Loaded with an adventure's chunks, those allocations land back to back
+// in its media arena (adventure.c): every line's cues and words in a few
+// contiguous blocks, with no room left over.
 typedef struct cue_parse {
-  MouthCues *cues;
+  MouthCues *cues; // NULL on the counting pass
+  int count;
+  Uint32 last_ms;
   bool ok;
 } CueParse;
 
 static bool visit_cue(const char *line, size_t length, void *user) {
   CueParse *parse = user;
-  MouthCues *cues = parse->cues;
   const char *p = line;
   const char *end = line + length;
 
@@ -108,41 +118,49 @@ static bool visit_cue(const char *line, size_t length, void *user) {
     parse->ok = false;
     return false;
   }
-  if (cues->length >= LIPSYNC_MAX_CUES ||
-      (cues->length > 0 && ms < cues->cues[cues->length - 1].at_ms)) {
+  if (parse->count >= LIPSYNC_MAX_CUES ||
+      (parse->count > 0 && ms < parse->last_ms)) {
     parse->ok = false;
     return false;
   }
-  cues->cues[cues->length].at_ms = ms;
-  cues->cues[cues->length].shape = shape;
-  cues->length++;
+  if (parse->cues != NULL) {
+    parse->cues->cues[parse->count].at_ms = ms;
+    parse->cues->cues[parse->count].shape = shape;
+  }
+  parse->count++;
+  parse->last_ms = ms;
   return true;
 }
 
 bool lipsync_parse(const char *data, size_t size, MouthCues *out) {
-  out->cues = malloc(sizeof(MouthCue) * LIPSYNC_MAX_CUES);
+  out->cues = NULL;
   out->length = 0;
-  if (out->cues == NULL) {
+  CueParse parse = {NULL, 0, 0, true};
+  if (!for_each_line(data, size, visit_cue, &parse) || !parse.ok ||
+      parse.count == 0) {
     return false;
   }
-
-  CueParse parse = {out, true};
-  if (!for_each_line(data, size, visit_cue, &parse) || !parse.ok ||
-      out->length == 0) {
-    lipsync_free(out);
+  out->cues = arena_scoped_alloc(sizeof(MouthCue) * (size_t)parse.count);
+  if (out->cues == NULL) {
     return false;
   }
+  parse = (CueParse){out, 0, 0, true};
+  for_each_line(data, size, visit_cue, &parse);
+  out->length = parse.count;
   return true;
 }
 
 typedef struct word_parse {
-  WordTimings *words;
+  WordTimings *words; // NULL on the counting pass
+  char *text;         // where the next word's bytes go
+  int count;
+  size_t text_size; // the words' bytes, NULs included
+  Uint32 last_start_ms;
   bool ok;
 } WordParse;
 
 static bool visit_word(const char *line, size_t length, void *user) {
   WordParse *parse = user;
-  WordTimings *words = parse->words;
   const char *p = line;
   const char *end = line + length;
 
@@ -160,75 +178,366 @@ static bool visit_word(const char *line, size_t length, void *user) {
   p++;
   size_t word_length = (size_t)(end - p);
   if (word_length == 0 || start_ms > end_ms ||
-      words->length >= LIPSYNC_MAX_WORDS ||
-      (words->length > 0 &&
-       start_ms < words->words[words->length - 1].start_ms)) {
+      parse->count >= LIPSYNC_MAX_WORDS ||
+      (parse->count > 0 && start_ms < parse->last_start_ms)) {
     parse->ok = false;
     return false;
   }
 
-  char *word = malloc(word_length + 1);
-  if (word == NULL) {
-    parse->ok = false;
-    return false;
+  if (parse->words != NULL) {
+    memcpy(parse->text, p, word_length);
+    parse->text[word_length] = '\0';
+    parse->words->words[parse->count].start_ms = start_ms;
+    parse->words->words[parse->count].end_ms = end_ms;
+    parse->words->words[parse->count].word = parse->text;
+    parse->text += word_length + 1;
   }
-  memcpy(word, p, word_length);
-  word[word_length] = '\0';
-  words->words[words->length].start_ms = start_ms;
-  words->words[words->length].end_ms = end_ms;
-  words->words[words->length].word = word;
-  words->length++;
+  parse->count++;
+  parse->text_size += word_length + 1;
+  parse->last_start_ms = start_ms;
   return true;
 }
 
 bool lipsync_parse_words(const char *data, size_t size, WordTimings *out) {
-  out->words = malloc(sizeof(WordTiming) * LIPSYNC_MAX_WORDS);
+  out->words = NULL;
   out->length = 0;
+  WordParse parse = {0};
+  parse.ok = true;
+  if (!for_each_line(data, size, visit_word, &parse) || !parse.ok ||
+      parse.count == 0) {
+    return false;
+  }
+  // The timings, then every word's text after them, in the one block.
+  size_t table = sizeof(WordTiming) * (size_t)parse.count;
+  out->words = arena_scoped_alloc(table + parse.text_size);
   if (out->words == NULL) {
     return false;
   }
+  parse = (WordParse){out, (char *)out->words + table, 0, 0, 0, true};
+  for_each_line(data, size, visit_word, &parse);
+  out->length = parse.count;
+  return true;
+}
+
+// The binary twins: a magic, the version byte, a zero byte and a u16 count,
+// little-endian. A .bcues then holds each cue's ms after the previous cue's as
+// a varint, then the shapes, two to a byte. A .bwords holds a u32 text size,
+// each word's start after the previous start and its length in ms as varints,
+// then the words, NUL-terminated, to the end of the file.
+#define CUES_MAGIC "VLCU"
+#define WORDS_MAGIC "VLWD"
+#define BINARY_HEADER_SIZE 8
+
+typedef struct reader {
+  const Uint8 *at;
+  const Uint8 *end;
+} Reader;
+
+static bool read_header(Reader *r, const char *magic, int max, int *count) {
+  if (r->end - r->at < BINARY_HEADER_SIZE || memcmp(r->at, magic, 4) != 0 ||
+      r->at[4] != LIPSYNC_BINARY_VERSION || r->at[5] != 0) {
+    return false;
+  }
+  *count = r->at[6] | r->at[7] << 8;
+  r->at += BINARY_HEADER_SIZE;
+  return *count > 0 && *count <= max;
+}
+
+// Seven bits a byte, low bits first, the high bit set on all but the last.
+// Four bytes reach past any time parse_ms accepts.
+static bool read_varint(Reader *r, Uint32 *out) {
+  Uint32 value = 0;
+  for (int shift = 0; shift < 28 && r->at < r->end; shift += 7) {
+    Uint8 byte = *r->at++;
+    value |= (Uint32)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
 
-  WordParse parse = {out, true};
-  if (!for_each_line(data, size, visit_word, &parse) || !parse.ok ||
-      out->length == 0) {
-    lipsync_free_words(out);
+// Advance *ms by a varint delta, within the text parser's bound.
+static bool read_delta(Reader *r, Uint32 *ms) {
+  Uint32 delta;
+  if (!read_varint(r, &delta) || delta > 1000000000 - *ms) {
     return false;
   }
+  *ms += delta;
   return true;
 }
 
-// Read a sidecar through the asset layer; NULL when the file is absent
-// (which is the normal case for SFX chunks and untranslated locales).
-static char *load_sidecar(Asset asset, size_t *size) {
-  char path[ASSET_PATH_MAX];
-  if (!asset_try_resolve(asset, path, sizeof(path))) {
-    return NULL;
+bool lipsync_decode(const void *data, size_t size, MouthCues *out) {
+  out->cues = NULL;
+  out->length = 0;
+  Reader r = {data, (const Uint8 *)data + size};
+  int count;
+  if (!read_header(&r, CUES_MAGIC, LIPSYNC_MAX_CUES, &count)) {
+    return false;
+  }
+  MouthCue *cues = arena_scoped_alloc(sizeof(MouthCue) * (size_t)count);
+  if (cues == NULL) {
+    return false;
+  }
+  Uint32 ms = 0;
+  bool ok = true;
+  for (int i = 0; ok && i < count; i++) {
+    ok = read_delta(&r, &ms);
+    cues[i].at_ms = ms;
   }
-  return SDL_LoadFile(path, size);
+  // An odd count leaves the last byte's high nibble zero.
+  ok = ok && r.end - r.at == (count + 1) / 2 &&
+       (count % 2 == 0 || r.at[count / 2] >> 4 == 0);
+  for (int i = 0; ok && i < count; i++) {
+    cues[i].shape = (r.at[i / 2] >> (i % 2 * 4)) & 0x0f;
+    ok = cues[i].shape < MOUTH_SHAPE_COUNT;
+  }
+  if (!ok) {
+    arena_scoped_free(cues);
+    return false;
+  }
+  out->cues = cues;
+  out->length = count;
+  return true;
+}
+
+// With `in_place`, the words point into `data` itself, which must then
+// outlive them (a mapped pack does); otherwise their text follows the timings
+// in the block, as the text parser lays it out.
+static bool decode_words(const Uint8 *data, size_t size, bool in_place,
+                         WordTimings *out) {
+  out->words = NULL;
+  out->length = 0;
+  Reader r = {data, data + size};
+  int count;
+  if (!read_header(&r, WORDS_MAGIC, LIPSYNC_MAX_WORDS, &count) ||
+      r.end - r.at < 4) {
+    return false;
+  }
+  size_t text_size = (size_t)r.at[0] | (size_t)r.at[1] << 8 |
+                     (size_t)r.at[2] << 16 | (size_t)r.at[3] << 24;
+  r.at += 4;
+  if (text_size > (size_t)(r.end - r.at)) {
+    return false;
+  }
+  r.end -= text_size; // the timings stop where the text starts
+  size_t table = sizeof(WordTiming) * (size_t)count;
+  WordTiming *words = arena_scoped_alloc(table + (in_place ? 0 : text_size));
+  if (words == NULL) {
+    return false;
+  }
+  const char *text = (const char *)r.end;
+  if (!in_place) {
+    memcpy((char *)words + table, text, text_size);
+    text = (const char *)words + table;
+  }
+  const char *text_end = text + text_size;
+
+  Uint32 start_ms = 0;
+  bool ok = true;
+  for (int i = 0; ok && i < count; i++) {
+    Uint32 length_ms;
+    const char *nul = memchr(text, '\0', (size_t)(text_end - text));
+    ok = read_delta(&r, &start_ms) && read_varint(&r, &length_ms) &&
+         length_ms <= 1000000000 - start_ms && nul != NULL && nul > text;
+    if (ok) {
+      words[i] = (WordTiming){start_ms, start_ms + length_ms, text};
+      text = nul + 1;
+    }
+  }
+  if (!ok || r.at != r.end || text != text_end) {
+    arena_scoped_free(words);
+    return false;
+  }
+  out->words = words;
+  out->length = count;
+  return true;
+}
+
+bool lipsync_decode_words(const void *data, size_t size, WordTimings *out) {
+  return decode_words(data, size, false, out);
+}
+
+// Whether the resolver picked the file with this extension.
+static bool resolved_to(const char *path, const char *extension) {
+  const char *dot = SDL_strrchr(path, '.');
+  return dot != NULL && SDL_strcasecmp(dot, extension) == 0;
+}
+
+// A twin that won't decode was written by an older tool or is damaged; the
+// text it was compiled from sits beside it and says the same, so switch
+// `path` over to that.
+static void fall_back_to_text(char *path, size_t n, const char *extension) {
+  SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+              "Stale or malformed lip-sync twin %s (run make lipsync); "
+              "reading its text",
+              path);
+  char text[ASSET_PATH_MAX];
+  if (asset_swap_extension(path, extension, text, sizeof(text))) {
+    SDL_strlcpy(path, text, n);
+  }
+}
+
+// A sidecar parsed on an earlier launch, as the warm-start cache kept it
+// (warm_cache.h). Checked like a twin, though this build wrote it: an entry
+// that doesn't hold up is a miss and the text is parsed again.
+static bool read_warm_cues(const WarmKey *key, MouthCues *out) {
+  size_t size = 0;
+  MouthCue *kept = warm_cache_read(key, &size);
+  size_t count = size / sizeof(MouthCue);
+  bool ok = kept != NULL && size % sizeof(MouthCue) == 0 && count > 0 &&
+            count <= LIPSYNC_MAX_CUES;
+  for (size_t i = 0; ok && i < count; i++) {
+    ok = kept[i].shape < MOUTH_SHAPE_COUNT;
+  }
+  MouthCue *cues = ok ? arena_scoped_alloc(size) : NULL;
+  if (cues != NULL) {
+    memcpy(cues, kept, size);
+    out->cues = cues;
+    out->length = (int)count;
+  }
+  SDL_free(kept);
+  return cues != NULL;
+}
+
+// The words' block as the text parser laid it out, after a u32 count; the
+// words' pointers are left out (zeroed) and found again by walking the text.
+static bool read_warm_words(const WarmKey *key, WordTimings *out) {
+  size_t size = 0;
+  Uint8 *kept = warm_cache_read(key, &size);
+  if (kept == NULL) {
+    return false;
+  }
+  Uint32 count = 0;
+  if (size >= sizeof(count)) {
+    memcpy(&count, kept, sizeof(count));
+  }
+  size_t table = sizeof(WordTiming) * (size_t)count;
+  WordTiming *words = NULL;
+  if (size >= sizeof(count) && count > 0 && count <= LIPSYNC_MAX_WORDS &&
+      size - sizeof(count) > table) {
+    words = arena_scoped_alloc(size - sizeof(count));
+  }
+  if (words == NULL) {
+    SDL_free(kept);
+    return false;
+  }
+  memcpy(words, kept + sizeof(count), size - sizeof(count));
+  SDL_free(kept);
+  const char *text = (const char *)words + table;
+  const char *text_end = (const char *)words + size - sizeof(count);
+  bool ok = true;
+  for (Uint32 i = 0; ok && i < count; i++) {
+    const char *nul = memchr(text, '\0', (size_t)(text_end - text));
+    ok = nul != NULL && nul > text;
+    if (ok) {
+      words[i].word = text;
+      text = nul + 1;
+    }
+  }
+  if (!ok || text != text_end) {
+    arena_scoped_free(words);
+    return false;
+  }
+  out->words = words;
+  out->length = (int)count;
+  return true;
+}
+
+static void write_warm_words(const WarmKey *key, const WordTimings *words) {
+  if (!key->usable) {
+    return;
+  }
+  const WordTiming *last = &words->words[words->length - 1];
+  size_t block = (size_t)(last->word - (const char *)words->words) +
+                 SDL_strlen(last->word) + 1;
+  Uint32 count = (Uint32)words->length;
+  Uint8 *payload = SDL_malloc(sizeof(count) + block);
+  if (payload == NULL) {
+    return;
+  }
+  memcpy(payload, &count, sizeof(count));
+  memcpy(payload + sizeof(count), words->words, block);
+  for (Uint32 i = 0; i < count; i++) {
+    WordTiming *word = (WordTiming *)(payload + sizeof(count)) + i;
+    memset(&word->word, 0, sizeof(word->word));
+  }
+  warm_cache_write(key, payload, sizeof(count) + block);
+  SDL_free(payload);
 }
 
 bool lipsync_load(Asset asset, MouthCues *out) {
   out->cues = NULL;
   out->length = 0;
-  size_t size = 0;
-  char *data = load_sidecar(asset, &size);
-  if (data == NULL) {
+  // Absent is the normal case for SFX chunks and untranslated locales.
+  char path[ASSET_PATH_MAX];
+  if (!asset_try_resolve(asset, path, sizeof(path))) {
     return false;
   }
-  bool ok = lipsync_parse(data, size, out);
-  SDL_free(data);
+  TRACE_BEGIN_DETAIL("lipsync_load", asset.filename);
+  bool ok = false;
+  size_t size = 0;
+  if (resolved_to(path, ".bcues")) {
+    // A mapped pack's bytes decode where they lie.
+    const void *mapped = pack_map(path, &size);
+    void *data = mapped == NULL ? asset_load_file(path, &size) : NULL;
+    ok = (mapped != NULL || data != NULL) &&
+         lipsync_decode(mapped != NULL ? mapped : data, size, out);
+    SDL_free(data);
+    if (!ok) {
+      fall_back_to_text(path, sizeof(path), ".cues");
+    }
+  }
+  WarmKey key = {0};
   if (!ok) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed cues sidecar: %s/%s",
-                 asset.directory, asset.filename);
+    key = warm_cache_key(WARM_CUES, path, 0);
+    ok = read_warm_cues(&key, out);
   }
+  if (!ok) {
+    char *data = asset_load_file(path, &size);
+    ok = data != NULL && lipsync_parse(data, size, out);
+    if (data != NULL && !ok) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Malformed cues sidecar: %s/%s", asset.directory,
+                   asset.filename);
+    }
+    SDL_free(data);
+    if (ok) {
+      warm_cache_write(&key, out->cues, sizeof(MouthCue) * (size_t)out->length);
+    }
+  }
+  TRACE_END("lipsync_load");
   return ok;
 }
 
 bool lipsync_load_words(Asset asset, WordTimings *out) {
   out->words = NULL;
   out->length = 0;
+  char path[ASSET_PATH_MAX];
+  if (!asset_try_resolve(asset, path, sizeof(path))) {
+    return false;
+  }
   size_t size = 0;
-  char *data = load_sidecar(asset, &size);
+  if (resolved_to(path, ".bwords")) {
+    // Words read from a mapped pack keep pointing into it.
+    const void *mapped = pack_map(path, &size);
+    if (mapped != NULL && decode_words(mapped, size, true, out)) {
+      return true;
+    }
+    void *data = mapped == NULL ? asset_load_file(path, &size) : NULL;
+    bool ok = data != NULL && decode_words(data, size, false, out);
+    SDL_free(data);
+    if (ok) {
+      return true;
+    }
+    fall_back_to_text(path, sizeof(path), ".words");
+  }
+  WarmKey key = warm_cache_key(WARM_WORDS, path, 0);
+  if (read_warm_words(&key, out)) {
+    return true;
+  }
+  char *data = asset_load_file(path, &size);
   if (data == NULL) {
     return false;
   }
@@ -237,21 +546,21 @@ bool lipsync_load_words(Asset asset, WordTimings *out) {
   if (!ok) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed words sidecar: %s/%s",
                  asset.directory, asset.filename);
+  } else {
+    write_warm_words(&key, out);
   }
   return ok;
 }
 
 void lipsync_free(MouthCues *cues) {
-  free(cues->cues);
+  arena_scoped_free(cues->cues);
   cues->cues = NULL;
   cues->length = 0;
 }
 
+// The words' text shares the timings' block, or lives in a mapped pack.
 void lipsync_free_words(WordTimings *words) {
-  for (int i = 0; i < words->length; i++) {
-    free(words->words[i].word);
-  }
-  free(words->words);
+  arena_scoped_free(words->words);
   words->words = NULL;
   words->length = 0;
 }
@@ -5,6 +5,8 @@
 //  committed next to each dialogue WAV; the engine only parses and plays
 //  them. A missing sidecar simply means "no data" — the talking animation
 //  falls back to its classic loop, and the read-along highlight stays off.
+//  The text files are what gets authored and reviewed; the build compiles
+//  each into a binary twin (.bcues, .bwords) that loads without any parsing.
 //
 
 #ifndef lipsync_h
@@ -28,28 +30,35 @@ typedef enum mouth_shape {
   MOUTH_SHAPE_COUNT, // 7
 } MouthShape;
 
+// Most cues and words one sidecar may hold. Storage is sized to the file, so
+// these only bound a runaway one (and subtitle.c's per-line word arrays).
 #define LIPSYNC_MAX_CUES 512
 #define LIPSYNC_MAX_WORDS 64
 
+// Bumped whenever a binary twin's layout changes, with tools/gen_lipsync.py's
+// BINARY_VERSION; older twins are then ignored (the text loads) until rebuilt.
+#define LIPSYNC_BINARY_VERSION 1
+
 typedef struct mouth_cue {
   Uint32 at_ms; // the shape holds from here until the next cue
   Uint8 shape;  // a MouthShape
 } MouthCue;
 
 typedef struct mouth_cues {
-  MouthCue *cues;
-  int length; // 0 = no cues (legacy talking loop)
+  MouthCue *cues; // exactly `length` of them
+  int length;     // 0 = no cues (legacy talking loop)
 } MouthCues;
 
 typedef struct word_timing {
   Uint32 start_ms;
   Uint32 end_ms;
-  char *word;
+  const char *word;
 } WordTiming;
 
 typedef struct word_timings {
-  WordTiming *words;
-  int length; // 0 = no timings (no read-along highlight)
+  WordTiming *words; // exactly `length`, followed in the block by their text
+                     // (unless it was read in place from a mapped pack)
+  int length;        // 0 = no timings (no read-along highlight)
 } WordTimings;
 
 // Strict parsers (see SPEECH.md for the formats): any malformed input logs an
@@ -58,8 +67,17 @@ typedef struct word_timings {
 bool lipsync_parse(const char *data, size_t size, MouthCues *out);
 bool lipsync_parse_words(const char *data, size_t size, WordTimings *out);
 
-// Load a sidecar resolved through the asset layer. An absent file is normal
-// (returns false silently with an empty result); a malformed one logs.
+// The same for the binary twins tools/gen_lipsync.py compiles from the text
+// (layouts in SPEECH.md): no lines or numbers to scan, only deltas to add up.
+// Malformed or unknown-version input returns false with an empty result,
+// without logging (the loaders fall back to the text sidecar). The words'
+// text is copied out of `data`.
+bool lipsync_decode(const void *data, size_t size, MouthCues *out);
+bool lipsync_decode_words(const void *data, size_t size, WordTimings *out);
+
+// Load a sidecar resolved through the asset layer, from its binary twin when
+// one sits beside it (asset_prefer_fast). An absent file is normal (returns
+// false silently with an empty result); a malformed one logs.
 bool lipsync_load(Asset asset, MouthCues *out);
 bool lipsync_load_words(Asset asset, WordTimings *out);
 
@@ -0,0 +1,164 @@
+//
+//  lz4.c
+//  LZ4 block compression (see lz4.h), after the block format specification.
+//
+
+#include "lz4.h"
+
+#define LZ4_MIN_MATCH 4
+// The format's end-of-block rules: the last five bytes are always literals,
+// and no match starts within the last twelve.
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MATCH_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+// 4096 slots of recent positions: 16 KB of stack, small enough for a decode
+// worker's.
+#define LZ4_HASH_LOG 12
+
+static Uint32 read32(const Uint8 *p) {
+  Uint32 value;
+  SDL_memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static Uint32 hash4(Uint32 sequence) {
+  return (sequence * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+// A length past the token's nibble: runs of 255, then the rest.
+static Uint8 *put_length(Uint8 *out, size_t length) {
+  for (; length >= 255; length -= 255) {
+    *out++ = 255;
+  }
+  *out++ = (Uint8)length;
+  return out;
+}
+
+// One sequence: the literals from `anchor`, then (when `match_length` isn't
+// 0) a match `offset` bytes back.
+static Uint8 *put_sequence(Uint8 *out, const Uint8 *anchor, size_t literals,
+                           size_t offset, size_t match_length) {
+  Uint8 *token = out++;
+  *token = (Uint8)((literals < 15 ? literals : 15) << 4);
+  if (literals >= 15) {
+    out = put_length(out, literals - 15);
+  }
+  SDL_memcpy(out, anchor, literals);
+  out += literals;
+  if (match_length == 0) {
+    return out;
+  }
+  *out++ = (Uint8)offset;
+  *out++ = (Uint8)(offset >> 8);
+  size_t extra = match_length - LZ4_MIN_MATCH;
+  *token |= (Uint8)(extra < 15 ? extra : 15);
+  if (extra >= 15) {
+    out = put_length(out, extra - 15);
+  }
+  return out;
+}
+
+size_t lz4_compress_bound(size_t size) { return size + size / 255 + 16; }
+
+size_t lz4_compress(const void *data, size_t size, void *out, size_t capacity) {
+  if (capacity < lz4_compress_bound(size)) {
+    return 0;
+  }
+  const Uint8 *in = data;
+  const Uint8 *at = in;
+  const Uint8 *anchor = in;
+  Uint8 *op = out;
+  if (size > LZ4_MATCH_LIMIT) {
+    // Each slot is the last position whose first four bytes hashed there;
+    // a stale or colliding one fails the compare and costs a byte.
+    Uint32 recent[1 << LZ4_HASH_LOG] = {0};
+    const Uint8 *match_limit = in + size - LZ4_MATCH_LIMIT;
+    const Uint8 *end_limit = in + size - LZ4_LAST_LITERALS;
+    while (at < match_limit) {
+      Uint32 sequence = read32(at);
+      Uint32 slot = hash4(sequence);
+      const Uint8 *ref = in + recent[slot];
+      recent[slot] = (Uint32)(at - in);
+      if (ref >= at || at - ref > LZ4_MAX_OFFSET || read32(ref) != sequence) {
+        at++;
+        continue;
+      }
+      while (at > anchor && ref > in && at[-1] == ref[-1]) {
+        at--;
+        ref--;
+      }
+      const Uint8 *end = at + LZ4_MIN_MATCH;
+      const Uint8 *from = ref + LZ4_MIN_MATCH;
+      while (end < end_limit && *end == *from) {
+        end++;
+        from++;
+      }
+      op = put_sequence(op, anchor, (size_t)(at - anchor), (size_t)(at - ref),
+                        (size_t)(end - at));
+      at = end;
+      anchor = at;
+    }
+  }
+  op = put_sequence(op, anchor, (size_t)(in + size - anchor), 0, 0);
+  return (size_t)(op - (Uint8 *)out);
+}
+
+// A length past the token's nibble; false if the block ends mid-length.
+static bool read_length(const Uint8 **at, const Uint8 *end, size_t *length) {
+  Uint8 byte;
+  do {
+    if (*at >= end) {
+      return false;
+    }
+    byte = *(*at)++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+bool lz4_decompress(const void *data, size_t size, void *out, size_t out_size) {
+  const Uint8 *at = data;
+  const Uint8 *end = at + size;
+  Uint8 *op = out;
+  Uint8 *op_end = op + out_size;
+  while (at < end) {
+    Uint8 token = *at++;
+    size_t literals = token >> 4;
+    if ((literals == 15 && !read_length(&at, end, &literals)) ||
+        literals > (size_t)(end - at) || literals > (size_t)(op_end - op)) {
+      return false;
+    }
+    SDL_memcpy(op, at, literals);
+    op += literals;
+    at += literals;
+    if (at == end) {
+      break; // the last sequence has no match
+    }
+    if (end - at < 2) {
+      return false;
+    }
+    size_t offset = (size_t)at[0] | (size_t)at[1] << 8;
+    at += 2;
+    size_t length = token & 15;
+    if (offset == 0 || offset > (size_t)(op - (Uint8 *)out) ||
+        (length == 15 && !read_length(&at, end, &length))) {
+      return false;
+    }
+    length += LZ4_MIN_MATCH;
+    if (length > (size_t)(op_end - op)) {
+      return false;
+    }
+    const Uint8 *ref = op - offset;
+    if (offset >= length) {
+      SDL_memcpy(op, ref, length);
+      op += length;
+    } else {
+      // Overlapping: a short offset repeats the bytes just written (a run of
+      // one transparent pixel is offset 4).
+      while (length-- > 0) {
+        *op++ = *ref++;
+      }
+    }
+  }
+  return op == op_end;
+}
@@ -0,0 +1,32 @@
+//
+//  lz4.h
+//  LZ4 block compression (https://github.com/lz4/lz4, doc/lz4_Block_format.md)
+//  for the warm-start cache (warm_cache.h). Decompression is a loop of
+//  copies, several times faster than reading the same bytes off a disk, so an
+//  entry costs less compressed than raw; that, not the ratio, is why LZ4. A
+//  greedy single-pass compressor and a bounds-checked decompressor, nothing
+//  more: the frame format, dictionaries and the high-compression modes are
+//  left out.
+//
+
+#ifndef lz4_h
+#define lz4_h
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// The most lz4_compress can write for `size` bytes (incompressible input
+// grows a little).
+size_t lz4_compress_bound(size_t size);
+
+// Compress `size` bytes into `out`, which must hold lz4_compress_bound(size)
+// bytes. The compressed size, or 0 if `capacity` is short.
+size_t lz4_compress(const void *data, size_t size, void *out, size_t capacity);
+
+// Decompress a block into exactly `out_size` bytes. False, with `out` partly
+// written, for anything malformed or truncated, or a block that doesn't fill
+// `out` exactly.
+bool lz4_decompress(const void *data, size_t size, void *out, size_t out_size);
+
+#endif /* lz4_h */
@@ -12,8 +12,11 @@
 #include "hub.h"
 #include "image.h"
 #include "locale.h"
+#include "profile.h"
 #include "subtitle.h"
+#include "trace.h"
 #include "vania_fox_the_slide.h"
+#include "warm_cache.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -135,10 +138,15 @@ void render(void) {
   SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
   SDL_RenderClear(renderer);
 
+  profile_begin(PROFILE_RENDER);
   game_render(renderer);
+  profile_end(PROFILE_RENDER);
 
-  // Update screen
+  // Update screen. Timed apart from the render: with vsync on, this is where
+  // a frame waits, not where it works.
+  profile_begin(PROFILE_PRESENT);
   SDL_RenderPresent(renderer);
+  profile_end(PROFILE_PRESENT);
 }
 
 // Function to destroy SDL window and renderer
@@ -157,9 +165,14 @@ void destroy_sound(void) {
 
 // One iteration of the game loop, shared by the native and web entry points.
 static void main_loop(void) {
+  profile_begin(PROFILE_INPUT);
   process_input();
+  profile_end(PROFILE_INPUT);
+  profile_begin(PROFILE_UPDATE);
   update();
+  profile_end(PROFILE_UPDATE);
   render();
+  profile_end_frame();
 #ifdef __EMSCRIPTEN__
   if (!game.is_running) {
     emscripten_cancel_main_loop();
@@ -169,6 +182,8 @@ static void main_loop(void) {
 
 // Main function
 int SDL_main(int argc, char *argv[]) {
+  // First thing, so the trace covers window creation and every load.
+  TRACE_INIT();
   game.is_running = init_window();
   if (!game.is_running) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize window!");
@@ -178,6 +193,14 @@ int SDL_main(int argc, char *argv[]) {
   // the active locale).
   asset_set_locale(detect_locale(argc, argv));
 
+#ifndef __EMSCRIPTEN__
+  // What loading makes of the assets persists between launches of this build
+  // (warm_cache.h). Not on the web, whose pref dir lives in memory.
+  char *pref_path = SDL_GetPrefPath("curlybrackets", "tinyadventures");
+  warm_cache_set_dir(pref_path);
+  SDL_free(pref_path);
+#endif
+
   // Dialogue text overlay (SPEECH.md): reads --subtitles=/$VANIA_SUBTITLES and
   // loads the bundled font. A failure logs and disables subtitles, no more.
   subtitle_init(argc, argv, renderer);
@@ -198,9 +221,10 @@ int SDL_main(int argc, char *argv[]) {
   hub_register(content, LEN(content));
 
   // Register the hub first (it is the start screen and the back-to-hub target),
-  // then the content adventures. All of them are initialized and loaded up
-  // front. Both arrays stay static because hub_register/register_adventures
-  // retain the pointers for the whole run.
+  // then the content adventures. All of them are initialized up front; only
+  // the hub's media loads before the first frame, and the rest streams in
+  // behind it (game.h). Both arrays stay static because
+  // hub_register/register_adventures retain the pointers for the whole run.
   static const Adventure *all[1 + LEN(content)];
   all[0] = &hub;
   for (int i = 0; i < (int)LEN(content); i++) {
@@ -242,6 +266,7 @@ int SDL_main(int argc, char *argv[]) {
   destroy_sound();
   destroy_image();
   destroy_window();
+  TRACE_SHUTDOWN();
 #endif
 
   return 0;
@@ -12,7 +12,9 @@
 #include "hub.h"
 #include "image.h"
 #include "locale.h"
+#include "profile.h"
 #include "subtitle.h"
+#include "trace.h"
 #include "terminal.h"
 #include "vania_fox_the_slide.h"
 
@@ -120,11 +122,15 @@ static void render(void) {
   SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
   SDL_RenderClear(renderer);
 
+  profile_begin(PROFILE_RENDER);
   game_render(renderer);
+  profile_end(PROFILE_RENDER);
 
   // Read back pixels and push to the terminal via libcaca instead of
   // presenting to a real window.
+  profile_begin(PROFILE_PRESENT);
   terminal_present(renderer);
+  profile_end(PROFILE_PRESENT);
 }
 
 static void destroy_window(void) {
@@ -142,6 +148,7 @@ static void destroy_sound(void) {
 }
 
 int main(int argc, char *argv[]) {
+  TRACE_INIT();
   game.is_running = init_window();
   if (!game.is_running) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
@@ -188,6 +195,7 @@ int main(int argc, char *argv[]) {
   }
   if (!game.is_running) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load media!");
+    TRACE_SHUTDOWN();
     return 1;
   }
 
@@ -195,9 +203,14 @@ int main(int argc, char *argv[]) {
 
   last_frame_time = SDL_GetTicks();
   while (game.is_running) {
+    profile_begin(PROFILE_INPUT);
     process_input();
+    profile_end(PROFILE_INPUT);
+    profile_begin(PROFILE_UPDATE);
     update();
+    profile_end(PROFILE_UPDATE);
     render();
+    profile_end_frame();
   }
 
   game_deinit();
@@ -209,6 +222,7 @@ int main(int argc, char *argv[]) {
   destroy_sound();
   destroy_image();
   destroy_window();
+  TRACE_SHUTDOWN();
 
   return 0;
 }
@@ -0,0 +1,611 @@
+//
+//  pack.c
+//  Packed asset archives (see pack.h).
+//
+
+// mmap, opendir and friends are POSIX; -std=c99 hides them from glibc's and
+// musl's headers.
+#if (defined(__linux__) || defined(__EMSCRIPTEN__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "asset.h"
+#include "pack.h"
+
+// Map packs where they are plain files. An Android pack sits inside the APK,
+// which only SDL_RWops can read.
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(__ANDROID__) &&     \
+    !defined(__EMSCRIPTEN__)
+#define PACK_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// List loose roots where the tree can be walked. Android's APK assets can't
+// be listed through SDL (and ship packed), and iOS bundles assets flat.
+#if (defined(__linux__) || defined(__APPLE__) || defined(__EMSCRIPTEN__)) &&  \
+    !defined(__ANDROID__) && !defined(__IPHONEOS__) && !defined(__TVOS__)
+#define PACK_LIST 1
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#define HEADER_SIZE 16
+#define ENTRY_SIZE 16
+
+typedef struct pack {
+  const char *root;
+  size_t root_length;
+  bool present; // false: the root has no pack, so its files are loose
+  // A loose root's listing, kept in a pack's index format minus the blobs
+  // (offsets and sizes are 0), so one lookup serves both.
+  bool listed;
+  Uint32 count;
+  const Uint8 *entries;
+  const char *strings;
+  // Mapped: the whole file. Otherwise NULL, and blobs are read from `file`
+  // under `lock`, the index having been read into `index` (where a listing
+  // is kept too).
+  const Uint8 *mapped;
+  size_t mapped_size;
+  Uint8 *index;
+  SDL_RWops *file;
+  SDL_mutex *lock;
+  Sint64 time; // the pack file's modification time when mapped, else 0
+} Pack;
+
+// Filled in order and never changed after: `mounted` is bumped only once an
+// entry is complete, so readers walk the first `mounted` entries lock-free.
+// A mount opens its pack or lists its tree with no lock held, then takes the
+// spin lock only to claim a slot and copy the finished entry in.
+static Pack mounts[PACK_MAX_MOUNTS];
+static SDL_atomic_t mounted;
+static SDL_SpinLock mount_lock = 0;
+
+// Directories never shipped, so never listed (as tools/gen_pack.py skips).
+static const char *const unshipped_dirs[] = {"_inbox", "_sources"};
+
+static Uint32 read_le32(const Uint8 *p) {
+  return (Uint32)p[0] | (Uint32)p[1] << 8 | (Uint32)p[2] << 16 |
+         (Uint32)p[3] << 24;
+}
+
+#ifdef PACK_LIST
+static void put_le32(Uint8 *p, Uint32 v) {
+  p[0] = (Uint8)v;
+  p[1] = (Uint8)(v >> 8);
+  p[2] = (Uint8)(v >> 16);
+  p[3] = (Uint8)(v >> 24);
+}
+#endif
+
+Uint32 pack_hash(const char *name) {
+  Uint32 hash = 2166136261U;
+  for (const Uint8 *p = (const Uint8 *)name; *p != '\0'; p++) {
+    hash = (hash ^ *p) * 16777619U;
+  }
+  return hash;
+}
+
+// Check a header and index against the file's size: every name inside the
+// strings, every blob inside the file. `index` holds at least the header, the
+// entries and the strings.
+static bool index_valid(const Uint8 *index, Uint64 index_size,
+                        Uint64 file_size) {
+  if (index_size < HEADER_SIZE ||
+      SDL_memcmp(index, PACK_MAGIC, 4) != 0 ||
+      read_le32(index + 4) != PACK_VERSION) {
+    return false;
+  }
+  Uint64 count = read_le32(index + 8);
+  Uint64 strings_size = read_le32(index + 12);
+  Uint64 strings_at = HEADER_SIZE + count * ENTRY_SIZE;
+  if (strings_at + strings_size > index_size ||
+      (strings_size > 0 && index[strings_at + strings_size - 1] != '\0')) {
+    return false;
+  }
+  for (Uint64 i = 0; i < count; i++) {
+    const Uint8 *entry = index + HEADER_SIZE + i * ENTRY_SIZE;
+    if (read_le32(entry + 4) >= strings_size ||
+        (Uint64)read_le32(entry + 8) + read_le32(entry + 12) > file_size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void use_index(Pack *pack, const Uint8 *index) {
+  pack->count = read_le32(index + 8);
+  pack->entries = index + HEADER_SIZE;
+  pack->strings =
+      (const char *)(pack->entries + (size_t)pack->count * ENTRY_SIZE);
+}
+
+#ifdef PACK_MMAP
+static bool open_mapped(Pack *pack, const char *path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  void *mapped = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    mapped = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // The mapping keeps the file alive; the descriptor isn't needed.
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+  size_t size = (size_t)info.st_size;
+  if (!index_valid(mapped, size, size)) {
+    // Left to open_buffered to reject (and report).
+    munmap(mapped, size);
+    return false;
+  }
+  pack->mapped = mapped;
+  pack->mapped_size = size;
+  pack->time = (Sint64)info.st_mtime;
+  use_index(pack, pack->mapped);
+  return true;
+}
+#endif
+
+static bool open_buffered(Pack *pack, const char *path) {
+  SDL_RWops *file = SDL_RWFromFile(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+  Uint8 header[HEADER_SIZE];
+  Sint64 file_size = SDL_RWsize(file);
+  Uint8 *index = NULL;
+  bool ok = SDL_RWread(file, header, 1, sizeof(header)) == sizeof(header);
+  if (ok) {
+    Uint64 index_size = HEADER_SIZE +
+                        (Uint64)read_le32(header + 8) * ENTRY_SIZE +
+                        read_le32(header + 12);
+    ok = file_size > 0 && index_size <= (Uint64)file_size &&
+         (index = SDL_malloc((size_t)index_size)) != NULL;
+    if (ok) {
+      SDL_memcpy(index, header, sizeof(header));
+      size_t rest = (size_t)index_size - HEADER_SIZE;
+      ok = SDL_RWread(file, index + HEADER_SIZE, 1, rest) == rest &&
+           index_valid(index, index_size, (Uint64)file_size);
+    }
+  }
+  if (ok && (pack->lock = SDL_CreateMutex()) == NULL) {
+    ok = false;
+  }
+  if (!ok) {
+    SDL_free(index);
+    SDL_RWclose(file);
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed pack %s", path);
+    return false;
+  }
+  pack->index = index;
+  pack->file = file;
+  use_index(pack, index);
+  return true;
+}
+
+#ifdef PACK_LIST
+// A loose root's files while it is walked: their root-relative paths, packed
+// one after another.
+typedef struct listing {
+  char *strings;
+  size_t strings_size;
+  size_t strings_capacity;
+  Uint32 count;
+} Listing;
+
+typedef struct listed_name {
+  Uint32 hash;
+  Uint32 offset;
+  const char *name;
+} ListedName;
+
+static int compare_names(const void *a, const void *b) {
+  const ListedName *x = a;
+  const ListedName *y = b;
+  if (x->hash != y->hash) {
+    return x->hash < y->hash ? -1 : 1;
+  }
+  return SDL_strcmp(x->name, y->name);
+}
+
+static bool add_name(Listing *listing, const char *name) {
+  size_t length = SDL_strlen(name) + 1;
+  if (listing->strings_size + length > listing->strings_capacity) {
+    size_t capacity = SDL_max(listing->strings_capacity * 2, 4096);
+    while (capacity < listing->strings_size + length) {
+      capacity *= 2;
+    }
+    char *grown = SDL_realloc(listing->strings, capacity);
+    if (grown == NULL) {
+      return false;
+    }
+    listing->strings = grown;
+    listing->strings_capacity = capacity;
+  }
+  SDL_memcpy(listing->strings + listing->strings_size, name, length);
+  listing->strings_size += length;
+  listing->count++;
+  return true;
+}
+
+static bool shipped(const char *name) {
+  if (name[0] == '.') {
+    return false; // ".", ".." and hidden files
+  }
+  for (int i = 0; i < (int)SDL_arraysize(unshipped_dirs); i++) {
+    if (SDL_strcmp(name, unshipped_dirs[i]) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Walk the directory `path` (`length` bytes of an ASSET_PATH_MAX buffer),
+// adding every file under it by its path past the root's `root_length` bytes.
+static bool list_tree(Listing *listing, char *path, size_t length,
+                      size_t root_length) {
+  DIR *dir = opendir(path);
+  if (dir == NULL) {
+    return false;
+  }
+  bool ok = true;
+  struct dirent *entry;
+  while (ok && (entry = readdir(dir)) != NULL) {
+    if (!shipped(entry->d_name)) {
+      continue;
+    }
+    int written = snprintf(path + length, ASSET_PATH_MAX - length, "/%s",
+                           entry->d_name);
+    if (written < 0 || (size_t)written >= ASSET_PATH_MAX - length) {
+      continue; // too long for any asset path to name
+    }
+    struct stat info;
+    if (stat(path, &info) != 0) {
+      continue;
+    }
+    if (S_ISDIR(info.st_mode)) {
+      list_tree(listing, path, length + (size_t)written, root_length);
+    } else if (S_ISREG(info.st_mode)) {
+      ok = add_name(listing, path + root_length + 1);
+    }
+  }
+  path[length] = '\0';
+  closedir(dir);
+  return ok;
+}
+
+// Index a loose root: its files, sorted into a pack's directory order.
+static bool open_listing(Pack *pack, const char *root) {
+  char path[ASSET_PATH_MAX];
+  Listing listing = {0};
+  if (SDL_strlcpy(path, root, sizeof(path)) >= sizeof(path) ||
+      !list_tree(&listing, path, SDL_strlen(path), SDL_strlen(path))) {
+    SDL_free(listing.strings);
+    return false;
+  }
+  size_t strings_at = HEADER_SIZE + (size_t)listing.count * ENTRY_SIZE;
+  Uint8 *index = SDL_calloc(1, strings_at + listing.strings_size);
+  ListedName *names = SDL_malloc(sizeof(*names) * (listing.count + 1));
+  if (index == NULL || names == NULL) {
+    SDL_free(index);
+    SDL_free(names);
+    SDL_free(listing.strings);
+    return false;
+  }
+  SDL_memcpy(index + strings_at, listing.strings, listing.strings_size);
+  const char *strings = (const char *)index + strings_at;
+  Uint32 offset = 0;
+  for (Uint32 i = 0; i < listing.count; i++) {
+    names[i] = (ListedName){pack_hash(strings + offset), offset,
+                            strings + offset};
+    offset += (Uint32)SDL_strlen(strings + offset) + 1;
+  }
+  qsort(names, listing.count, sizeof(*names), compare_names);
+  SDL_memcpy(index, PACK_MAGIC, 4);
+  put_le32(index + 4, PACK_VERSION);
+  put_le32(index + 8, listing.count);
+  put_le32(index + 12, (Uint32)listing.strings_size);
+  for (Uint32 i = 0; i < listing.count; i++) {
+    Uint8 *entry = index + HEADER_SIZE + (size_t)i * ENTRY_SIZE;
+    put_le32(entry, names[i].hash);
+    put_le32(entry + 4, names[i].offset);
+  }
+  SDL_free(names);
+  SDL_free(listing.strings);
+  pack->index = index;
+  use_index(pack, index);
+  return true;
+}
+#endif
+
+// Give back what opening a root took: a mount that lost the race to publish
+// the same root.
+static void close_pack(Pack *pack) {
+#ifdef PACK_MMAP
+  if (pack->mapped != NULL) {
+    munmap((void *)pack->mapped, pack->mapped_size);
+  }
+#endif
+  SDL_free(pack->index);
+  if (pack->file != NULL) {
+    SDL_RWclose(pack->file);
+  }
+  if (pack->lock != NULL) {
+    SDL_DestroyMutex(pack->lock);
+  }
+}
+
+// The published mount of `root` among the first `count`, or NULL.
+static const Pack *mounted_root(const char *root, int count) {
+  for (int i = 0; i < count; i++) {
+    if (SDL_strcmp(mounts[i].root, root) == 0) {
+      return &mounts[i];
+    }
+  }
+  return NULL;
+}
+
+bool pack_mount(const char *root) {
+  if (root == NULL) {
+    return false;
+  }
+  const Pack *existing = mounted_root(root, SDL_AtomicGet(&mounted));
+  if (existing != NULL) {
+    return existing->present;
+  }
+  Pack opened = {.root = root, .root_length = SDL_strlen(root)};
+  char path[ASSET_PATH_MAX];
+  if (SDL_getenv("VANIA_NO_PACKS") == NULL &&
+      snprintf(path, sizeof(path), "%s.pack", root) < (int)sizeof(path)) {
+#ifdef PACK_MMAP
+    opened.present = open_mapped(&opened, path) || open_buffered(&opened, path);
+#else
+    opened.present = open_buffered(&opened, path);
+#endif
+  }
+#ifdef PACK_LIST
+  if (!opened.present) {
+    opened.listed = open_listing(&opened, root);
+  }
+#endif
+
+  SDL_AtomicLock(&mount_lock);
+  int count = SDL_AtomicGet(&mounted);
+  existing = mounted_root(root, count);
+  Pack *pack = existing == NULL && count < PACK_MAX_MOUNTS ? &mounts[count]
+                                                           : NULL;
+  if (pack != NULL) {
+    *pack = opened;
+    SDL_AtomicSet(&mounted, count + 1);
+  }
+  SDL_AtomicUnlock(&mount_lock);
+  if (existing != NULL) {
+    close_pack(&opened); // another thread mounted it meanwhile
+    return existing->present;
+  }
+  if (pack == NULL) {
+    close_pack(&opened);
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Too many asset roots to mount %s", root);
+    return false;
+  }
+  if (pack->present) {
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "Reading %s from %s.pack (%u files)", root, root,
+                (unsigned)pack->count);
+  } else if (pack->listed) {
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Indexed %s (%u files)", root,
+                (unsigned)pack->count);
+  }
+  return pack->present;
+}
+
+// The mount whose root `path` lies under, and the path relative to it; the
+// longest root wins, should one root nest in another.
+static const Pack *find_mount(const char *path, const char **name) {
+  const Pack *found = NULL;
+  int count = SDL_AtomicGet(&mounted);
+  for (int i = 0; i < count; i++) {
+    const Pack *pack = &mounts[i];
+    if ((found == NULL || pack->root_length > found->root_length) &&
+        SDL_strncmp(path, pack->root, pack->root_length) == 0 &&
+        path[pack->root_length] == '/') {
+      found = pack;
+    }
+  }
+  if (found != NULL) {
+    *name = path + found->root_length + 1;
+  }
+  return found;
+}
+
+// A file's directory entry: a binary search for the first entry with its
+// hash, then a scan of the (rarely more than one) entries sharing it.
+static const Uint8 *find_entry(const Pack *pack, const char *name) {
+  Uint32 hash = pack_hash(name);
+  Uint32 low = 0;
+  Uint32 high = pack->count;
+  while (low < high) {
+    Uint32 middle = low + (high - low) / 2;
+    if (read_le32(pack->entries + (size_t)middle * ENTRY_SIZE) < hash) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  for (; low < pack->count; low++) {
+    const Uint8 *entry = pack->entries + (size_t)low * ENTRY_SIZE;
+    if (read_le32(entry) != hash) {
+      break;
+    }
+    if (SDL_strcmp(pack->strings + read_le32(entry + 4), name) == 0) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+static const Uint8 *lookup(const char *path, const Pack **pack) {
+  const char *name = NULL;
+  *pack = find_mount(path, &name);
+  if (*pack == NULL || !((*pack)->present || (*pack)->listed)) {
+    return NULL;
+  }
+  return find_entry(*pack, name);
+}
+
+bool pack_covers(const char *path) {
+  const char *name = NULL;
+  const Pack *pack = find_mount(path, &name);
+  return pack != NULL && (pack->present || pack->listed);
+}
+
+bool pack_contains(const char *path) {
+  const Pack *pack = NULL;
+  return lookup(path, &pack) != NULL;
+}
+
+const void *pack_map(const char *path, size_t *size) {
+  const Pack *pack = NULL;
+  const Uint8 *entry = lookup(path, &pack);
+  if (entry == NULL || pack->mapped == NULL) {
+    return NULL;
+  }
+  *size = read_le32(entry + 12);
+  return pack->mapped + read_le32(entry + 8);
+}
+
+bool pack_locate(const char *path, Uint64 *offset, Uint64 *size,
+                 Sint64 *time) {
+  const Pack *pack = NULL;
+  const Uint8 *entry = lookup(path, &pack);
+  if (entry == NULL || !pack->present) {
+    return false;
+  }
+  *offset = read_le32(entry + 8);
+  *size = read_le32(entry + 12);
+  *time = pack->time;
+  return true;
+}
+
+// ── a read-only SDL_RWops over one blob ─────────────────────────────────────
+
+typedef struct blob {
+  const Uint8 *data;
+  Sint64 size;
+  Sint64 at;
+  void *owned; // freed on close: a blob read out of a buffered pack
+} Blob;
+
+static Sint64 blob_size(SDL_RWops *rw) {
+  return ((Blob *)rw->hidden.unknown.data1)->size;
+}
+
+static Sint64 blob_seek(SDL_RWops *rw, Sint64 offset, int whence) {
+  Blob *blob = rw->hidden.unknown.data1;
+  Sint64 base = whence == RW_SEEK_SET   ? 0
+                : whence == RW_SEEK_CUR ? blob->at
+                                        : blob->size;
+  Sint64 at = base + offset;
+  if (at < 0 || at > blob->size) {
+    return SDL_SetError("Seek outside a packed file");
+  }
+  blob->at = at;
+  return at;
+}
+
+static size_t blob_read(SDL_RWops *rw, void *out, size_t size, size_t count) {
+  Blob *blob = rw->hidden.unknown.data1;
+  if (size == 0) {
+    return 0;
+  }
+  size_t whole = (size_t)(blob->size - blob->at) / size;
+  if (count > whole) {
+    count = whole;
+  }
+  SDL_memcpy(out, blob->data + blob->at, count * size);
+  blob->at += (Sint64)(count * size);
+  return count;
+}
+
+static size_t blob_write(SDL_RWops *rw, const void *data, size_t size,
+                         size_t count) {
+  SDL_SetError("Packed files are read-only");
+  return 0;
+}
+
+static int blob_close(SDL_RWops *rw) {
+  Blob *blob = rw->hidden.unknown.data1;
+  SDL_free(blob->owned);
+  SDL_free(blob);
+  SDL_FreeRW(rw);
+  return 0;
+}
+
+static SDL_RWops *open_blob(const Uint8 *data, Uint32 size, void *owned) {
+  Blob *blob = SDL_malloc(sizeof(*blob));
+  SDL_RWops *rw = blob != NULL ? SDL_AllocRW() : NULL;
+  if (rw == NULL) {
+    SDL_free(blob);
+    SDL_free(owned);
+    return NULL;
+  }
+  *blob = (Blob){.data = data, .size = size, .owned = owned};
+  rw->size = blob_size;
+  rw->seek = blob_seek;
+  rw->read = blob_read;
+  rw->write = blob_write;
+  rw->close = blob_close;
+  rw->type = SDL_RWOPS_UNKNOWN;
+  rw->hidden.unknown.data1 = blob;
+  return rw;
+}
+
+// A buffered pack's blob, read into memory of its own. One reader at a time:
+// the pack has a single file position.
+static Uint8 *read_blob(const Pack *pack, Uint32 offset, Uint32 size) {
+  Uint8 *data = SDL_malloc(size > 0 ? size : 1);
+  if (data == NULL) {
+    return NULL;
+  }
+  SDL_LockMutex(pack->lock);
+  bool ok = SDL_RWseek(pack->file, offset, RW_SEEK_SET) == offset &&
+            SDL_RWread(pack->file, data, 1, size) == size;
+  SDL_UnlockMutex(pack->lock);
+  if (!ok) {
+    SDL_free(data);
+    SDL_SetError("Short read from the %s pack", pack->root);
+    return NULL;
+  }
+  return data;
+}
+
+SDL_RWops *pack_open(const char *path) {
+  const Pack *pack = NULL;
+  const Uint8 *entry = lookup(path, &pack);
+  if (entry == NULL) {
+    SDL_SetError("No such asset: %s", path);
+    return NULL;
+  }
+  if (!pack->present) {
+    return SDL_RWFromFile(path, "rb"); // listed: the file is loose
+  }
+  Uint32 offset = read_le32(entry + 8);
+  Uint32 size = read_le32(entry + 12);
+  if (pack->mapped != NULL) {
+    return open_blob(pack->mapped + offset, size, NULL);
+  }
+  Uint8 *data = read_blob(pack, offset, size);
+  return data != NULL ? open_blob(data, size, data) : NULL;
+}
@@ -0,0 +1,79 @@
+//
+//  pack.h
+//  Packed asset archives. tools/gen_pack.py folds an asset root (an
+//  adventure's assets/ directory, or the engine's) into one <root>.pack beside
+//  it: a sorted, hashed directory of the root's files — every locale layer and
+//  common/, under their root-relative paths — followed by their contents, each
+//  aligned to 16 bytes. Once a root's pack is mounted, asset lookups and the
+//  loaders read from it instead of opening hundreds of loose files.
+//
+//  Format (little-endian):
+//    "VPAK", u32 version, u32 count, u32 strings_size
+//    count entries of {u32 hash, u32 name, u32 offset, u32 size}, sorted by
+//      hash then name; hash is FNV-1a (32-bit) of the root-relative path,
+//      name an offset into the strings, offset/size the blob in the file
+//    strings_size bytes of NUL-terminated root-relative paths
+//    the blobs
+//
+//  Desktop builds map the pack into memory, so opening a file is a binary
+//  search and a pointer. Elsewhere (Android's APK assets, the web) the index
+//  is read into memory and each open reads its blob from the one open pack.
+//
+//  A root without a pack is listed instead, where its tree can be walked
+//  (desktop and the web): its files go into a directory of the same format
+//  with no blobs, so whether a file exists is still a lookup in memory rather
+//  than an open() per probe. The listing is a snapshot: a file written into
+//  the root afterwards (the walk-mask editor's save) shows up next launch.
+//
+
+#ifndef pack_h
+#define pack_h
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PACK_MAGIC "VPAK"
+#define PACK_VERSION 1
+
+// Asset roots that can be mounted at once (each adventure's, and the
+// engine's), packed or not.
+#define PACK_MAX_MOUNTS 8
+
+// Mount the pack for an asset root ("<root>.pack"), or list the root when it
+// has none. Safe to call again for the same root (it is a lookup then) and
+// from any thread; each root is probed and listed once. The root string is
+// stored, not copied (roots are string literals). True if a pack backs the
+// root. Setting VANIA_NO_PACKS in the environment ignores every pack — for
+// editing assets without rebuilding them.
+bool pack_mount(const char *root);
+
+// Whether the root `path` lives under is mounted with a directory — packed or
+// listed. The directory holds every file of its root, so for such a path
+// pack_contains is the whole answer and the disk need not be asked.
+bool pack_covers(const char *path);
+
+// Whether a mounted root's directory holds the file at `path` (a
+// repo-relative path, "<root>/<layer>/<dir>/<file>").
+bool pack_contains(const char *path);
+
+// Open the file at `path` read-only, from its pack or, for a listed root, from
+// disk; NULL (with SDL_GetError set) if its root's directory doesn't hold it.
+// Close it with SDL_RWclose.
+SDL_RWops *pack_open(const char *path);
+
+// The file's bytes in place, when its pack is mapped into memory: no copy, and
+// valid for the life of the process. NULL when it isn't in a mapped pack.
+const void *pack_map(const char *path, size_t *size);
+
+// Where a packed file's bytes lie: its blob's offset and size in the pack, and
+// the pack's modification time where it was mapped from a plain file (0 for
+// one in an APK, or on the web). False for a file no pack holds (a listed
+// root's loose files included).
+bool pack_locate(const char *path, Uint64 *offset, Uint64 *size,
+                 Sint64 *time);
+
+// FNV-1a, 32-bit: the directory's hash of a root-relative path.
+Uint32 pack_hash(const char *name);
+
+#endif /* pack_h */
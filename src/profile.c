@@ -0,0 +1,114 @@
+//
+//  profile.c
+//  Frame-phase profiler (see profile.h).
+//
+
+#include <stdlib.h>
+
+#include "constants.h"
+#include "profile.h"
+#include "trace.h"
+
+static const char *const phase_names[PROFILE_PHASE_COUNT] = {
+    [PROFILE_INPUT] = "input",
+    [PROFILE_UPDATE] = "update",
+    [PROFILE_RENDER] = "render",
+    [PROFILE_PRESENT] = "present",
+    [PROFILE_ANIMATIONS] = "animations",
+    [PROFILE_SCENE_UPDATE] = "scene update",
+    [PROFILE_CAMERA] = "camera",
+    [PROFILE_PLANES] = "planes",
+    [PROFILE_SPRITES] = "sprites",
+    [PROFILE_ACTION_LAYER] = "action layer",
+    [PROFILE_SUBTITLES] = "subtitles",
+};
+
+static ProfileFrame ring[PROFILE_FRAMES];
+static int ring_next = 0;
+static int ring_count = 0;
+
+// The frame being timed: when each open phase began, and what has
+// accumulated so far.
+static Uint64 phase_started[PROFILE_PHASE_COUNT];
+static ProfileFrame current;
+static Uint64 frame_started = 0;
+
+static float elapsed_ms(Uint64 since, Uint64 now) {
+  return (float)((double)(now - since) * 1000.0 /
+                 (double)SDL_GetPerformanceFrequency());
+}
+
+// Each phase is a trace scope too, so a trace shows frames phase by phase.
+void profile_begin(ProfilePhase phase) {
+  TRACE_BEGIN(profile_phase_name(phase));
+  phase_started[phase] = SDL_GetPerformanceCounter();
+}
+
+void profile_end(ProfilePhase phase) {
+  current.phase_ms[phase] +=
+      elapsed_ms(phase_started[phase], SDL_GetPerformanceCounter());
+  TRACE_END(profile_phase_name(phase));
+}
+
+void profile_end_frame(void) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  // The first frame has no previous end; its phases are all it has.
+  if (frame_started != 0) {
+    current.total_ms = elapsed_ms(frame_started, now);
+  } else {
+    for (int i = PROFILE_INPUT; i <= PROFILE_PRESENT; i++) {
+      current.total_ms += current.phase_ms[i];
+    }
+  }
+  frame_started = now;
+  TRACE_INSTANT("frame");
+  profile_record(&current);
+  current = (ProfileFrame){0};
+}
+
+void profile_record(const ProfileFrame *frame) {
+  ring[ring_next] = *frame;
+  ring_next = (ring_next + 1) % PROFILE_FRAMES;
+  if (ring_count < PROFILE_FRAMES) {
+    ring_count++;
+  }
+}
+
+void profile_reset(void) {
+  ring_next = 0;
+  ring_count = 0;
+}
+
+int profile_frame_count(void) { return ring_count; }
+
+const ProfileFrame *profile_frame(int age) {
+  if (age < 0 || age >= ring_count) {
+    return NULL;
+  }
+  return &ring[(ring_next - 1 - age + PROFILE_FRAMES) % PROFILE_FRAMES];
+}
+
+static int compare_floats(const void *a, const void *b) {
+  float x = *(const float *)a;
+  float y = *(const float *)b;
+  return (x > y) - (x < y);
+}
+
+float profile_percentile(float p) {
+  if (ring_count == 0) {
+    return 0.0F;
+  }
+  float totals[PROFILE_FRAMES];
+  for (int i = 0; i < ring_count; i++) {
+    totals[i] = ring[i].total_ms;
+  }
+  qsort(totals, (size_t)ring_count, sizeof(totals[0]), compare_floats);
+  // Nearest rank: the smallest total at or above p percent of the frames.
+  int rank = (int)SDL_ceilf(p / 100.0F * (float)ring_count);
+  rank = SDL_max(1, SDL_min(rank, ring_count));
+  return totals[rank - 1];
+}
+
+const char *profile_phase_name(ProfilePhase phase) {
+  return phase >= 0 && phase < PROFILE_PHASE_COUNT ? phase_names[phase] : "?";
+}
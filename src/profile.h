@@ -0,0 +1,69 @@
+//
+//  profile.h
+//  Frame-phase profiler. The main loop and game_update/game_render bracket
+//  their phases with profile_begin/profile_end (SDL_GetPerformanceCounter
+//  underneath), and profile_end_frame files the frame into a ring of the last
+//  PROFILE_FRAMES. The debug overlay graphs the ring with its p50/p95/p99
+//  and logs where each janky frame's time went — on a phone, that log is
+//  the only way to tell a slow decode from a slow draw.
+//
+
+#ifndef profile_h
+#define profile_h
+
+#include <SDL2/SDL.h>
+
+typedef enum profile_phase {
+  PROFILE_INPUT,
+  PROFILE_UPDATE,
+  PROFILE_RENDER,
+  PROFILE_PRESENT,
+  // Inside PROFILE_UPDATE (game_update).
+  PROFILE_ANIMATIONS,
+  PROFILE_SCENE_UPDATE,
+  PROFILE_CAMERA,
+  // Inside PROFILE_RENDER (game_render).
+  PROFILE_PLANES,
+  PROFILE_SPRITES,
+  PROFILE_ACTION_LAYER,
+  PROFILE_SUBTITLES,
+  PROFILE_PHASE_COUNT,
+} ProfilePhase;
+
+// Frames kept: eight seconds at FPS.
+#define PROFILE_FRAMES 240
+
+typedef struct profile_frame {
+  // End of the previous frame to the end of this one: what the player felt,
+  // including any wait in present.
+  float total_ms;
+  float phase_ms[PROFILE_PHASE_COUNT];
+} ProfileFrame;
+
+// Time a phase. A phase run twice in a frame (the bg and fg planes) adds up.
+void profile_begin(ProfilePhase phase);
+void profile_end(ProfilePhase phase);
+
+// Close the frame: record its phases and total, and start the next.
+void profile_end_frame(void);
+
+// File a finished frame into the ring (profile_end_frame's second half; tests
+// feed it synthetic frames).
+void profile_record(const ProfileFrame *frame);
+
+// Drop every recorded frame.
+void profile_reset(void);
+
+// Frames in the ring, up to PROFILE_FRAMES, and one of them by age: 0 is the
+// most recent. NULL past the last.
+int profile_frame_count(void);
+const ProfileFrame *profile_frame(int age);
+
+// The p-th percentile (0-100, nearest rank) of the ring's frame totals, in ms;
+// 0 when it is empty.
+float profile_percentile(float p);
+
+// A phase's name for logs ("planes").
+const char *profile_phase_name(ProfilePhase phase);
+
+#endif /* profile_h */
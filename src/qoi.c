@@ -0,0 +1,138 @@
+//
+//  qoi.c
+//  QOI decoding (see qoi.h), after the reference specification.
+//
+
+#include <stdbool.h>
+
+#include "asset.h"
+#include "pack.h"
+#include "qoi.h"
+
+#define QOI_OP_INDEX 0x00 // 00xxxxxx
+#define QOI_OP_DIFF 0x40  // 01xxxxxx
+#define QOI_OP_LUMA 0x80  // 10xxxxxx
+#define QOI_OP_RUN 0xC0   // 11xxxxxx
+#define QOI_OP_RGB 0xFE
+#define QOI_OP_RGBA 0xFF
+#define QOI_MASK_2 0xC0
+
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING_SIZE 8 // 7 zero bytes and a 1 close the stream
+// The reference decoder's limit: keeps width * height * 4 well inside an int.
+#define QOI_PIXELS_MAX 400000000U
+
+typedef struct qoi_rgba {
+  Uint8 r, g, b, a;
+} QoiRgba;
+
+static Uint32 read_be32(const Uint8 *bytes) {
+  return ((Uint32)bytes[0] << 24) | ((Uint32)bytes[1] << 16) |
+         ((Uint32)bytes[2] << 8) | bytes[3];
+}
+
+static int color_hash(QoiRgba px) {
+  return (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+}
+
+SDL_Surface *qoi_decode(const void *data, size_t size) {
+  const Uint8 *bytes = data;
+  if (size < QOI_HEADER_SIZE + QOI_PADDING_SIZE ||
+      SDL_memcmp(bytes, "qoif", 4) != 0) {
+    SDL_SetError("Not a QOI image");
+    return NULL;
+  }
+  Uint32 width = read_be32(bytes + 4);
+  Uint32 height = read_be32(bytes + 8);
+  Uint8 channels = bytes[12];
+  if (width == 0 || height == 0 || (channels != 3 && channels != 4) ||
+      height >= QOI_PIXELS_MAX / width) {
+    SDL_SetError("Bad QOI header");
+    return NULL;
+  }
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+      0, (int)width, (int)height, 32, SDL_PIXELFORMAT_RGBA32);
+  if (surface == NULL) {
+    return NULL;
+  }
+
+  // Both the stream and the surface are walked in order; a run may carry on
+  // across the end of a row.
+  QoiRgba index[64] = {{0, 0, 0, 0}};
+  QoiRgba px = {0, 0, 0, 255};
+  size_t p = QOI_HEADER_SIZE;
+  size_t end = size - QOI_PADDING_SIZE;
+  int run = 0;
+  bool ok = true;
+  for (Uint32 y = 0; y < height && ok; y++) {
+    Uint8 *out = (Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+    for (Uint32 x = 0; x < width; x++, out += 4) {
+      if (run > 0) {
+        run--;
+      } else if (p < end) {
+        int b1 = bytes[p++];
+        if (b1 == QOI_OP_RGB || b1 == QOI_OP_RGBA) {
+          size_t need = b1 == QOI_OP_RGBA ? 4 : 3;
+          if (end - p < need) {
+            ok = false;
+            break;
+          }
+          px.r = bytes[p++];
+          px.g = bytes[p++];
+          px.b = bytes[p++];
+          if (b1 == QOI_OP_RGBA) {
+            px.a = bytes[p++];
+          }
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+          px = index[b1];
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+          px.r += ((b1 >> 4) & 0x03) - 2;
+          px.g += ((b1 >> 2) & 0x03) - 2;
+          px.b += (b1 & 0x03) - 2;
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+          if (p >= end) {
+            ok = false;
+            break;
+          }
+          int b2 = bytes[p++];
+          int vg = (b1 & 0x3F) - 32;
+          px.r += vg - 8 + ((b2 >> 4) & 0x0F);
+          px.g += vg;
+          px.b += vg - 8 + (b2 & 0x0F);
+        } else {
+          run = b1 & 0x3F; // QOI_OP_RUN: this pixel plus `run` more
+        }
+        index[color_hash(px)] = px;
+      } else {
+        ok = false; // out of data mid-image
+        break;
+      }
+      out[0] = px.r;
+      out[1] = px.g;
+      out[2] = px.b;
+      out[3] = px.a;
+    }
+  }
+  if (!ok) {
+    SDL_FreeSurface(surface);
+    SDL_SetError("Truncated QOI image");
+    return NULL;
+  }
+  return surface;
+}
+
+SDL_Surface *qoi_load(const char *path) {
+  size_t size;
+  // A mapped pack's bytes decode where they lie.
+  const void *mapped = pack_map(path, &size);
+  if (mapped != NULL) {
+    return qoi_decode(mapped, size);
+  }
+  void *data = asset_load_file(path, &size);
+  if (data == NULL) {
+    return NULL;
+  }
+  SDL_Surface *surface = qoi_decode(data, size);
+  SDL_free(data);
+  return surface;
+}
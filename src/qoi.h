@@ -0,0 +1,24 @@
+//
+//  qoi.h
+//  QOI image decoding (https://qoiformat.org). QOI is lossless like PNG
+//  but decodes several times faster — no inflate, one pass of byte ops —
+//  and decoding is what startup spends its time on. tools/gen_qoi.py writes
+//  a .qoi next to each PNG; asset_resolve picks it over the PNG when present,
+//  and image.c decodes it here rather than through SDL_image (whose QOI
+//  support is newer than the SDL_image the builds link against).
+//
+
+#ifndef qoi_h
+#define qoi_h
+
+#include <SDL2/SDL.h>
+
+// Decode a whole .qoi file in memory into a new RGBA32 surface. NULL (with
+// SDL_GetError set) for anything malformed or truncated.
+SDL_Surface *qoi_decode(const void *data, size_t size);
+
+// Read and decode a .qoi file (through asset_open, or in place from a mapped
+// pack).
+SDL_Surface *qoi_load(const char *path);
+
+#endif /* qoi_h */
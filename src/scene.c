@@ -5,7 +5,9 @@
 //  Created by Giovanni Cappellotto on 1/22/25.
 //
 
+#include "arena.h"
 #include "scene.h"
+#include "trace.h"
 
 bool hotspots_handle_click(const Hotspot *hotspots, int hotspots_length,
                            Actor *actor, const WalkGrid *grid, SDL_Point p) {
@@ -215,10 +217,10 @@ void render_action_layer(SDL_Renderer *renderer, const ScaleRamp *ramp,
       // need no special case.
       float scale =
           prop->scaled ? scale_ramp_at(ramp, (float)prop->baseline) : 1.0F;
-      int width =
-          prop->animation != NULL
-              ? prop->animation->sprite_clips[prop->animation->current_frame].w
-              : prop->image->width;
+      const AnimationData *sheet = prop->animation;
+      int width = sheet != NULL
+                      ? animation_frame_size(sheet, sheet->current_frame).x
+                      : prop->image->width;
       SDL_Point anchor = {prop->pos.x + width / 2, prop->baseline};
       if (prop->animation != NULL) {
         render_animation_scaled_about(renderer, prop->animation, prop->pos,
@@ -260,12 +262,37 @@ SDL_Point plane_screen_pos(const Plane *plane, SDL_FPoint camera_pos) {
                      plane->origin.y - (int)(camera_pos.y * plane->parallax)};
 }
 
+int plane_wrap_start(int pos, int period) {
+  int start = pos % period;
+  return start > 0 ? start - period : start;
+}
+
+SDL_Rect plane_view_rect(const Plane *plane, SDL_FPoint camera_pos) {
+  SDL_Point at = plane_screen_pos(plane, camera_pos);
+  return (SDL_Rect){-at.x, -at.y, WINDOW_WIDTH, WINDOW_HEIGHT};
+}
+
+SDL_Rect plane_page_rect(const Plane *plane, const Camera *camera) {
+  if (camera == NULL) {
+    return plane_view_rect(plane, (SDL_FPoint){0, 0});
+  }
+  SDL_Rect now = plane_view_rect(plane, camera->pos);
+  SDL_Rect ahead = plane_view_rect(plane, camera_target(camera));
+  SDL_Rect want;
+  SDL_UnionRect(&now, &ahead, &want);
+  return (SDL_Rect){want.x - PLANE_PAGE_MARGIN, want.y - PLANE_PAGE_MARGIN,
+                    want.w + 2 * PLANE_PAGE_MARGIN,
+                    want.h + 2 * PLANE_PAGE_MARGIN};
+}
+
 bool plane_covers_view(const Plane *plane, SDL_Point scene_size) {
   float need_w = WINDOW_WIDTH + plane->parallax * (scene_size.x - WINDOW_WIDTH);
   float need_h =
       WINDOW_HEIGHT + plane->parallax * (scene_size.y - WINDOW_HEIGHT);
-  return plane->image.width >= (int)need_w &&
-         plane->image.height >= (int)need_h;
+  bool repeat_x = plane->repeat != PLANE_REPEAT_NONE;
+  bool repeat_y = plane->repeat == PLANE_REPEAT_XY;
+  return (repeat_x || plane->image.width >= (int)need_w) &&
+         (repeat_y || plane->image.height >= (int)need_h);
 }
 
 // Load one bank of planes; on any image failure, unwind this bank and return
@@ -285,7 +312,11 @@ static bool load_plane_bank(Plane *planes, int length, SDL_Point scene_size,
       }
       return false;
     }
-    if (!load_image(renderer, &planes[i].image)) {
+    // A repeating plane is a small tile drawn many times: one texture.
+    bool loaded = planes[i].repeat != PLANE_REPEAT_NONE
+                      ? load_image(renderer, &planes[i].image)
+                      : load_image_paged(renderer, &planes[i].image);
+    if (!loaded) {
       for (int j = 0; j < i; j++) {
         free_image_texture(&planes[j].image);
       }
@@ -324,15 +355,84 @@ bool load_scene_planes(Scene *scene, SDL_Renderer *renderer) {
   return true;
 }
 
+// A repeating plane: copies of its image edge to edge across the window along
+// its repeated axes, wrapped so the parallax scroll never shows a seam.
+static void render_repeated_plane(SDL_Renderer *renderer, const Plane *plane,
+                                  SDL_Point at) {
+  int w = plane->image.width;
+  int h = plane->image.height;
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  int y0 = at.y;
+  int y1 = at.y + h;
+  if (plane->repeat == PLANE_REPEAT_XY) {
+    y0 = plane_wrap_start(at.y, h);
+    y1 = WINDOW_HEIGHT;
+  }
+  for (int y = y0; y < y1; y += h) {
+    for (int x = plane_wrap_start(at.x, w); x < WINDOW_WIDTH; x += w) {
+      render_image(renderer, &plane->image, (SDL_Point){x, y});
+    }
+  }
+}
+
 void render_scene_planes(SDL_Renderer *renderer, const Plane *planes,
                          int planes_length, const Camera *camera) {
   SDL_FPoint camera_pos = camera != NULL ? camera->pos : (SDL_FPoint){0, 0};
   for (int i = 0; i < planes_length; i++) {
+    if (planes[i].repeat != PLANE_REPEAT_NONE) {
+      render_repeated_plane(renderer, &planes[i],
+                            plane_screen_pos(&planes[i], camera_pos));
+      continue;
+    }
+    image_page_tiles(renderer, &planes[i].image,
+                     plane_page_rect(&planes[i], camera));
     render_image(renderer, &planes[i].image,
                  plane_screen_pos(&planes[i], camera_pos));
   }
 }
 
+void page_out_scene_planes(const Scene *scene) {
+  for (int i = 0; i < scene->bg_planes_length; i++) {
+    image_release_tiles(&scene->bg_planes[i].image);
+  }
+  for (int i = 0; i < scene->fg_planes_length; i++) {
+    image_release_tiles(&scene->fg_planes[i].image);
+  }
+}
+
+static int prepage_planes(SDL_Renderer *renderer, const Plane *planes,
+                          int planes_length, const Camera *camera,
+                          int max_uploads) {
+  int uploads = 0;
+  for (int i = 0; i < planes_length; i++) {
+    uploads += image_prepage_tiles(renderer, &planes[i].image,
+                                   plane_page_rect(&planes[i], camera),
+                                   max_uploads - uploads);
+  }
+  return uploads;
+}
+
+int prepage_scene_planes(SDL_Renderer *renderer, const Scene *scene,
+                         int max_uploads) {
+  int uploads = prepage_planes(renderer, scene->bg_planes,
+                               scene->bg_planes_length, scene->camera,
+                               max_uploads);
+  return uploads + prepage_planes(renderer, scene->fg_planes,
+                                  scene->fg_planes_length, scene->camera,
+                                  max_uploads - uploads);
+}
+
+bool scene_has_exit(const Scene *scene, int to) {
+  for (int i = 0; i < scene->exits_length; i++) {
+    if (scene->exits[i] == to) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void free_scene_planes(Scene *scene) {
   for (int i = 0; i < scene->bg_planes_length; i++) {
     free_image_texture(&scene->bg_planes[i].image);
@@ -357,7 +457,7 @@ static void load_chunk_sidecars(ChunkData *chunk) {
             (Asset){.filename = filename, .directory = chunk->directory}, path,
             sizeof(path))) {
       size_t size = 0;
-      char *data = SDL_LoadFile(path, &size);
+      char *data = asset_load_file(path, &size);
       if (data != NULL) {
         // Trim to the first line, without the newline.
         size_t end = 0;
@@ -365,7 +465,7 @@ static void load_chunk_sidecars(ChunkData *chunk) {
           end++;
         }
         data[end] = '\0';
-        chunk->text = SDL_strdup(data);
+        chunk->text = arena_scoped_strdup(data);
         SDL_free(data);
       }
     }
@@ -389,13 +489,14 @@ static void free_chunk_data(ChunkData *chunk) {
     Mix_FreeChunk(chunk->chunk);
     chunk->chunk = NULL;
   }
-  SDL_free(chunk->text);
+  arena_scoped_free(chunk->text);
   chunk->text = NULL;
   lipsync_free(&chunk->cues);
   lipsync_free_words(&chunk->words);
 }
 
 bool load_chunk_table(ChunkData *chunks, int length) {
+  TRACE_BEGIN("load_chunk_table");
   for (int i = 0; i < length; i++) {
     char path[ASSET_PATH_MAX];
     Asset asset = {
@@ -412,7 +513,7 @@ bool load_chunk_table(ChunkData *chunks, int length) {
       asset_resolve(asset, path, sizeof(path));
     }
     if (present) {
-      chunks[i].chunk = Mix_LoadWAV(path);
+      chunks[i].chunk = load_wav_chunk(path);
       if (chunks[i].chunk == NULL && !chunks[i].optional_audio) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load %s: %s",
                      path, Mix_GetError());
@@ -421,6 +522,7 @@ bool load_chunk_table(ChunkData *chunks, int length) {
         for (int j = 0; j < i; j++) {
           free_chunk_data(&chunks[j]);
         }
+        TRACE_END("load_chunk_table");
         return false;
       }
     }
@@ -429,6 +531,7 @@ bool load_chunk_table(ChunkData *chunks, int length) {
     load_chunk_sidecars(&chunks[i]);
   }
 
+  TRACE_END("load_chunk_table");
   return true;
 }
 
@@ -482,7 +585,7 @@ bool load_scene_music(Scene *scene) {
   }
   char path[ASSET_PATH_MAX];
   asset_resolve(scene->music, path, sizeof(path));
-  scene->music_stream = Mix_LoadMUS(path);
+  scene->music_stream = Mix_LoadMUS_RW(asset_open(path), 1);
   if (scene->music_stream == NULL) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load music %s: %s",
                  path, Mix_GetError());
@@ -533,3 +636,9 @@ void free_scene_animations(Scene *scene) {
     }
   }
 }
+
+void unload_scene_animations(Scene *scene) {
+  for (int i = 0; i < scene->anim_specs_length; i++) {
+    free_image_texture(&scene->animations[i]->image);
+  }
+}
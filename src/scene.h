@@ -55,6 +55,15 @@ typedef struct scene_sprite {
   bool (*visible)(void); // NULL = always drawn; else gated like a hotspot
 } SceneSprite;
 
+// Whether a plane's image is drawn once or repeated edge to edge across the
+// window (a sky gradient, a band of grass, open water): a small tile stands in
+// for a scene-wide bitmap, and the scene can grow without its art growing.
+typedef enum plane_repeat {
+  PLANE_REPEAT_NONE,
+  PLANE_REPEAT_X,  // a horizontal band, at the plane's own height
+  PLANE_REPEAT_XY, // fills the window
+} PlaneRepeat;
+
 // A background/foreground layer that scrolls at its own parallax factor
 // (DEPTH_AND_CAMERA.md Phase 4). Planes are drawn by the engine, not by the
 // scene's render, each at origin - camera.pos * parallax — so a distant plane
@@ -70,8 +79,11 @@ typedef struct plane {
   // and may be partial strips.
   float parallax;
   // Scene-coord position of the image's top-left when the camera is at (0,0);
-  // usually {0, 0}.
+  // usually {0, 0}. A repeating plane wraps around it.
   SDL_Point origin;
+  // PLANE_REPEAT_NONE (the default) draws the image once. A repeating plane
+  // covers its repeated axes whatever the scene's size; it is never paged.
+  PlaneRepeat repeat;
 } Plane;
 
 // A clickable scene region and what it does — the single source of truth for
@@ -289,6 +301,14 @@ typedef struct scene {
   int bg_planes_length;
   Plane *fg_planes;
   int fg_planes_length;
+
+  // The scenes this one can switch to (set_active_scene/_at), by index in the
+  // adventure's table: its neighbours in the scene graph. While it is active,
+  // the engine pages in their planes' tiles a frame at a time and keeps them,
+  // so stepping through an exit finds its backdrop resident. A debug build
+  // warns about a switch to a scene not listed. NULL/0 for none.
+  const int *exits;
+  int exits_length;
 } Scene;
 
 // Back-to-front draw order of the action layer: visible props and actors
@@ -369,22 +389,56 @@ bool load_scene_images(Scene *scene, SDL_Renderer *renderer);
 // math can be tested without a renderer.
 SDL_Point plane_screen_pos(const Plane *plane, SDL_FPoint camera_pos);
 
+// Where to draw the first copy of a repeating plane along one axis: its
+// screen position `pos` moved by whole periods into (-period, 0], so copies
+// every `period` pixels from there cover the window. Split out so the wrap
+// can be tested without a renderer.
+int plane_wrap_start(int pos, int period);
+
+// The part of the plane's image the window shows with the camera at
+// camera_pos, in image coordinates (unclipped: it may run past the image).
+SDL_Rect plane_view_rect(const Plane *plane, SDL_FPoint camera_pos);
+
+// Slack around the view, in plane pixels, that a paged plane keeps resident.
+#define PLANE_PAGE_MARGIN 128
+
+// What to keep resident of a paged plane (load_image_paged): the view now
+// and at camera_target, where the camera is easing to, plus
+// PLANE_PAGE_MARGIN — so tiles come in before they scroll into view.
+SDL_Rect plane_page_rect(const Plane *plane, const Camera *camera);
+
 // Does the plane's image cover the whole window across the camera's travel?
-// image dimension >= WINDOW + parallax * (scene - WINDOW), per axis. Used by
-// load_scene_planes to warn about a plane that would expose the background.
+// image dimension >= WINDOW + parallax * (scene - WINDOW), per axis; a
+// repeated axis always does. Used by load_scene_planes to warn about a plane
+// that would expose the background.
 bool plane_covers_view(const Plane *plane, SDL_Point scene_size);
 
 // Load (and validate the coverage of) every bg/fg plane's image. Unwinds on
 // failure like load_scene_images. camera-less scenes are treated as
-// window-sized for the coverage check.
+// window-sized for the coverage check. Oversized planes are paged in tiles
+// (load_image_paged).
 bool load_scene_planes(Scene *scene, SDL_Renderer *renderer);
 
 // Draw a plane table in array order, each shifted by its own parallax offset
-// (the render offset must be {0,0} — planes carry their own). Called by the
-// engine, not by scenes.
+// (the render offset must be {0,0} — planes carry their own). Paged planes
+// first page their tiles to plane_page_rect. Called by the engine, not by
+// scenes.
 void render_scene_planes(SDL_Renderer *renderer, const Plane *planes,
                          int planes_length, const Camera *camera);
 
+// Release every resident tile of the scene's paged planes; the engine calls
+// it when the scene is neither active nor one of the active scene's exits.
+void page_out_scene_planes(const Scene *scene);
+
+// Page in up to `max_uploads` tiles of the scene's planes at the view its
+// camera last had (its start, before its first visit); returns the uploads
+// made. How the engine warms the active scene's exits.
+int prepage_scene_planes(SDL_Renderer *renderer, const Scene *scene,
+                         int max_uploads);
+
+// Whether `to` is among the scene's declared exits.
+bool scene_has_exit(const Scene *scene, int to);
+
 void free_scene_planes(Scene *scene);
 
 bool load_scene_chunks(Scene *scene);
@@ -435,4 +489,8 @@ void free_scene_chunks(Scene *scene);
 
 void free_scene_animations(Scene *scene);
 
+// Free the textures load_scene_animations loaded but keep the animations
+// themselves (made once, at init), ready for the next load.
+void unload_scene_animations(Scene *scene);
+
 #endif /* scene_h */
@@ -8,7 +8,40 @@
 #include <SDL2/SDL.h>
 #include <SDL2_mixer/SDL_mixer.h>
 
+#include "asset.h"
 #include "sound.h"
+#include "warm_cache.h"
+
+Mix_Chunk *load_wav_chunk(const char *path) {
+  int frequency = 0;
+  Uint16 format = 0;
+  int channels = 0;
+  // Mix_LoadWAV converts to the device's format, so that is the variant. With
+  // no device open there is nothing to convert to, and nothing to cache.
+  bool opened = Mix_QuerySpec(&frequency, &format, &channels) != 0;
+  WarmKey key = warm_cache_key(WARM_AUDIO, path,
+                               (Uint64)(Uint32)frequency |
+                                   (Uint64)format << 32 |
+                                   (Uint64)(Uint32)channels << 48);
+  key.usable = key.usable && opened;
+  size_t size = 0;
+  Uint8 *samples = warm_cache_read(&key, &size);
+  if (samples != NULL && size > 0 && size <= SDL_MAX_UINT32) {
+    Mix_Chunk *chunk = Mix_QuickLoad_RAW(samples, (Uint32)size);
+    if (chunk != NULL) {
+      // Mix_FreeChunk frees the samples of a chunk marked allocated, as it
+      // does Mix_LoadWAV's.
+      chunk->allocated = 1;
+      return chunk;
+    }
+  }
+  SDL_free(samples);
+  Mix_Chunk *chunk = Mix_LoadWAV_RW(asset_open(path), 1);
+  if (chunk != NULL) {
+    warm_cache_write(&key, chunk->abuf, chunk->alen);
+  }
+  return chunk;
+}
 
 // Compute the length of a chunk in milliseconds
 //
@@ -32,6 +32,12 @@ typedef struct chunk_data {
   WordTimings words;
 } ChunkData;
 
+// Mix_LoadWAV_RW on a resolved asset path, converted to the audio device's
+// format: from the warm-start cache (warm_cache.h) when a previous launch of
+// this build converted the same file for the same device. NULL (with
+// Mix_GetError set) if it can't be loaded.
+Mix_Chunk *load_wav_chunk(const char *path);
+
 Uint32 get_chunk_time_ms(Mix_Chunk *chunk);
 
 #endif /* sound_h */
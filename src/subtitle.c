@@ -14,9 +14,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "asset.h"
 #include "clock.h"
 #include "constants.h"
+#include "draw.h"
 #include "lipsync.h"
+#include "trace.h"
 
 #include "subtitle.h"
 
@@ -84,7 +87,8 @@ bool subtitle_init(int argc, char **argv, SDL_Renderer *renderer) {
     enabled = false;
     return false;
   }
-  font = TTF_OpenFont(SUBTITLE_FONT_PATH, SUBTITLE_FONT_SIZE);
+  font = TTF_OpenFontRW(asset_open(SUBTITLE_FONT_PATH), 1,
+                       SUBTITLE_FONT_SIZE);
   if (font == NULL) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load %s: %s",
                  SUBTITLE_FONT_PATH, TTF_GetError());
@@ -127,8 +131,8 @@ static bool render_word(const char *word, SDL_Color color, SDL_Texture **out,
   return *out != NULL;
 }
 
-void subtitle_show(const char *text, const WordTimings *words,
-                   Uint32 duration_ms, bool force) {
+static void show_line(const char *text, const WordTimings *words,
+                      Uint32 duration_ms, bool force) {
   if (!initialized || text == NULL || (!enabled && !force)) {
     return;
   }
@@ -229,6 +233,14 @@ void subtitle_show(const char *text, const WordTimings *words,
   active = true;
 }
 
+void subtitle_show(const char *text, const WordTimings *words,
+                   Uint32 duration_ms, bool force) {
+  // Laying out a line renders every word twice: a likely frame hitch.
+  TRACE_BEGIN("subtitle_show");
+  show_line(text, words, duration_ms, force);
+  TRACE_END("subtitle_show");
+}
+
 void subtitle_render(SDL_Renderer *renderer) {
   if (!active) {
     return;
@@ -241,7 +253,7 @@ void subtitle_render(SDL_Renderer *renderer) {
 
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xA0);
-  SDL_RenderFillRect(renderer, &block);
+  draw_fill_rect(renderer, &block);
 
   // The word being spoken right now, per the line's timings.
   int highlighted = -1;
@@ -255,14 +267,14 @@ void subtitle_render(SDL_Renderer *renderer) {
     box.w += 2 * SUBTITLE_HIGHLIGHT_PADDING;
     box.h += 2 * SUBTITLE_HIGHLIGHT_PADDING;
     SDL_SetRenderDrawColor(renderer, 0xFF, 0xCC, 0x33, 0xE6);
-    SDL_RenderFillRect(renderer, &box);
+    draw_fill_rect(renderer, &box);
   }
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
   for (int i = 0; i < line_words_length; i++) {
     SDL_Texture *texture =
         i == highlighted ? line_words[i].dark : line_words[i].white;
-    SDL_RenderCopy(renderer, texture, NULL, &line_words[i].box);
+    draw_copy(renderer, texture, NULL, &line_words[i].box);
   }
 }
 
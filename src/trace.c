@@ -0,0 +1,214 @@
+//
+//  trace.c
+//  Timeline tracing (see trace.h).
+//
+
+#include "trace.h"
+
+#ifndef PROD
+
+typedef struct trace_event {
+  const char *name;
+  char *detail; // owned; NULL when the scope has none
+  Uint64 counter; // SDL_GetPerformanceCounter at the event
+  SDL_threadID thread;
+  char phase; // 'B'egin, 'E'nd or 'i'nstant, as the format spells them
+} TraceEvent;
+
+// Events are kept in fixed-size chunks, so growing the log allocates one more
+// chunk and never moves what's already recorded.
+#define TRACE_CHUNK_EVENTS 4096
+
+// The events recorded so far. Decode workers trace too, so appends take the
+// lock; a spin lock because the critical section is a few stores (chunks are
+// allocated with it released).
+static struct {
+  bool recording;
+  char *path;
+  Uint64 started;
+  TraceEvent *chunks[TRACE_MAX_EVENTS / TRACE_CHUNK_EVENTS];
+  int length;
+  int capacity; // events the allocated chunks hold
+  SDL_SpinLock lock;
+} trace;
+
+static TraceEvent *event_at(int index) {
+  return &trace.chunks[index / TRACE_CHUNK_EVENTS][index % TRACE_CHUNK_EVENTS];
+}
+
+bool trace_start(const char *path) {
+  if (path == NULL || path[0] == '\0' || trace.path != NULL) {
+    return false;
+  }
+  trace.path = SDL_strdup(path);
+  if (trace.path == NULL) {
+    return false;
+  }
+  trace.started = SDL_GetPerformanceCounter();
+  trace.recording = true;
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Tracing to %s", path);
+  return true;
+}
+
+bool trace_recording(void) { return trace.recording; }
+
+static void record(char phase, const char *name, const char *detail) {
+  if (!trace.recording) {
+    return;
+  }
+  Uint64 now = SDL_GetPerformanceCounter();
+  char *copy = detail != NULL ? SDL_strdup(detail) : NULL;
+  TraceEvent *spare = NULL;
+  SDL_AtomicLock(&trace.lock);
+  while (trace.recording && trace.length == trace.capacity &&
+         trace.capacity < TRACE_MAX_EVENTS) {
+    if (spare != NULL) {
+      trace.chunks[trace.capacity / TRACE_CHUNK_EVENTS] = spare;
+      trace.capacity += TRACE_CHUNK_EVENTS;
+      spare = NULL;
+      break;
+    }
+    // Allocate the next chunk unlocked, then look again: another thread may
+    // have added one (and filled it) meanwhile.
+    SDL_AtomicUnlock(&trace.lock);
+    spare = SDL_malloc(sizeof(TraceEvent) * TRACE_CHUNK_EVENTS);
+    SDL_AtomicLock(&trace.lock);
+    if (spare == NULL) {
+      break;
+    }
+  }
+  if (!trace.recording || trace.length == trace.capacity) {
+    // Full (or out of memory): keep what there is, a well-formed prefix of
+    // the run, and record nothing more.
+    bool stopping = trace.recording;
+    trace.recording = false;
+    SDL_AtomicUnlock(&trace.lock);
+    SDL_free(spare);
+    SDL_free(copy);
+    if (stopping) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Trace full at %d events; recording stopped", trace.length);
+    }
+    return;
+  }
+  *event_at(trace.length++) = (TraceEvent){
+      .name = name,
+      .detail = copy,
+      .counter = now,
+      .thread = SDL_ThreadID(),
+      .phase = phase,
+  };
+  SDL_AtomicUnlock(&trace.lock);
+  SDL_free(spare);
+}
+
+void trace_begin(const char *name, const char *detail) {
+  record('B', name, detail);
+}
+
+void trace_end(const char *name) { record('E', name, NULL); }
+
+void trace_instant(const char *name) { record('i', name, NULL); }
+
+// Write `text` as the body of a JSON string: quotes, backslashes (Windows
+// paths) and control characters escaped.
+static bool write_json_string(SDL_RWops *rw, const char *text) {
+  char buffer[512];
+  size_t used = 0;
+  for (const char *c = text; *c != '\0'; c++) {
+    if (used + 7 > sizeof(buffer)) {
+      if (SDL_RWwrite(rw, buffer, 1, used) != used) {
+        return false;
+      }
+      used = 0;
+    }
+    unsigned char ch = (unsigned char)*c;
+    if (ch == '"' || ch == '\\') {
+      buffer[used++] = '\\';
+      buffer[used++] = (char)ch;
+    } else if (ch < 0x20) {
+      used += (size_t)SDL_snprintf(buffer + used, sizeof(buffer) - used,
+                                   "\\u%04x", ch);
+    } else {
+      buffer[used++] = (char)ch;
+    }
+  }
+  return SDL_RWwrite(rw, buffer, 1, used) == used;
+}
+
+static bool write_text(SDL_RWops *rw, const char *text) {
+  size_t length = SDL_strlen(text);
+  return SDL_RWwrite(rw, text, 1, length) == length;
+}
+
+// One event as a trace-event object: timestamps in microseconds since
+// trace_start, one process, a track per thread.
+static bool write_event(SDL_RWops *rw, const TraceEvent *event, bool first) {
+  double us = (double)(event->counter - trace.started) * 1e6 /
+              (double)SDL_GetPerformanceFrequency();
+  char head[160];
+  SDL_snprintf(head, sizeof(head),
+               "%s\n{\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu,"
+               "\"name\":\"",
+               first ? "" : ",", event->phase, us,
+               (unsigned long)event->thread);
+  if (!write_text(rw, head) || !write_json_string(rw, event->name)) {
+    return false;
+  }
+  if (event->phase == 'i' && !write_text(rw, "\",\"s\":\"g")) {
+    return false;
+  }
+  if (event->detail != NULL &&
+      (!write_text(rw, "\",\"args\":{\"detail\":\"") ||
+       !write_json_string(rw, event->detail) || !write_text(rw, "\"}"))) {
+    return false;
+  }
+  return write_text(rw, event->detail != NULL ? "}" : "\"}");
+}
+
+bool trace_stop(void) {
+  if (trace.path == NULL) {
+    return true;
+  }
+  SDL_AtomicLock(&trace.lock);
+  trace.recording = false;
+  SDL_AtomicUnlock(&trace.lock);
+
+  bool ok = false;
+  SDL_RWops *rw = SDL_RWFromFile(trace.path, "wb");
+  if (rw == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "trace: %s: %s", trace.path,
+                 SDL_GetError());
+  } else {
+    ok = write_text(rw, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (int i = 0; ok && i < trace.length; i++) {
+      ok = write_event(rw, event_at(i), i == 0);
+    }
+    ok = ok && write_text(rw, "\n]}\n");
+    if (SDL_RWclose(rw) != 0) {
+      ok = false;
+    }
+    if (ok) {
+      SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Wrote %d trace events to %s",
+                  trace.length, trace.path);
+    } else {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "trace: short write to %s",
+                   trace.path);
+    }
+  }
+
+  for (int i = 0; i < trace.length; i++) {
+    SDL_free(event_at(i)->detail);
+  }
+  for (int i = 0; i < trace.capacity / TRACE_CHUNK_EVENTS; i++) {
+    SDL_free(trace.chunks[i]);
+    trace.chunks[i] = NULL;
+  }
+  SDL_free(trace.path);
+  trace.path = NULL;
+  trace.length = 0;
+  trace.capacity = 0;
+  return ok;
+}
+
+#endif /* PROD */
@@ -0,0 +1,65 @@
+//
+//  trace.h
+//  Timeline tracing. Scoped TRACE_BEGIN/TRACE_END pairs around loads, path
+//  finding, subtitle layout and every profiled frame phase (profile.h) record
+//  begin/end events, which trace_shutdown writes out as Chrome trace-event JSON
+//  — open it in Perfetto (ui.perfetto.dev) or chrome://tracing to see startup
+//  and hitches on a timeline, decode workers on their own tracks.
+//
+//  Recording is off unless $VANIA_TRACE names the file to write, and the
+//  macros compile to nothing in a PROD build.
+//
+
+#ifndef trace_h
+#define trace_h
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Events kept per run: a bit over ten minutes of frames at FPS. Once full,
+// recording stops (and says so) rather than growing without bound.
+#define TRACE_MAX_EVENTS (1 << 19)
+
+#ifndef PROD
+
+// Start recording, to be written to `path` by trace_stop. False (and nothing
+// recorded) when path is NULL or empty, or a trace is already open.
+bool trace_start(const char *path);
+
+// Stop recording, write the trace-event JSON and drop the events. False when
+// the file couldn't be written; true also when nothing was recording.
+bool trace_stop(void);
+
+// Whether events are being recorded.
+bool trace_recording(void);
+
+// Record the start and end of a scope on the calling thread. `name` must
+// outlive the run (a string literal); `detail`, shown as the event's argument
+// (an asset path), is copied and may be NULL.
+void trace_begin(const char *name, const char *detail);
+void trace_end(const char *name);
+
+// Record a zero-length marker across every track (a frame boundary).
+void trace_instant(const char *name);
+
+// Start from $VANIA_TRACE, and write on the way out: the entry points and the
+// headless harness call these around their run.
+#define TRACE_INIT() trace_start(SDL_getenv("VANIA_TRACE"))
+#define TRACE_SHUTDOWN() trace_stop()
+#define TRACE_BEGIN(name) trace_begin((name), NULL)
+#define TRACE_BEGIN_DETAIL(name, detail) trace_begin((name), (detail))
+#define TRACE_END(name) trace_end(name)
+#define TRACE_INSTANT(name) trace_instant(name)
+
+#else
+
+#define TRACE_INIT() ((void)0)
+#define TRACE_SHUTDOWN() ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_BEGIN_DETAIL(name, detail) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+
+#endif /* PROD */
+
+#endif /* trace_h */
@@ -11,7 +11,9 @@
 #include <math.h>
 #include <stdlib.h>
 
+#include "trace.h"
 #include "walk.h"
+#include "warm_cache.h"
 
 #define GRID_CELLS_MAX (WALK_GRID_MAX_W * WALK_GRID_MAX_H)
 
@@ -22,6 +24,9 @@
 // Distance between line-of-sight samples, in px (half a cell).
 #define WALK_SAMPLE_STEP (WALK_CELL_SIZE / 2.0F)
 
+// The last WalkGrid.generation handed out.
+static Uint32 generations = 0;
+
 static int cell_index(const WalkGrid *grid, int cx, int cy) {
   return cy * grid->w + cx;
 }
@@ -43,6 +48,7 @@ void walk_grid_build(WalkGrid *grid, const WalkArea *area,
                      SDL_Point scene_size) {
   grid->w = scene_size.x / WALK_CELL_SIZE;
   grid->h = scene_size.y / WALK_CELL_SIZE;
+  grid->generation = ++generations;
   SDL_assert(grid->w > 0 && grid->w <= WALK_GRID_MAX_W);
   SDL_assert(grid->h > 0 && grid->h <= WALK_GRID_MAX_H);
   for (int cy = 0; cy < grid->h; cy++) {
@@ -129,10 +135,46 @@ bool walk_grid_parse(const char *data, size_t size, WalkGrid *grid) {
   if (i != size) {
     return false; // trailing junk
   }
+  parsed.generation = ++generations;
   *grid = parsed;
   return true;
 }
 
+// A mask parsed on an earlier launch, as the warm-start cache (warm_cache.h)
+// kept it: the rows of w x h cells, the size being the key's variant.
+static bool read_warm_grid(const WarmKey *key, WalkGrid *grid, int w, int h) {
+  size_t size = 0;
+  Uint8 *cells = warm_cache_read(key, &size);
+  bool ok = cells != NULL && size == (size_t)w * (size_t)h &&
+            w <= WALK_GRID_MAX_W && h <= WALK_GRID_MAX_H;
+  for (size_t i = 0; ok && i < size; i++) {
+    ok = cells[i] <= 1;
+  }
+  if (ok) {
+    grid->w = w;
+    grid->h = h;
+    grid->generation = ++generations;
+    for (int cy = 0; cy < h; cy++) {
+      SDL_memcpy(grid->cells[cy], cells + (size_t)cy * (size_t)w, (size_t)w);
+    }
+  }
+  SDL_free(cells);
+  return ok;
+}
+
+static void write_warm_grid(const WarmKey *key, const WalkGrid *grid) {
+  Uint8 *cells = key->usable ? SDL_malloc((size_t)grid->w * grid->h) : NULL;
+  if (cells == NULL) {
+    return;
+  }
+  for (int cy = 0; cy < grid->h; cy++) {
+    SDL_memcpy(cells + (size_t)cy * (size_t)grid->w, grid->cells[cy],
+               (size_t)grid->w);
+  }
+  warm_cache_write(key, cells, (size_t)grid->w * grid->h);
+  SDL_free(cells);
+}
+
 void walk_grid_init(WalkGrid *grid, const WalkArea *area, SDL_Point scene_size,
                     const char *dir) {
   if (dir != NULL) {
@@ -140,14 +182,21 @@ void walk_grid_init(WalkGrid *grid, const WalkArea *area, SDL_Point scene_size,
     if (asset_try_resolve(
             (Asset){.filename = "walkable.walk", .directory = dir}, path,
             sizeof(path))) {
+      int w = scene_size.x / WALK_CELL_SIZE;
+      int h = scene_size.y / WALK_CELL_SIZE;
+      WarmKey key = warm_cache_key(WARM_WALK, path,
+                                   (Uint64)(Uint32)w | (Uint64)(Uint32)h << 32);
+      if (read_warm_grid(&key, grid, w, h)) {
+        return;
+      }
       size_t size = 0;
-      char *data = SDL_LoadFile(path, &size);
+      char *data = asset_load_file(path, &size);
       if (data != NULL) {
-        bool ok = walk_grid_parse(data, size, grid) &&
-                  grid->w == scene_size.x / WALK_CELL_SIZE &&
-                  grid->h == scene_size.y / WALK_CELL_SIZE;
+        bool ok = walk_grid_parse(data, size, grid) && grid->w == w &&
+                  grid->h == h;
         SDL_free(data);
         if (ok) {
+          write_warm_grid(&key, grid);
           return;
         }
       }
@@ -322,8 +371,8 @@ static bool segment_is_walkable(const WalkGrid *grid, SDL_FPoint a,
   return true;
 }
 
-int walk_grid_find_path(const WalkGrid *grid, SDL_FPoint from, SDL_FPoint to,
-                        SDL_FPoint *out, int max_out) {
+static int find_path(const WalkGrid *grid, SDL_FPoint from, SDL_FPoint to,
+                     SDL_FPoint *out, int max_out) {
   // Endpoint normalisation: an illegal start (a POI on blocked ground, the
   // slide teleport) or goal is snapped to the nearest legal point first.
   SDL_Point from_i = {(int)from.x, (int)from.y};
@@ -490,6 +539,14 @@ int walk_grid_find_path(const WalkGrid *grid, SDL_FPoint from, SDL_FPoint to,
   return count;
 }
 
+int walk_grid_find_path(const WalkGrid *grid, SDL_FPoint from, SDL_FPoint to,
+                        SDL_FPoint *out, int max_out) {
+  TRACE_BEGIN("walk_grid_find_path");
+  int count = find_path(grid, from, to, out, max_out);
+  TRACE_END("walk_grid_find_path");
+  return count;
+}
+
 void walk_actor_to(Actor *actor, const WalkGrid *grid, SDL_FPoint goal,
                    bool exact_goal, void (*on_end)(void)) {
   SDL_Point goal_i = {(int)goal.x, (int)goal.y};
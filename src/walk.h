@@ -34,6 +34,10 @@ typedef struct walk_area {
 typedef struct walk_grid {
   int w;
   int h;
+  // Fresh each time walk_grid_build or walk_grid_parse fills the grid, so a
+  // cache of its contents (the debug overlay's mask texture) can tell a
+  // reloaded grid from the one it was made for, even at the same address.
+  Uint32 generation;
   Uint8 cells[WALK_GRID_MAX_H][WALK_GRID_MAX_W];
 } WalkGrid;
 
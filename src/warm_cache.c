@@ -0,0 +1,214 @@
+//
+//  warm_cache.c
+//  Warm-start cache of loaded assets (see warm_cache.h).
+//
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+#include "lz4.h"
+#include "warm_cache.h"
+
+// The build the entries belong to. The Makefile recompiles this file whenever
+// it compiles anything else, so its compile time names the build; a build
+// system that doesn't can define its own id.
+#ifndef WARM_CACHE_BUILD
+#define WARM_CACHE_BUILD __DATE__ " " __TIME__
+#endif
+
+// An entry (little-endian): "VWRM", u32 version, u64 build hash, u64 variant,
+// u32 kind, u32 path length, the stamp as u64 size, u64 time and u64 offset,
+// then u32 payload size and u32 compressed size; then the path (an entry's
+// name is only a hash of it) and the LZ4 block. A key matches an entry whose
+// first ENTRY_KEY_SIZE bytes and path are its own.
+#define ENTRY_MAGIC "VWRM"
+#define ENTRY_KEY_SIZE 56
+#define ENTRY_HEADER_SIZE 64
+
+static char *cache_dir = NULL;
+
+static SDL_atomic_t hits;
+static SDL_atomic_t misses;
+static SDL_atomic_t dropped;
+static SDL_atomic_t written;
+static SDL_atomic_t warned;
+
+void warm_cache_set_dir(const char *dir) {
+  SDL_free(cache_dir);
+  cache_dir = dir != NULL ? SDL_strdup(dir) : NULL;
+}
+
+bool warm_cache_enabled(void) { return cache_dir != NULL; }
+
+// FNV-1a, 64-bit, continuing from `hash`.
+static Uint64 fnv64(Uint64 hash, const void *data, size_t size) {
+  const Uint8 *bytes = data;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+#define FNV64_BASIS 14695981039346656037ULL
+
+static Uint64 build_hash(void) {
+  return fnv64(FNV64_BASIS, WARM_CACHE_BUILD, sizeof(WARM_CACHE_BUILD) - 1);
+}
+
+static void put_le32(Uint8 *p, Uint32 v) {
+  p[0] = (Uint8)v;
+  p[1] = (Uint8)(v >> 8);
+  p[2] = (Uint8)(v >> 16);
+  p[3] = (Uint8)(v >> 24);
+}
+
+static void put_le64(Uint8 *p, Uint64 v) {
+  put_le32(p, (Uint32)v);
+  put_le32(p + 4, (Uint32)(v >> 32));
+}
+
+static Uint32 read_le32(const Uint8 *p) {
+  return (Uint32)p[0] | (Uint32)p[1] << 8 | (Uint32)p[2] << 16 |
+         (Uint32)p[3] << 24;
+}
+
+// The header `key` calls for, payload sizes aside.
+static void put_header(Uint8 *header, const WarmKey *key) {
+  SDL_memcpy(header, ENTRY_MAGIC, 4);
+  put_le32(header + 4, WARM_CACHE_VERSION);
+  put_le64(header + 8, build_hash());
+  put_le64(header + 16, key->variant);
+  put_le32(header + 24, (Uint32)key->kind);
+  put_le32(header + 28, (Uint32)SDL_strlen(key->path));
+  put_le64(header + 32, key->stamp.size);
+  put_le64(header + 40, (Uint64)key->stamp.time);
+  put_le64(header + 48, key->stamp.offset);
+}
+
+// The entry file for a key: one per asset, kind and variant, whatever the
+// build or the asset's bytes, so a new entry replaces the stale one.
+static bool entry_path(const WarmKey *key, char *buf, size_t n) {
+  Uint8 id[12];
+  put_le32(id, (Uint32)key->kind);
+  put_le64(id + 4, key->variant);
+  Uint64 name = fnv64(fnv64(FNV64_BASIS, id, sizeof(id)), key->path,
+                      SDL_strlen(key->path));
+  int length = snprintf(buf, n, "%swarm-%08x%08x.lz4", cache_dir,
+                        (unsigned)(name >> 32), (unsigned)name);
+  return length > 0 && (size_t)length < n;
+}
+
+bool warm_cache_entry_path(const WarmKey *key, char *buf, size_t n) {
+  return cache_dir != NULL && entry_path(key, buf, n);
+}
+
+WarmKey warm_cache_key(WarmKind kind, const char *path, Uint64 variant) {
+  WarmKey key = {.kind = kind, .path = path, .variant = variant};
+  key.usable = cache_dir != NULL && asset_stamp(path, &key.stamp);
+  return key;
+}
+
+void *warm_cache_read(const WarmKey *key, size_t *size) {
+  char file[ASSET_PATH_MAX];
+  if (!key->usable || !entry_path(key, file, sizeof(file))) {
+    return NULL;
+  }
+  size_t entry_size = 0;
+  Uint8 *entry = SDL_LoadFile(file, &entry_size);
+  Uint8 expected[ENTRY_HEADER_SIZE];
+  put_header(expected, key);
+  size_t path_length = SDL_strlen(key->path);
+  void *payload = NULL;
+  bool malformed = entry != NULL;
+  if (entry != NULL && entry_size >= ENTRY_HEADER_SIZE &&
+      SDL_memcmp(entry, ENTRY_MAGIC, 4) == 0) {
+    Uint32 payload_size = read_le32(entry + 56);
+    Uint32 packed_size = read_le32(entry + 60);
+    malformed = entry_size - ENTRY_HEADER_SIZE !=
+                (size_t)read_le32(entry + 28) + packed_size;
+    // Another build's or older bytes' entry is stale, not damaged: the
+    // loader's write will replace it.
+    if (!malformed && SDL_memcmp(entry, expected, ENTRY_KEY_SIZE) == 0 &&
+        SDL_memcmp(entry + ENTRY_HEADER_SIZE, key->path, path_length) == 0) {
+      payload = SDL_malloc(payload_size > 0 ? payload_size : 1);
+      if (payload != NULL &&
+          !lz4_decompress(entry + ENTRY_HEADER_SIZE + path_length, packed_size,
+                          payload, payload_size)) {
+        SDL_free(payload);
+        payload = NULL;
+        malformed = true;
+      }
+      *size = payload_size;
+    }
+  }
+  SDL_free(entry);
+  if (malformed) {
+    remove(file);
+    SDL_AtomicAdd(&dropped, 1);
+  }
+  SDL_AtomicAdd(payload != NULL ? &hits : &misses, 1);
+  return payload;
+}
+
+void warm_cache_write(const WarmKey *key, const void *data, size_t size) {
+  char file[ASSET_PATH_MAX];
+  char temporary[ASSET_PATH_MAX + 24];
+  if (!key->usable || size > SDL_MAX_UINT32 ||
+      !entry_path(key, file, sizeof(file))) {
+    return;
+  }
+  size_t path_length = SDL_strlen(key->path);
+  size_t bound = lz4_compress_bound(size);
+  Uint8 *entry = SDL_malloc(ENTRY_HEADER_SIZE + path_length + bound);
+  if (entry == NULL) {
+    return;
+  }
+  put_header(entry, key);
+  SDL_memcpy(entry + ENTRY_HEADER_SIZE, key->path, path_length);
+  size_t packed_size = lz4_compress(
+      data, size, entry + ENTRY_HEADER_SIZE + path_length, bound);
+  put_le32(entry + 56, (Uint32)size);
+  put_le32(entry + 60, (Uint32)packed_size);
+  size_t entry_size = ENTRY_HEADER_SIZE + path_length + packed_size;
+  // Per thread: two workers never share a temporary file.
+  snprintf(temporary, sizeof(temporary), "%s.%lu.tmp", file, SDL_ThreadID());
+  SDL_RWops *rw = SDL_RWFromFile(temporary, "wb");
+  bool ok = rw != NULL && SDL_RWwrite(rw, entry, 1, entry_size) == entry_size;
+  if (rw != NULL && SDL_RWclose(rw) != 0) {
+    ok = false;
+  }
+  SDL_free(entry);
+#ifdef _WIN32
+  // Windows' rename() won't replace a file. Losing the entry in between
+  // costs a load, no more; everywhere else the rename replaces it atomically.
+  if (ok) {
+    remove(file);
+  }
+#endif
+  if (!ok || rename(temporary, file) != 0) {
+    remove(temporary);
+    if (SDL_AtomicCAS(&warned, 0, 1)) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Couldn't write warm-start cache entries (%s, for %s)",
+                  cache_dir, key->path);
+    }
+    return;
+  }
+  SDL_AtomicAdd(&written, 1);
+}
+
+WarmCacheStats warm_cache_stats(void) {
+  return (WarmCacheStats){SDL_AtomicGet(&hits), SDL_AtomicGet(&misses),
+                          SDL_AtomicGet(&dropped), SDL_AtomicGet(&written)};
+}
+
+void warm_cache_log_report(void) {
+  if (cache_dir == NULL) {
+    return;
+  }
+  WarmCacheStats stats = warm_cache_stats();
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+              "Warm-start cache: %d assets read back, %d made afresh (%d "
+              "entries written, %d damaged ones dropped)",
+              stats.hits, stats.misses, stats.written, stats.dropped);
+}
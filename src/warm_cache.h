@@ -0,0 +1,89 @@
+//
+//  warm_cache.h
+//  Warm-start cache. Assets don't change between two launches of one build,
+//  yet every launch decoded the same images, converted the same WAVs to the
+//  audio device's format and parsed the same .anim, .cues, .words and .walk
+//  text. The loaders keep what they made in the user's pref dir instead, one
+//  LZ4-compressed entry per asset (lz4.h), and a later launch reads that
+//  back. An entry is keyed by the build and by the asset's stamp (its size and
+//  time, or its place in a pack: asset_stamp), so checking one costs a stat,
+//  never a read of the asset. Anything that doesn't match (another build,
+//  edited art, a damaged entry) is a miss: the loader does the work again and
+//  overwrites the entry, so the cache heals itself and never needs clearing.
+//
+
+#ifndef warm_cache_h
+#define warm_cache_h
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "asset.h"
+
+// Bumped whenever the entry layout changes. A new build misses anyway: its
+// entries may hold structs laid out differently.
+#define WARM_CACHE_VERSION 1
+
+// What an entry holds; each loader lays its own payload out.
+typedef enum warm_kind {
+  WARM_IMAGE, // a decoded surface (image.c)
+  WARM_AUDIO, // a chunk in the device's format (sound.c)
+  WARM_CLIPS, // an .anim's clips and trims (image.c)
+  WARM_CUES,  // a .cues sidecar's cues (lipsync.c)
+  WARM_WORDS, // a .words sidecar's timings and text (lipsync.c)
+  WARM_WALK,  // a .walk mask (walk.c)
+  WARM_KIND_COUNT,
+} WarmKind;
+
+// Where entries live: a directory path ending in its separator, as
+// SDL_GetPrefPath returns it. Copied. NULL (the default, and the tests')
+// turns the cache off. Set it before anything loads: the decode workers read
+// it unlocked.
+void warm_cache_set_dir(const char *dir);
+
+bool warm_cache_enabled(void);
+
+// One asset's entry: which file, what was made of it and, stamped when the
+// key is made, which bytes it was made from. `variant` tells apart what one
+// file can make (premultiplied pixels or not, the device's audio format);
+// each has an entry of its own.
+typedef struct warm_key {
+  WarmKind kind;
+  const char *path; // not copied
+  Uint64 variant;
+  AssetStamp stamp;
+  bool usable; // the cache is on and the file could be stamped
+} WarmKey;
+
+// Make the key before reading the asset, so an entry written after the work
+// describes the bytes the work saw.
+WarmKey warm_cache_key(WarmKind kind, const char *path, Uint64 variant);
+
+// The entry's payload, decompressed, when it was made by this build from the
+// same bytes; SDL_free it. NULL on a miss. A malformed entry is deleted.
+// Thread-safe.
+void *warm_cache_read(const WarmKey *key, size_t *size);
+
+// Store a payload as the key's entry, replacing any older one. Written beside
+// it and renamed over it, so a reader never sees half an entry. Thread-safe.
+void warm_cache_write(const WarmKey *key, const void *data, size_t size);
+
+// The file holding the key's entry; false if it doesn't fit `n` or the cache
+// is off. For tests.
+bool warm_cache_entry_path(const WarmKey *key, char *buf, size_t n);
+
+typedef struct warm_cache_stats {
+  int hits;
+  int misses;  // stale and malformed entries included
+  int dropped; // malformed entries deleted
+  int written;
+} WarmCacheStats;
+
+WarmCacheStats warm_cache_stats(void);
+
+// Log the totals above when the cache is on; game_load_media calls this once
+// media is up.
+void warm_cache_log_report(void);
+
+#endif /* warm_cache_h */
@@ -13,7 +13,9 @@
 #include "gina_hen_at_the_pool.h"
 #include "hub.h"
 #include "image.h"
+#include "profile.h"
 #include "subtitle.h"
+#include "trace.h"
 #include "vania_fox_the_slide.h"
 
 static SDL_Window *window = NULL;
@@ -40,6 +42,8 @@ bool harness_init(void) {
   // any actor/animation is created (game_load_media in harness_start_game), so
   // every start_time is on the virtual clock from the first frame.
   clock_set_virtual(true);
+  // $VANIA_TRACE=<file> traces the test run like the game's own.
+  TRACE_INIT();
 
   // Offscreen video + dummy audio: no display server, no sound card. Must be
   // set before SDL_Init so the subsystems pick these drivers.
@@ -106,6 +110,7 @@ void harness_shutdown(void) {
   SDL_DestroyRenderer(renderer);
   SDL_DestroyWindow(window);
   SDL_Quit();
+  TRACE_SHUTDOWN();
 }
 
 bool harness_start_game(void) {
@@ -129,6 +134,10 @@ bool harness_start_game(void) {
   register_adventures(&hub, all, LEN(all));
 
   game_init();
+  // Adventures load when entered, not whenever the decode threads get to them:
+  // what a run loads, and when, mustn't depend on the machine's timing.
+  // test_media turns streaming on to test it.
+  game_set_media_streaming(false);
   if (!game_load_media(renderer)) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "game_load_media failed");
     return false;
@@ -139,6 +148,8 @@ bool harness_start_game(void) {
   return true;
 }
 
+SDL_Renderer *harness_renderer(void) { return renderer; }
+
 // ── loop ─────────────────────────────────────────────────────────────────────
 
 static void process_input(void) {
@@ -164,6 +175,7 @@ void harness_step_frame(void) {
   SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
   SDL_RenderClear(renderer);
   game_render(renderer);
+  profile_end_frame();
 }
 
 void harness_pump_for(Uint32 ms) {
@@ -29,6 +29,9 @@ void harness_shutdown(void);
 // failure.
 bool harness_start_game(void);
 
+// The offscreen renderer, for tests that load or draw media themselves.
+SDL_Renderer *harness_renderer(void);
+
 // ── loop ─────────────────────────────────────────────────────────────────────
 
 // One game-loop iteration: drain input, update, render.
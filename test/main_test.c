@@ -12,13 +12,21 @@
 #include "harness.h"
 #include "play_gina.h"
 #include "play_vania.h"
+#include "test_arena.h"
 #include "test_camera.h"
 #include "test_confirm.h"
+#include "test_draw.h"
+#include "test_image.h"
 #include "test_input.h"
 #include "test_lipsync.h"
+#include "test_media.h"
+#include "test_pack.h"
+#include "test_profile.h"
 #include "test_scene.h"
+#include "test_trace.h"
 #include "test_tween.h"
 #include "test_walk.h"
+#include "test_warm_cache.h"
 
 int main(void) {
   // Install the log-capture sink before anything logs; the run's own
@@ -50,6 +58,20 @@ int main(void) {
   failures += test_camera();
   failures += test_confirm();
   failures += test_tween();
+  failures += test_arena();
+  // Writes its packs to the working directory and removes them.
+  failures += test_pack();
+  // Writes its entries to the working directory and removes them.
+  failures += test_warm_cache();
+  // Needs the loaded game's renderer and cache, but draws nothing itself.
+  failures += test_image();
+  // Steps frames of the hub and the depth demo, and leaves the hub up.
+  failures += test_draw();
+  // Steps frames of the depth demo, and leaves the hub up.
+  failures += test_profile();
+  failures += test_trace();
+  // Evicts and reloads adventures; leaves the hub up and the budget as it was.
+  failures += test_media();
 
   harness_shutdown();
 
@@ -0,0 +1,98 @@
+//
+//  test_arena.c
+//  Tests for the bump allocator (arena.{c,h}): allocations come back zeroed,
+//  aligned and packed into shared blocks, an oversized one gets a block of its
+//  own without wasting the current one, a reset gives everything back, and
+//  the scoped calls draw from the arena in force or else the heap — freeing
+//  only what the heap handed out.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "test_arena.h"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+// ── bump allocation ──────────────────────────────────────────────────────────
+
+static void test_bump(void) {
+  Arena arena = {0};
+  check(arena.reserved == 0, "arena: an empty arena holds no memory");
+
+  Uint8 *a = arena_alloc(&arena, 3);
+  Uint8 *b = arena_alloc(&arena, 40);
+  check(a != NULL && b != NULL && a[0] == 0 && a[2] == 0 && b[39] == 0,
+        "arena: allocations come back zeroed");
+  check((uintptr_t)a % 16 == 0 && (uintptr_t)b % 16 == 0 && b == a + 16,
+        "arena: allocations are aligned and packed");
+  check(arena.used == 16 + 48 && arena.reserved == ARENA_BLOCK_SIZE,
+        "arena: small allocations share one block");
+
+  Uint8 *big = arena_alloc(&arena, ARENA_BLOCK_SIZE * 2);
+  Uint8 *after = arena_alloc(&arena, 8);
+  check(big != NULL && after == b + 48 &&
+            arena.reserved == ARENA_BLOCK_SIZE * 3,
+        "arena: an oversized allocation gets its own block, the current "
+        "one's tail still used");
+  check(arena_owns(&arena, a) && arena_owns(&arena, big + 100) &&
+            !arena_owns(&arena, &arena),
+        "arena: it knows its own memory");
+
+  arena_reset(&arena);
+  check(arena.used == 0 && arena.reserved == 0 && arena.blocks == NULL,
+        "arena: a reset gives back every block");
+  check(arena_alloc(&arena, 8) != NULL && arena.reserved == ARENA_BLOCK_SIZE,
+        "arena: a reset arena is reusable");
+  arena_reset(&arena);
+}
+
+// ── scoped allocation ────────────────────────────────────────────────────────
+
+static void test_scoped(void) {
+  Arena arena = {0};
+  char *heap = arena_scoped_strdup("heap");
+  check(heap != NULL && strcmp(heap, "heap") == 0 && arena.used == 0,
+        "arena: with none in force, scoped allocations use the heap");
+
+  Arena *previous = arena_use(&arena);
+  char *line = arena_scoped_strdup("a line of dialogue");
+  int *numbers = arena_scoped_alloc(sizeof(int) * 4);
+  check(previous == NULL && arena_owns(&arena, line) &&
+            arena_owns(&arena, numbers) && numbers[3] == 0 &&
+            strcmp(line, "a line of dialogue") == 0,
+        "arena: in force, scoped allocations come from the arena");
+  size_t used = arena.used;
+  arena_scoped_free(line);
+  check(arena.used == used && strcmp(line, "a line of dialogue") == 0,
+        "arena: freeing arena memory one object at a time is a no-op");
+  check(arena_use(previous) == &arena && arena_scoped_strdup(NULL) == NULL,
+        "arena: the caller puts back the one it replaced");
+
+  // Heap memory is really freed even with an arena in force (ASan would
+  // report a leak otherwise).
+  arena_use(&arena);
+  arena_scoped_free(heap);
+  arena_use(previous);
+  arena_reset(&arena);
+}
+
+int test_arena(void) {
+  failures = 0;
+  test_bump();
+  test_scoped();
+  return failures;
+}
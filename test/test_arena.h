@@ -0,0 +1,11 @@
+//
+//  test_arena.h
+//
+
+#ifndef test_arena_h
+#define test_arena_h
+
+// Runs the arena unit tests; returns the number of failed checks.
+int test_arena(void);
+
+#endif /* test_arena_h */
@@ -0,0 +1,115 @@
+//
+//  test_draw.c
+//  Tests for the per-frame draw counters (draw.{c,h}): what each counted call
+//  adds, and an overdraw budget for whole frames of the hub and the depth
+//  demo's field, so a change that balloons a screen's fill cost fails here.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "depth_demo.h"
+#include "draw.h"
+#include "game.h"
+#include "harness.h"
+#include "test_draw.h"
+
+// Screens of pixels a whole frame may fill. The field, the heaviest screen
+// (four planes, props and the fox), is about 3.5.
+#define OVERDRAW_BUDGET 5.0
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+static double overdraw(DrawStats stats) {
+  return (double)stats.pixels / ((double)WINDOW_WIDTH * WINDOW_HEIGHT);
+}
+
+// One frame of whatever is on screen: it covers the window at least once and
+// stays within the budget.
+static void check_frame(const char *screen) {
+  harness_step_frame();
+  DrawStats stats = draw_stats_frame();
+  fprintf(stderr,
+          "      %s: %d draws, %d texture binds, %.2fx overdraw, %d blend "
+          "changes\n",
+          screen, stats.draw_calls, stats.texture_binds, overdraw(stats),
+          stats.blend_changes);
+  char what[128];
+  SDL_snprintf(what, sizeof(what), "a %s frame fills the window within %.0fx",
+               screen, OVERDRAW_BUDGET);
+  check(overdraw(stats) >= 1.0 && overdraw(stats) <= OVERDRAW_BUDGET, what);
+}
+
+int test_draw(void) {
+  failures = 0;
+  fprintf(stderr, "\n-- draw counter tests --\n");
+  SDL_Renderer *renderer = harness_renderer();
+
+  // ── what each call counts ─────────────────────────────────────────────────
+
+  // Drawn into a scratch target so nothing reaches the harness's frame.
+  SDL_Texture *target =
+      SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                        SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
+  SDL_Texture *a = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_STATIC, 8, 8);
+  SDL_Texture *b = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_STATIC, 8, 8);
+  bool ready = target != NULL && a != NULL && b != NULL &&
+               SDL_SetRenderTarget(renderer, target) == 0;
+  check(ready, "scratch textures and target");
+  if (ready) {
+    SDL_SetTextureBlendMode(a, SDL_BLENDMODE_NONE);
+    SDL_SetTextureBlendMode(b, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_Rect quad = {10, 10, 100, 100};
+    draw_stats_begin_frame();
+    draw_copy(renderer, a, NULL, &quad);
+    draw_copy(renderer, a, NULL, &quad);
+    draw_copy_ex(renderer, b, NULL, &quad, 0, NULL, SDL_FLIP_HORIZONTAL);
+    draw_fill_rect(renderer, &((SDL_Rect){0, 0, 10, 10}));
+    // Half off the right edge, and entirely off the top: only what lands
+    // in the window counts.
+    draw_fill_rect(renderer, &((SDL_Rect){WINDOW_WIDTH - 10, 0, 20, 10}));
+    draw_fill_rect(renderer, &((SDL_Rect){0, -20, 10, 10}));
+    draw_line(renderer, 0, 0, 9, 3);
+    DrawStats stats = draw_stats_frame();
+    check(stats.draw_calls == 7, "every call counts as a draw");
+    check(stats.texture_binds == 2,
+          "a texture is bound once per run of copies from it");
+    check(stats.pixels == 3 * 100 * 100 + 100 + 100 + 0 + 10,
+          "pixels are the destination areas clipped to the window");
+    // NONE (a), BLEND (b), then the fills back at NONE.
+    check(stats.blend_changes == 3, "blend changes count mode switches");
+    draw_stats_begin_frame();
+    check(draw_stats_previous().draw_calls == 7 &&
+              draw_stats_frame().draw_calls == 0,
+          "a new frame starts from zero and keeps the finished one");
+    SDL_SetRenderTarget(renderer, NULL);
+  }
+  SDL_DestroyTexture(a);
+  SDL_DestroyTexture(b);
+  SDL_DestroyTexture(target);
+
+  // ── whole frames ──────────────────────────────────────────────────────────
+
+  return_to_hub();
+  check_frame("hub");
+  adventure_switch_to(&depth_demo);
+  check_frame("depth demo field");
+  return_to_hub();
+  harness_step_frame();
+
+  return failures;
+}
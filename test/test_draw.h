@@ -0,0 +1,12 @@
+//
+//  test_draw.h
+//
+
+#ifndef test_draw_h
+#define test_draw_h
+
+// Runs the draw-counter tests against the started game; returns the number of
+// failed checks.
+int test_draw(void);
+
+#endif /* test_draw_h */
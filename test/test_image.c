@@ -0,0 +1,601 @@
+//
+//  test_image.c
+//  Tests for image loading (image.{c,h}): the shared texture cache that lets
+//  two ImageData naming one file share a single decode and upload, opaque-art
+//  detection, resolution tiers, QOI decoding,
+//  premultiplied alpha, paged planes, the trimmed-frame .anim rows with
+//  their per-frame offsets, the trimmed twins of a sheet, and clip tables
+//  compiled in in place of .anim files.
+//
+
+#include <SDL2/SDL.h>
+#include <SDL2_image/SDL_image.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "depth_demo.h"
+#include "game.h"
+#include "harness.h"
+#include "image.h"
+#include "qoi.h"
+#include "test_image.h"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+// The opaque colour the premultiplied-alpha draws go over.
+static const Uint8 FILL[3] = {200, 100, 50};
+
+// Draw row's first line with mode over FILL into a target texture and read
+// the result back as RGBA32; false where the renderer can't.
+static bool draw_over_fill(SDL_Renderer *renderer, SDL_Surface *row,
+                           SDL_BlendMode mode, Uint8 *out) {
+  SDL_Rect clip = {0, 0, row->w, 1};
+  SDL_Texture *target = SDL_CreateTexture(
+      renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, row->w, 1);
+  SDL_Texture *sprite = SDL_CreateTextureFromSurface(renderer, row);
+  bool read = target != NULL && sprite != NULL &&
+              SDL_SetTextureBlendMode(sprite, mode) == 0 &&
+              SDL_SetRenderTarget(renderer, target) == 0;
+  if (read) {
+    SDL_SetRenderDrawColor(renderer, FILL[0], FILL[1], FILL[2], 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, sprite, &clip, &clip);
+    read = SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGBA32, out,
+                                row->w * 4) == 0;
+    SDL_SetRenderTarget(renderer, NULL);
+  }
+  SDL_DestroyTexture(sprite);
+  SDL_DestroyTexture(target);
+  return read;
+}
+
+// The largest colour difference between two RGBA32 rows of width pixels.
+static int worst_channel_difference(const Uint8 *a, const Uint8 *b,
+                                    int width) {
+  int worst = 0;
+  for (int i = 0; i < width * 4; i++) {
+    if (i % 4 != 3) {
+      worst = SDL_max(worst, SDL_abs(a[i] - b[i]));
+    }
+  }
+  return worst;
+}
+
+int test_image(void) {
+  failures = 0;
+  fprintf(stderr, "\n-- image unit tests --\n");
+  SDL_Renderer *renderer = harness_renderer();
+
+  // ── texture cache ─────────────────────────────────────────────────────────
+
+  // Every scene of an adventure carries its own actor, and each loads the
+  // same sheets: startup alone must already have shared some textures.
+  TextureCacheStats started = texture_cache_stats();
+  check(started.hits > 0 && started.bytes_saved > 0,
+        "startup media shares duplicate textures");
+
+  // The hub background is already cached by the hub; two more loads of it
+  // are hits, not decodes, and hand back the very same texture.
+  ImageData a = {0};
+  ImageData b = {0};
+  check(load_image_from_path(renderer, &a, "assets/hub/background.png") &&
+            load_image_from_path(renderer, &b, "assets/hub/background.png"),
+        "a cached file loads twice");
+  TextureCacheStats after = texture_cache_stats();
+  check(a.texture != NULL && a.texture == b.texture && a.width == b.width &&
+            a.height == b.height && a.width > 0,
+        "both loads share one texture and its size");
+  check(after.loads == started.loads && after.hits == started.hits + 2,
+        "a repeat load costs no decode");
+
+  // Freeing one reference leaves the texture alive for the others.
+  SDL_Texture *shared = b.texture;
+  free_image_texture(&a);
+  check(a.texture == NULL && SDL_QueryTexture(shared, NULL, NULL, NULL,
+                                              NULL) == 0,
+        "freeing one holder keeps the shared texture alive");
+  free_image_texture(&b);
+  check(texture_cache_stats().entries == started.entries,
+        "giving back every extra reference leaves the cache as it was");
+
+  // ── opaque detection ──────────────────────────────────────────────────────
+
+  // 67 px wide: a SIMD-sized body plus a scalar tail, so a transparent pixel
+  // is caught in either part of the scan.
+  SDL_Surface *solid =
+      SDL_CreateRGBSurfaceWithFormat(0, 67, 9, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_FillRect(solid, NULL, SDL_MapRGBA(solid->format, 10, 20, 30, 255));
+  check(surface_is_opaque(solid), "a fully opaque surface is opaque");
+  Uint32 *pixels = (Uint32 *)solid->pixels;
+  Uint32 *last_row = (Uint32 *)((Uint8 *)solid->pixels + 8 * solid->pitch);
+  last_row[66] = SDL_MapRGBA(solid->format, 10, 20, 30, 254);
+  check(!surface_is_opaque(solid), "one translucent pixel in the tail counts");
+  last_row[66] = SDL_MapRGBA(solid->format, 10, 20, 30, 255);
+  pixels[5] = SDL_MapRGBA(solid->format, 10, 20, 30, 0);
+  check(!surface_is_opaque(solid), "one clear pixel in the body counts");
+  SDL_FreeSurface(solid);
+
+  // Loaded art: the hub's background plate has no transparency, the back
+  // button's rounded corners do.
+  ImageData background = {0};
+  ImageData button = {0};
+  SDL_BlendMode background_mode = SDL_BLENDMODE_BLEND;
+  SDL_BlendMode button_mode = SDL_BLENDMODE_NONE;
+  if (load_image_from_path(renderer, &background,
+                           "assets/hub/background.png") &&
+      load_image_from_path(renderer, &button, "assets/ui/hub_button.png")) {
+    SDL_GetTextureBlendMode(background.texture, &background_mode);
+    SDL_GetTextureBlendMode(button.texture, &button_mode);
+  }
+  check(background_mode == SDL_BLENDMODE_NONE,
+        "an opaque background is drawn without blending");
+  check(button_mode == image_blend_mode(renderer),
+        "art with transparent pixels is alpha blended (premultiplied where "
+        "the renderer can)");
+  free_image_texture(&background);
+  free_image_texture(&button);
+
+  // ── resolution tiers ──────────────────────────────────────────────────────
+
+  check(image_tier_for_scale(0.4F) == 0.5F &&
+            image_tier_for_scale(0.5F) == 0.5F,
+        "a display at half scale or less takes the half tier");
+  check(image_tier_for_scale(0.75F) == 1.0F &&
+            image_tier_for_scale(1.0F) == 1.0F &&
+            image_tier_for_scale(2.0F) == 1.0F,
+        "anything larger loads the full-size art");
+  check(image_display_scale(renderer) == 1.0F,
+        "the harness renders at its logical size");
+
+  // An odd-sized image with a half-size sibling. On a renderer whose logical
+  // size is twice its output the variant is the one uploaded, yet the image
+  // keeps its full size for layout and drawing.
+  SDL_Surface *full =
+      SDL_CreateRGBSurfaceWithFormat(0, 21, 13, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Surface *half =
+      SDL_CreateRGBSurfaceWithFormat(0, 11, 7, 32, SDL_PIXELFORMAT_RGBA32);
+  IMG_SavePNG(full, "test_tier.png");
+  IMG_SavePNG(half, "test_tier@0.5x.png");
+  SDL_FreeSurface(full);
+  SDL_FreeSurface(half);
+  int logical_w;
+  int logical_h;
+  int out_w = 0;
+  int out_h = 0;
+  SDL_RenderGetLogicalSize(renderer, &logical_w, &logical_h);
+  SDL_GetRendererOutputSize(renderer, &out_w, &out_h);
+  SDL_RenderSetLogicalSize(renderer, out_w * 2, out_h * 2);
+  ImageData tiered = {0};
+  int texture_w = 0;
+  int texture_h = 0;
+  if (load_image_from_path(renderer, &tiered, "test_tier.png")) {
+    SDL_QueryTexture(tiered.texture, NULL, NULL, &texture_w, &texture_h);
+  }
+  check(texture_w == 11 && texture_h == 7 && tiered.tier_scale == 0.5F,
+        "a half-scale display uploads the half tier");
+  check(tiered.width == 21 && tiered.height == 13,
+        "a tiered image measures at its full size");
+  free_image_texture(&tiered);
+  SDL_RenderSetLogicalSize(renderer, logical_w, logical_h);
+  ImageData untiered = {0};
+  texture_w = 0;
+  if (load_image_from_path(renderer, &untiered, "test_tier.png")) {
+    SDL_QueryTexture(untiered.texture, NULL, NULL, &texture_w, NULL);
+  }
+  check(texture_w == 21 && untiered.width == 21 && untiered.tier_scale == 1.0F,
+        "at full scale the original is uploaded");
+  free_image_texture(&untiered);
+  remove("test_tier.png");
+  remove("test_tier@0.5x.png");
+
+  // A clip on odd coordinates covers full-size pixels 3..9 x 5..13; at the
+  // half tier its edges move inward to tier pixels 2..4 x 3..6, where
+  // rounding origin and size to nearest would take in tier pixel 5 (the
+  // next frame's column 10).
+  AnimationData *odd = make_animation_data(1, LOOP);
+  odd->sprite_clips[0] = (SDL_Rect){3, 5, 7, 9};
+  SDL_Rect whole_clip = animation_texture_clip(odd);
+  odd->image.tier_scale = 0.5F;
+  SDL_Rect half_clip = animation_texture_clip(odd);
+  check(whole_clip.x == 3 && whole_clip.w == 7 && half_clip.x == 2 &&
+            half_clip.y == 3 && half_clip.w == 3 && half_clip.h == 4,
+        "a half-tier clip stays inside its frame");
+  free_animation(odd);
+
+  // ── QOI ───────────────────────────────────────────────────────────────────
+
+  // A 3x2 image that takes every QOI op once — RGB, a run, a small diff, RGBA,
+  // an index hit, a luma step — as tools/gen_qoi.py encodes it.
+  static const Uint8 QOI[] = {
+      0x71, 0x6F, 0x69, 0x66, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02,
+      0x04, 0x00, 0xFE, 0x0A, 0x14, 0x1E, 0xC0, 0x77, 0xFF, 0x28, 0x1E, 0x14,
+      0x80, 0x09, 0xA6, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+  static const Uint8 QOI_PIXELS[2][12] = {
+      {10, 20, 30, 255, 10, 20, 30, 255, 11, 19, 31, 255},
+      {40, 30, 20, 128, 10, 20, 30, 255, 14, 26, 33, 255}};
+  SDL_Surface *decoded = qoi_decode(QOI, sizeof(QOI));
+  check(decoded != NULL && decoded->w == 3 && decoded->h == 2 &&
+            decoded->format->format == SDL_PIXELFORMAT_RGBA32,
+        "a QOI image decodes to an RGBA32 surface");
+  bool same = decoded != NULL;
+  for (int y = 0; same && y < 2; y++) {
+    same = SDL_memcmp((const Uint8 *)decoded->pixels + y * decoded->pitch,
+                      QOI_PIXELS[y], sizeof(QOI_PIXELS[y])) == 0;
+  }
+  check(same, "every QOI op decodes to its pixel");
+  SDL_FreeSurface(decoded);
+  check(qoi_decode(QOI, sizeof(QOI) - 10) == NULL,
+        "a truncated QOI image is rejected");
+
+  // ── premultiplied alpha ───────────────────────────────────────────────────
+
+  // 67 pixels a row: the SIMD body plus a scalar tail. Each channel must come
+  // out as round(c * a / 255), alpha untouched.
+  SDL_Surface *straight =
+      SDL_CreateRGBSurfaceWithFormat(0, 67, 3, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Surface *premultiplied =
+      SDL_ConvertSurfaceFormat(straight, SDL_PIXELFORMAT_RGBA32, 0);
+  Uint32 seed = 12345;
+  for (int y = 0; y < straight->h; y++) {
+    Uint8 *row = (Uint8 *)straight->pixels + y * straight->pitch;
+    for (int i = 0; i < straight->w * 4; i++) {
+      seed = seed * 1103515245U + 12345U;
+      row[i] = (Uint8)(seed >> 16);
+    }
+    SDL_memcpy((Uint8 *)premultiplied->pixels + y * premultiplied->pitch, row,
+               (size_t)straight->w * 4);
+  }
+  check(premultiply_surface(premultiplied), "an RGBA32 surface premultiplies");
+  bool exact = true;
+  for (int y = 0; y < straight->h; y++) {
+    const Uint8 *in = (const Uint8 *)straight->pixels + y * straight->pitch;
+    const Uint8 *out =
+        (const Uint8 *)premultiplied->pixels + y * premultiplied->pitch;
+    for (int x = 0; x < straight->w; x++) {
+      int a = in[4 * x + 3];
+      for (int c = 0; c < 3; c++) {
+        exact = exact && out[4 * x + c] == (in[4 * x + c] * a + 127) / 255;
+      }
+      exact = exact && out[4 * x + 3] == a;
+    }
+  }
+  check(exact, "every channel is rounded c * a / 255, alpha kept");
+  SDL_Surface *rgb = SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 24,
+                                                    SDL_PIXELFORMAT_RGB24);
+  check(rgb != NULL && !premultiply_surface(rgb),
+        "a format without alpha is left alone");
+  SDL_FreeSurface(rgb);
+
+  // Unscaled draws must look the same either way. The harness draws with the
+  // software renderer, which refuses every custom blend mode, so there
+  // image_blend_mode has to fall back to straight alpha (and the loader then
+  // leaves sprites unpremultiplied).
+  SDL_RendererInfo info = {0};
+  bool software = SDL_GetRendererInfo(renderer, &info) == 0 &&
+                  (info.flags & SDL_RENDERER_SOFTWARE) != 0;
+  check(!software || image_blend_mode(renderer) == SDL_BLENDMODE_BLEND,
+        "the software renderer falls back to straight alpha");
+
+  // On it the premultiplied side can only be simulated on the CPU: the
+  // composite the custom mode asks for, p + d * (255 - a) / 255, worked out
+  // here and held against the renderer drawing the straight row with BLEND.
+  // That checks the premultiplied pixels, not any GPU's blending.
+  static Uint8 drawn[2][67 * 4];
+  bool read =
+      draw_over_fill(renderer, straight, SDL_BLENDMODE_BLEND, drawn[0]);
+  const Uint8 *p = premultiplied->pixels;
+  for (int i = 0; i < premultiplied->w * 4; i += 4) {
+    for (int c = 0; c < 3; c++) {
+      drawn[1][i + c] =
+          (Uint8)(p[i + c] + (FILL[c] * (255 - p[i + 3]) + 127) / 255);
+    }
+    drawn[1][i + 3] = 255;
+  }
+  check(read && worst_channel_difference(drawn[0], drawn[1], straight->w) <= 2,
+        "premultiplied pixels composite like their straight-alpha originals "
+        "(a CPU simulation of the blend)");
+
+  // The blend itself is read back from a GPU renderer where one can be made
+  // beside the harness's (a hidden window; the offscreen video driver has
+  // one where EGL is available).
+  SDL_Window *gpu_window = SDL_CreateWindow(
+      "premultiply", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+      straight->w, 1, SDL_WINDOW_HIDDEN);
+  SDL_Renderer *gpu =
+      gpu_window == NULL
+          ? NULL
+          : SDL_CreateRenderer(gpu_window, -1,
+                               SDL_RENDERER_ACCELERATED |
+                                   SDL_RENDERER_TARGETTEXTURE);
+  SDL_BlendMode gpu_blend =
+      gpu == NULL ? SDL_BLENDMODE_BLEND : image_blend_mode(gpu);
+  if (gpu_blend == SDL_BLENDMODE_BLEND) {
+    fprintf(stderr, "SKIP  premultiplied read-back: no GPU renderer with "
+                    "custom blending here\n");
+  } else {
+    read = draw_over_fill(gpu, straight, SDL_BLENDMODE_BLEND, drawn[0]) &&
+           draw_over_fill(gpu, premultiplied, gpu_blend, drawn[1]);
+    check(read &&
+              worst_channel_difference(drawn[0], drawn[1], straight->w) <= 2,
+          "a premultiplied sprite draws like its straight-alpha original on "
+          "the GPU (to within rounding)");
+  }
+  if (gpu != NULL) {
+    SDL_DestroyRenderer(gpu);
+  }
+  if (gpu_window != NULL) {
+    SDL_DestroyWindow(gpu_window);
+  }
+  // The probe cache named the renderer just destroyed; point it back.
+  image_blend_mode(renderer);
+  SDL_FreeSurface(straight);
+  SDL_FreeSurface(premultiplied);
+
+  // ── paged planes ──────────────────────────────────────────────────────────
+
+  // The depth demo's 1600px ground outgrows the window by more than a tile,
+  // so it loaded paged, 4 x 2 tiles; the 1120px hills loaded whole. Its media
+  // loads when it is entered.
+  adventure_switch_to(&depth_demo);
+  const Scene *field = &depth_demo.scenes[FIELD];
+  const ImageData *ground = &field->bg_planes[2].image;
+  check(ground->tiles != NULL && ground->texture == NULL &&
+            image_tile_stats(ground).tiles == 8,
+        "an oversized plane loads as tiles");
+  check(image_tile_stats(&field->bg_planes[1].image).tiles == 0,
+        "a plane within a tile of the window loads whole");
+
+  // Released, it gives back the decoded pixels it cuts tiles from as well;
+  // warming the scene as a neighbour decodes them again, and pages in no
+  // more than it is allowed.
+  size_t paged_in = texture_cache_stats().bytes_resident;
+  image_release_tiles(ground);
+  check(texture_cache_stats().bytes_resident < paged_in,
+        "releasing a plane's tiles frees its decoded pixels");
+  check(prepage_scene_planes(renderer, field, 1) == 1 &&
+            image_tile_stats(ground).resident == 1 &&
+            prepage_scene_planes(renderer, field, 0) == 0,
+        "warming a scene's planes keeps to its upload allowance");
+
+  // Paging brings in the tiles under the view a couple per call, and lets go
+  // of those left well behind it.
+  image_release_tiles(ground);
+  SDL_Rect left = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+  image_page_tiles(renderer, ground, left);
+  check(image_tile_stats(ground).resident == 2,
+        "paging uploads a couple of tiles per call");
+  image_page_tiles(renderer, ground, left);
+  image_page_tiles(renderer, ground, left);
+  check(image_tile_stats(ground).resident == 4,
+        "successive calls bring in every tile under the view, and no more");
+  SDL_Rect right = {800, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+  for (int i = 0; i < 4; i++) {
+    image_page_tiles(renderer, ground, right);
+  }
+  check(image_tile_stats(ground).resident == 6,
+        "scrolling right pages in its columns and releases the first");
+
+  // Drawn from its tiles, the plane is pixel-for-pixel the file uploaded
+  // whole — including across the tile seams, and once released and decoded
+  // again.
+  image_release_tiles(ground);
+  ImageData whole = {0};
+  size_t frame_bytes = (size_t)WINDOW_WIDTH * WINDOW_HEIGHT * 4;
+  Uint8 *tiled_px = SDL_malloc(frame_bytes);
+  Uint8 *whole_px = SDL_malloc(frame_bytes);
+  SDL_Texture *frame =
+      SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                        SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
+  bool drawn_both =
+      tiled_px != NULL && whole_px != NULL && frame != NULL &&
+      load_image_from_path(
+          renderer, &whole,
+          "src/adventures/depth_demo/assets/common/field/ground.png");
+  // Scaled (as a tween or a depth ramp draws it), and scaled mirrored, the
+  // tiles land where the whole image's pixels do; only a sampling step may
+  // differ where a tile edge falls, so a sliver of pixels is allowed.
+  for (int mode = 0; mode < 3; mode++) {
+    for (int pass = 0; drawn_both && pass < 2; pass++) {
+      drawn_both = SDL_SetRenderTarget(renderer, frame) == 0;
+      if (drawn_both) {
+        const ImageData *plane = pass == 0 ? ground : &whole;
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        if (mode == 0) {
+          render_image(renderer, plane, (SDL_Point){-500, -10});
+        } else if (mode == 1) {
+          render_image_scaled(renderer, plane, (SDL_Point){-300, 50}, 0.75F);
+        } else {
+          render_image_scaled_about(renderer, plane, (SDL_Point){-100, 0},
+                                    0.5F, (SDL_Point){400, 300},
+                                    SDL_FLIP_HORIZONTAL);
+        }
+        drawn_both =
+            SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGBA32,
+                                 pass == 0 ? tiled_px : whole_px,
+                                 WINDOW_WIDTH * 4) == 0;
+        SDL_SetRenderTarget(renderer, NULL);
+      }
+    }
+    if (mode == 0) {
+      check(drawn_both && SDL_memcmp(tiled_px, whole_px, frame_bytes) == 0,
+            "a paged plane draws exactly like the whole image");
+      continue;
+    }
+    size_t differing = 0;
+    for (size_t i = 0; drawn_both && i < frame_bytes; i += 4) {
+      differing += SDL_memcmp(tiled_px + i, whole_px + i, 4) != 0;
+    }
+    check(drawn_both && differing * 100 <= frame_bytes / 4,
+          mode == 1 ? "a paged plane draws scaled like the whole image"
+                    : "a paged plane draws scaled and mirrored like the "
+                      "whole image");
+  }
+  free_image_texture(&whole);
+  SDL_DestroyTexture(frame);
+  SDL_free(tiled_px);
+  SDL_free(whole_px);
+  image_release_tiles(ground);
+  return_to_hub();
+
+  // ── trimmed frames ────────────────────────────────────────────────────────
+
+  // Frame 0 is a 40x60 crop taken from (30, 50) of a 120x120 cell; frame 1 is
+  // a plain untrimmed row.
+  static const char TRIMMED[] = "0,0,40,60,30,50,120,120\n0,60,120,120\n";
+  AnimationData *trimmed = make_animation_data(2, LOOP);
+  check(parse_animation_data(trimmed, TRIMMED, sizeof(TRIMMED) - 1),
+        "an .anim mixing trimmed and plain rows parses");
+  SDL_Point cell = animation_frame_size(trimmed, 0);
+  check(cell.x == 120 && cell.y == 120,
+        "a trimmed frame measures as its whole cell");
+  SDL_Rect quad = animation_frame_quad(trimmed, (SDL_Point){100, 200});
+  check(quad.x == 130 && quad.y == 250 && quad.w == 40 && quad.h == 60,
+        "a trimmed clip draws at its offset in the cell");
+  trimmed->flip = SDL_FLIP_HORIZONTAL;
+  quad = animation_frame_quad(trimmed, (SDL_Point){100, 200});
+  check(quad.x == 100 + 120 - 30 - 40 && quad.y == 250,
+        "mirroring the sprite mirrors the trim offset about the cell");
+  trimmed->flip = SDL_FLIP_NONE;
+  trimmed->current_frame = 1;
+  quad = animation_frame_quad(trimmed, (SDL_Point){100, 200});
+  cell = animation_frame_size(trimmed, 1);
+  check(quad.x == 100 && quad.y == 200 && quad.w == 120 && cell.x == 120,
+        "an untrimmed row is its own cell");
+
+  // A crop that would spill out of its cell is a broken file, not a frame.
+  static const char SPILL[] = "0,0,40,60,90,50,120,120\n0,60,120,120\n";
+  check(!parse_animation_data(trimmed, SPILL, sizeof(SPILL) - 1),
+        "a trimmed clip larger than its cell is rejected");
+  static const char SHORT[] = "0,0,40,60,30,50\n0,60,120,120\n";
+  check(!parse_animation_data(trimmed, SHORT, sizeof(SHORT) - 1),
+        "a row with neither 4 nor 8 fields is rejected");
+  free_animation(trimmed);
+
+  // ── trimmed twins ─────────────────────────────────────────────────────────
+
+  // make trim writes the hen's walk as walking.trim.{png,anim} beside the
+  // authored sheet, and its tier cut from the authored tier. The loader takes
+  // the pair; each tier frame, a pixel of border included, is the authored
+  // tier's pixels at the same place in the cell: no edge was resampled from
+  // the packed strip, and no neighbour leaks in.
+  static const char HEN[] =
+      "src/adventures/gina_hen_at_the_pool/assets/common/hen/walking";
+  char hen_path[4][256];
+  static const char *HEN_SUFFIX[4] = {".anim", ".trim.anim", "@0.5x.png",
+                                      ".trim@0.5x.png"};
+  for (int i = 0; i < 4; i++) {
+    SDL_snprintf(hen_path[i], sizeof(hen_path[i]), "%s%s", HEN, HEN_SUFFIX[i]);
+  }
+  SDL_Surface *hen_tier[2] = {IMG_Load(hen_path[2]), IMG_Load(hen_path[3])};
+  char *hen_text[2] = {SDL_LoadFile(hen_path[0], NULL),
+                       SDL_LoadFile(hen_path[1], NULL)};
+  if (hen_tier[0] == NULL || hen_tier[1] == NULL || hen_text[0] == NULL ||
+      hen_text[1] == NULL) {
+    fprintf(stderr, "SKIP  trimmed twins: run make trim first\n");
+  } else {
+    AnimationData *hen = make_animation_data(4, LOOP);
+    AnimationData *cells = make_animation_data(4, LOOP);
+    SDL_snprintf(hen_path[2], sizeof(hen_path[2]), "%s.png", HEN);
+    check(load_animation_from_path(renderer, hen, hen_path[2], hen_path[0]) &&
+              hen->frame_trims[0].w == 120 &&
+              hen->image.height < 4 * 120,
+          "an animation with trimmed twins loads them, clips and all");
+    check(parse_animation_data(cells, hen_text[0], SDL_strlen(hen_text[0])),
+          "the authored .anim still parses");
+    SDL_Surface *tiers[2];
+    for (int i = 0; i < 2; i++) {
+      tiers[i] = SDL_ConvertSurfaceFormat(hen_tier[i], SDL_PIXELFORMAT_RGBA32,
+                                          0);
+    }
+    int differ = 0;
+    for (int f = 0; f < 4; f++) {
+      SDL_Rect clip = hen->sprite_clips[f];
+      SDL_Rect trim = hen->frame_trims[f];
+      SDL_Rect cell_rect = cells->sprite_clips[f];
+      for (int y = -1; y <= (clip.h + 1) / 2; y++) {
+        for (int x = -1; x <= (clip.w + 1) / 2; x++) {
+          int ux = (cell_rect.x + trim.x) / 2 + x;
+          int uy = (cell_rect.y + trim.y) / 2 + y;
+          if (ux < cell_rect.x / 2 || uy < cell_rect.y / 2 ||
+              ux >= (cell_rect.x + cell_rect.w) / 2 ||
+              uy >= (cell_rect.y + cell_rect.h) / 2) {
+            continue; // the untrimmed frame ends there too
+          }
+          const Uint32 *authored = tiers[0]->pixels;
+          const Uint32 *twin = tiers[1]->pixels;
+          Uint32 a = authored[uy * tiers[0]->pitch / 4 + ux];
+          Uint32 b = twin[(clip.y / 2 + y) * tiers[1]->pitch / 4 +
+                          clip.x / 2 + x];
+          differ += a != b;
+        }
+      }
+    }
+    check(differ == 0, "a trimmed tier's frames and borders match the "
+                       "untrimmed tier's");
+    for (int i = 0; i < 2; i++) {
+      SDL_FreeSurface(tiers[i]);
+    }
+    free_image_texture(&hen->image);
+    free_animation(hen);
+    free_animation(cells);
+  }
+  for (int i = 0; i < 2; i++) {
+    SDL_FreeSurface(hen_tier[i]);
+    SDL_free(hen_text[i]);
+  }
+
+  // ── compiled-in clips ─────────────────────────────────────────────────────
+
+  // A table registered for a root with no such file on disk: loading from it
+  // can only have come from the table.
+  static const SDL_Rect CLIPS[] = {{0, 0, 40, 60}, {0, 60, 120, 120}};
+  static const SDL_Rect TRIMS[] = {{30, 50, 120, 120}, {0, 0, 0, 0}};
+  static const AnimationClips TABLES[] = {
+      {"common/props/plain.anim", 2, CLIPS, NULL},
+      {"common/props/trimmed.anim", 2, CLIPS, TRIMS},
+  };
+  register_animation_clips("test_clips_root", TABLES, 2);
+  AnimationClipStats clips_before = animation_clip_stats();
+  AnimationData *untrimmed = make_animation_data(2, LOOP);
+  AnimationData *cropped = make_animation_data(2, LOOP);
+  check(load_animation_from_path(renderer, untrimmed,
+                                 "assets/hub/background.png",
+                                 "test_clips_root/common/props/plain.anim") &&
+            untrimmed->sprite_clips[1].y == 60 &&
+            untrimmed->frame_trims[0].w == 0,
+        "a registered clip table stands in for its .anim file");
+  check(load_animation_from_path(renderer, cropped,
+                                 "assets/hub/background.png",
+                                 "test_clips_root/common/props/trimmed.anim") &&
+            animation_frame_size(cropped, 0).x == 120 &&
+            animation_frame_size(cropped, 1).x == 120,
+        "a compiled-in table carries its trims");
+  AnimationClipStats clips_after = animation_clip_stats();
+  check(clips_after.compiled_in == clips_before.compiled_in + 2 &&
+            clips_after.parsed == clips_before.parsed,
+        "compiled-in tables parse nothing");
+  free_animation(untrimmed);
+  free_animation(cropped);
+
+  // Made with another frame count than the table has: refused, as a short
+  // .anim would be.
+  AnimationData *longer = make_animation_data(3, LOOP);
+  check(!load_animation_from_path(renderer, longer,
+                                  "assets/hub/background.png",
+                                  "test_clips_root/common/props/plain.anim"),
+        "a compiled-in table of the wrong length is rejected");
+  free_animation(longer);
+
+  return failures;
+}
@@ -0,0 +1,12 @@
+//
+//  test_image.h
+//
+
+#ifndef test_image_h
+#define test_image_h
+
+// Runs the image-loading tests against the started game; returns the number of
+// failed checks.
+int test_image(void);
+
+#endif /* test_image_h */
@@ -3,12 +3,14 @@
 //  Unit tests for the lip-sync sidecar parsers and lookups (SPEECH.md
 //  Phase 2). The parsers are strict: any malformed input must reject the
 //  whole file, so a bad sidecar degrades to the legacy talking loop instead
-//  of half-working.
+//  of half-working. Parsed sidecars take exactly the memory they need, and
+//  the binary twins decode to what their text parses to.
 //
 
 #include <stdio.h>
 #include <string.h>
 
+#include "arena.h"
 #include "lipsync.h"
 
 #include "test_lipsync.h"
@@ -108,6 +110,83 @@ static void test_word_parser(void) {
   check(!parse_words("", &words), "an empty words file rejects");
 }
 
+// Parsed into an arena, whose byte count is then exactly what was kept.
+static void test_exact_size(void) {
+  Arena arena = {0};
+  Arena *previous = arena_use(&arena);
+  MouthCues cues;
+  check(parse_cues("0 X\n230 B\n340 D\n", &cues) &&
+            arena.used == ((sizeof(MouthCue) * 3 + 15) & ~(size_t)15),
+        "cues take exactly their file's count, not the cap");
+  size_t before = arena.used;
+  WordTimings words;
+  check(parse_words("0 100 uno\n100 200 due\n", &words) &&
+            arena.used - before ==
+                ((sizeof(WordTiming) * 2 + 8 + 15) & ~(size_t)15) &&
+            strcmp(words.words[1].word, "due") == 0,
+        "word timings and their text share one exact block");
+  before = arena.used;
+  check(!parse_cues("0 X\n230 B\n100 D\n", &cues) && arena.used == before,
+        "a rejected file allocates nothing");
+  arena_use(previous);
+  arena_reset(&arena);
+}
+
+// What tools/gen_lipsync.py compiles "0 X\n230 B\n340 D\n" and
+// "0 100 uno\n100 200 due\n" to.
+static const Uint8 twin_cues[] = {
+    'V', 'L', 'C', 'U', LIPSYNC_BINARY_VERSION, 0, 3, 0, 0, 0xe6, 0x01, 0x6e,
+    0x20, 0x04};
+static const Uint8 twin_words[] = {
+    'V', 'L', 'W', 'D', LIPSYNC_BINARY_VERSION, 0, 2, 0, 8, 0, 0, 0, 0, 100,
+    100, 100, 'u', 'n', 'o', 0, 'd', 'u', 'e', 0};
+
+static void test_binary_twins(void) {
+  MouthCues text;
+  MouthCues binary;
+  parse_cues("0 X\n230 B\n340 D\n", &text);
+  check(lipsync_decode(twin_cues, sizeof(twin_cues), &binary) &&
+            binary.length == text.length &&
+            memcmp(binary.cues, text.cues, sizeof(MouthCue) * 3) == 0,
+        "a .bcues decodes to the cues its text parses to");
+  lipsync_free(&binary);
+  lipsync_free(&text);
+
+  WordTimings words;
+  check(lipsync_decode_words(twin_words, sizeof(twin_words), &words) &&
+            words.length == 2 && words.words[1].start_ms == 100 &&
+            words.words[1].end_ms == 200 &&
+            strcmp(words.words[0].word, "uno") == 0 &&
+            strcmp(words.words[1].word, "due") == 0 &&
+            words.words[0].word == (const char *)(words.words + 2),
+        "a .bwords decodes, its text copied in after the timings");
+  lipsync_free_words(&words);
+
+  Uint8 bad[sizeof(twin_words)];
+  check(!lipsync_decode(twin_cues, sizeof(twin_cues) - 1, &binary) &&
+            binary.length == 0,
+        "a truncated twin rejects");
+  memcpy(bad, twin_cues, sizeof(twin_cues));
+  bad[4] = LIPSYNC_BINARY_VERSION + 1;
+  check(!lipsync_decode(bad, sizeof(twin_cues), &binary),
+        "another version's twin rejects");
+  memcpy(bad, twin_cues, sizeof(twin_cues));
+  bad[sizeof(twin_cues) - 1] = MOUTH_SHAPE_COUNT;
+  check(!lipsync_decode(bad, sizeof(twin_cues), &binary),
+        "an unknown shape rejects");
+  check(!lipsync_decode(twin_words, sizeof(twin_words), &binary),
+        "a words twin is not a cues twin");
+  memcpy(bad, twin_words, sizeof(twin_words));
+  bad[sizeof(twin_words) - 1] = 'x';
+  check(!lipsync_decode_words(bad, sizeof(twin_words), &words) &&
+            words.length == 0,
+        "an unterminated word rejects");
+  memcpy(bad, twin_words, sizeof(twin_words));
+  bad[8] = 9;
+  check(!lipsync_decode_words(bad, sizeof(twin_words), &words),
+        "a text size that disagrees with the timings rejects");
+}
+
 static void test_word_at(void) {
   WordTimings words;
   // A silence gap between 300 and 400.
@@ -132,5 +211,7 @@ int test_lipsync(void) {
   test_shape_at();
   test_word_parser();
   test_word_at();
+  test_exact_size();
+  test_binary_twins();
   return failures;
 }
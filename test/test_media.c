@@ -0,0 +1,203 @@
+//
+//  test_media.c
+//  Tests for on-demand adventure media (game.h): an adventure loads when it is
+//  entered, the hub stays pinned, and leaving one gives its memory back under
+//  the budget, least recently entered first — so what is resident scales with
+//  one adventure, not the catalogue. With streaming on, the rest come in
+//  behind the hub, and a tap waits on a progress bar instead of a load. An
+//  evicted adventure's dialogue sidecars go with its media arena.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "asset.h"
+#include "depth_demo.h"
+#include "draw.h"
+#include "game.h"
+#include "gina_hen_at_the_pool.h"
+#include "harness.h"
+#include "hub.h"
+#include "image.h"
+#include "test_media.h"
+#include "vania_fox_the_slide.h"
+
+// Larger than every adventure together.
+#define UNLIMITED ((size_t)1 << 40)
+// Frames to wait on the decode threads, which run in real time: a
+// millisecond each, so a few seconds at most.
+#define STREAM_FRAMES 5000
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+static size_t image_bytes(void) {
+  return texture_cache_stats().bytes_resident;
+}
+
+// ── budget 0: one adventure at a time ────────────────────────────────────────
+
+static void test_one_at_a_time(void) {
+  return_to_hub();
+  game_set_media_budget(0);
+  check(!adventure_media_loaded(&depth_demo) &&
+            !adventure_media_loaded(&vania_fox_the_slide) &&
+            game_media_resident() == 0,
+        "media: a zero budget evicts every adventure but the current one");
+  check(adventure_media_loaded(&hub), "media: the hub stays pinned");
+  size_t hub_only = image_bytes();
+
+  adventure_switch_to(&depth_demo);
+  const Scene *field = &depth_demo.scenes[FIELD];
+  check(adventure_media_loaded(&depth_demo) && game_media_resident() > 0 &&
+            image_bytes() == hub_only + game_media_resident(),
+        "media: entering an adventure loads it, and measures what it took");
+  check(field->bg_planes[1].image.texture != NULL &&
+            (*field->actor)->animations[IDLE]->image.texture != NULL,
+        "media: its planes and actor sheets are up");
+  harness_step_frame();
+  harness_step_frame();
+
+  return_to_hub();
+  check(!adventure_media_loaded(&depth_demo) && image_bytes() == hub_only,
+        "media: leaving gives back every byte it loaded");
+  const Actor *fox = *field->actor;
+  check(field->bg_planes[1].image.texture == NULL && fox != NULL &&
+            fox->animations[IDLE]->image.texture == NULL,
+        "media: eviction frees the media but keeps the actor");
+
+  adventure_switch_to(&depth_demo);
+  check(adventure_media_loaded(&depth_demo) &&
+            (*field->actor)->animations[IDLE]->image.texture != NULL,
+        "media: re-entering an evicted adventure loads it again");
+  harness_step_frame();
+  return_to_hub();
+}
+
+// ── a budget for two ─────────────────────────────────────────────────────────
+
+static void test_least_recently_entered(void) {
+  game_set_media_budget(UNLIMITED);
+  adventure_switch_to(&depth_demo);
+  return_to_hub();
+  adventure_switch_to(&vania_fox_the_slide);
+  return_to_hub();
+  check(adventure_media_loaded(&depth_demo) &&
+            adventure_media_loaded(&vania_fox_the_slide),
+        "media: within budget, a left adventure stays loaded");
+  AdventureMemory loaded = adventure_memory(&vania_fox_the_slide);
+  check(loaded.objects > 0 && loaded.media > 0,
+        "media: an adventure's objects and dialogue sidecars are in its "
+        "arenas");
+
+  // One byte short of both: the depth demo, entered first, goes.
+  game_set_media_budget(game_media_resident() - 1);
+  check(!adventure_media_loaded(&depth_demo) &&
+            adventure_media_loaded(&vania_fox_the_slide),
+        "media: over budget, the least recently entered is evicted");
+
+  // Entering it again makes room first: the slide goes before it loads.
+  adventure_switch_to(&depth_demo);
+  check(adventure_media_loaded(&depth_demo) &&
+            !adventure_media_loaded(&vania_fox_the_slide) &&
+            game_media_resident() <= game_media_budget(),
+        "media: room is made before an adventure loads");
+  AdventureMemory evicted = adventure_memory(&vania_fox_the_slide);
+  check(evicted.media == 0 && evicted.objects == loaded.objects,
+        "media: eviction gives back its media arena whole, keeping the "
+        "objects");
+  return_to_hub();
+}
+
+// ── streaming ────────────────────────────────────────────────────────────────
+
+// Step frames, a millisecond of real time apart, until `done` or the cap.
+static bool step_until(bool (*done)(void)) {
+  for (int i = 0; i < STREAM_FRAMES && !done(); i++) {
+    SDL_Delay(1);
+    harness_step_frame();
+  }
+  return done();
+}
+
+static bool in_depth_demo(void) {
+  return game.current_adventure == &depth_demo;
+}
+
+static bool all_streamed(void) {
+  return adventure_media_loaded(&vania_fox_the_slide) &&
+         adventure_media_loaded(&gina_hen_at_the_pool) &&
+         adventure_media_loaded(&depth_demo);
+}
+
+static void test_streaming(void) {
+  // An adventure never loaded is sized from its images' headers before it
+  // streams; nothing streams into a budget it wouldn't fit.
+  adventure_prefetch_media(&gina_hen_at_the_pool, harness_renderer());
+  check(image_decode_queued_bytes() > 0,
+        "streaming: an unloaded adventure's size is known from its headers");
+  image_decode_finish();
+  asset_set_root(hub.assets_root);
+  game_set_media_budget(0);
+  game_set_media_budget(1);
+  game_set_media_streaming(true);
+  for (int i = 0; i < 10; i++) {
+    harness_step_frame();
+  }
+  check(game_media_streaming() == NULL && game_media_resident() == 0,
+        "streaming: nothing streams that wouldn't fit the budget");
+  game_set_media_streaming(false);
+
+  game_set_media_budget(UNLIMITED);
+  game_set_media_streaming(true);
+
+  // The tap waits: the hub stays, dimmed, while the tapped adventure streams.
+  adventure_open(&depth_demo);
+  check(game.current_adventure == &hub &&
+            game_media_waiting() == &depth_demo,
+        "streaming: a tap on an unloaded adventure waits in the hub");
+  harness_step_frame();
+  check(game_media_streaming() == &depth_demo,
+        "streaming: the adventure waited on streams first");
+  check(draw_stats_frame().draw_calls > 0 &&
+            !adventure_media_loaded(&depth_demo),
+        "streaming: frames go on while it decodes");
+  check(step_until(in_depth_demo) && adventure_media_loaded(&depth_demo) &&
+            game_media_waiting() == NULL,
+        "streaming: it is entered once its load completes");
+  harness_step_frame();
+
+  // Nothing streams outside the hub; back in it, the rest come in.
+  check(game_media_streaming() == NULL,
+        "streaming: nothing streams while an adventure is played");
+  return_to_hub();
+  check(step_until(all_streamed) && game_media_streaming() == NULL,
+        "streaming: the hub streams in every adventure that fits");
+
+  // Once loaded, a tap enters at once.
+  adventure_open(&vania_fox_the_slide);
+  check(game.current_adventure == &vania_fox_the_slide,
+        "streaming: a loaded adventure opens at once");
+  game_set_media_streaming(false);
+  return_to_hub();
+}
+
+int test_media(void) {
+  failures = 0;
+  fprintf(stderr, "\n-- on-demand media tests --\n");
+  size_t budget = game_media_budget();
+  test_one_at_a_time();
+  test_least_recently_entered();
+  test_streaming();
+  game_set_media_budget(budget);
+  return failures;
+}
@@ -0,0 +1,12 @@
+//
+//  test_media.h
+//
+
+#ifndef test_media_h
+#define test_media_h
+
+// Runs the on-demand media tests against the started game; returns the number
+// of failed checks.
+int test_media(void);
+
+#endif /* test_media_h */
@@ -0,0 +1,197 @@
+//
+//  test_pack.c
+//  Tests for packed asset archives (pack.{c,h}): a pack written here the way
+//  tools/gen_pack.py writes one is found by its directory, read back byte for
+//  byte through the asset layer, answers for its whole root (locale layer
+//  over common/ included), and a malformed or missing pack leaves the root to
+//  the disk. A loose adventure root is listed instead, so probing it opens
+//  nothing.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "asset.h"
+#include "pack.h"
+#include "test_pack.h"
+#include "vania_fox_the_slide.h"
+
+// Mounts last for the process, so each root here is used by this test alone.
+#define PACK_ROOT "test_pack_root"
+#define BAD_ROOT "test_pack_bad"
+#define LOOSE_ROOT "test_pack_loose"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+static void put_le32(Uint8 *p, Uint32 v) {
+  p[0] = (Uint8)v;
+  p[1] = (Uint8)(v >> 8);
+  p[2] = (Uint8)(v >> 16);
+  p[3] = (Uint8)(v >> 24);
+}
+
+typedef struct packed_file {
+  char name[64];
+  const char *data;
+} PackedFile;
+
+// Write `files` (already in directory order) as a pack at `path`.
+static bool write_pack(const char *path, const PackedFile *files, int count) {
+  Uint8 out[1024] = {0};
+  size_t strings_size = 0;
+  for (int i = 0; i < count; i++) {
+    strings_size += strlen(files[i].name) + 1;
+  }
+  size_t strings_at = 16 + (size_t)count * 16;
+  size_t at = strings_at + strings_size;
+  memcpy(out, PACK_MAGIC, 4);
+  put_le32(out + 4, PACK_VERSION);
+  put_le32(out + 8, (Uint32)count);
+  put_le32(out + 12, (Uint32)strings_size);
+  size_t name = 0;
+  for (int i = 0; i < count; i++) {
+    size_t size = strlen(files[i].data);
+    at = (at + 15) & ~(size_t)15;
+    Uint8 *entry = out + 16 + i * 16;
+    put_le32(entry, pack_hash(files[i].name));
+    put_le32(entry + 4, (Uint32)name);
+    put_le32(entry + 8, (Uint32)at);
+    put_le32(entry + 12, (Uint32)size);
+    memcpy(out + strings_at + name, files[i].name, strlen(files[i].name) + 1);
+    name += strlen(files[i].name) + 1;
+    memcpy(out + at, files[i].data, size);
+    at += size;
+  }
+  SDL_RWops *rw = SDL_RWFromFile(path, "wb");
+  if (rw == NULL) {
+    return false;
+  }
+  bool ok = SDL_RWwrite(rw, out, 1, at) == at;
+  return SDL_RWclose(rw) == 0 && ok;
+}
+
+// ── a pack backs its root ────────────────────────────────────────────────────
+
+static void test_mounted(void) {
+  PackedFile files[2] = {
+      {.data = "shared by every locale"},
+      {.data = "localized"},
+  };
+  snprintf(files[0].name, sizeof(files[0].name), "common/props/a.txt");
+  snprintf(files[1].name, sizeof(files[1].name), "%s/props/b.txt",
+           asset_get_locale());
+  if (pack_hash(files[1].name) < pack_hash(files[0].name)) {
+    PackedFile first = files[0];
+    files[0] = files[1];
+    files[1] = first;
+  }
+  check(write_pack(PACK_ROOT ".pack", files, 2), "pack: test pack written");
+  check(pack_mount(PACK_ROOT), "pack: a root with a pack mounts it");
+  check(pack_mount(PACK_ROOT), "pack: mounting again is a lookup");
+
+  check(pack_covers(PACK_ROOT "/common/props/a.txt") &&
+            !pack_covers("test_pack_rootless/common/props/a.txt"),
+        "pack: covers its own root only");
+  check(asset_file_exists(PACK_ROOT "/common/props/a.txt") &&
+            !asset_file_exists(PACK_ROOT "/common/props/missing.txt"),
+        "pack: existence is answered from the directory");
+
+  size_t size = 0;
+  char *data = asset_load_file(PACK_ROOT "/common/props/a.txt", &size);
+  check(data != NULL && size == strlen("shared by every locale") &&
+            strcmp(data, "shared by every locale") == 0,
+        "pack: a packed file reads back whole, NUL-terminated");
+  SDL_free(data);
+
+  SDL_RWops *rw = pack_open(PACK_ROOT "/common/props/a.txt");
+  char word[8] = {0};
+  check(rw != NULL && SDL_RWsize(rw) == (Sint64)size &&
+            SDL_RWseek(rw, 10, RW_SEEK_SET) == 10 &&
+            SDL_RWread(rw, word, 1, 5) == 5 && strcmp(word, "every") == 0 &&
+            SDL_RWseek(rw, -3, RW_SEEK_END) == (Sint64)size - 3 &&
+            SDL_RWread(rw, word, 1, sizeof(word)) == 3,
+        "pack: a packed file seeks and reads like a file");
+  if (rw != NULL) {
+    SDL_RWclose(rw);
+  }
+  check(pack_open(PACK_ROOT "/common/props/missing.txt") == NULL,
+        "pack: an absent file doesn't open");
+
+  // The resolver's layers work inside the pack.
+  const char *root = asset_get_root();
+  asset_set_root(PACK_ROOT);
+  char path[ASSET_PATH_MAX];
+  check(asset_resolve((Asset){.filename = "b.txt", .directory = "props"}, path,
+                      sizeof(path)),
+        "pack: the locale layer is found in the pack");
+  check(!asset_resolve((Asset){.filename = "a.txt", .directory = "props"},
+                       path, sizeof(path)) &&
+            strcmp(path, PACK_ROOT "/common/props/a.txt") == 0,
+        "pack: common/ is the fallback in the pack");
+  asset_set_root(root);
+  remove(PACK_ROOT ".pack");
+}
+
+// ── no pack, or a bad one ────────────────────────────────────────────────────
+
+static void test_unpacked(void) {
+  check(!pack_mount(LOOSE_ROOT) && !pack_covers(LOOSE_ROOT "/common/a.txt"),
+        "pack: a root with neither a pack nor a tree isn't mounted");
+
+  SDL_RWops *rw = SDL_RWFromFile(BAD_ROOT ".pack", "wb");
+  if (rw != NULL) {
+    SDL_RWwrite(rw, "VPAK\x01\0\0\0\xff\xff\0\0\0\0\0\0", 1, 16);
+    SDL_RWclose(rw);
+  }
+  check(!pack_mount(BAD_ROOT) && !pack_covers(BAD_ROOT "/common/a.txt"),
+        "pack: a malformed pack is refused, leaving the root loose");
+  remove(BAD_ROOT ".pack");
+}
+
+// ── a loose root is listed ───────────────────────────────────────────────────
+
+static void test_listed(void) {
+  // Packed or listed, the started game's adventure roots are mounted.
+  const char *root = vania_fox_the_slide.assets_root;
+  char present[ASSET_PATH_MAX];
+  char absent[ASSET_PATH_MAX];
+  snprintf(present, sizeof(present), "%s/common/fox/walking.json", root);
+  snprintf(absent, sizeof(absent), "%s/common/fox/missing.json", root);
+  check(pack_covers(present), "pack: an adventure root is mounted");
+
+  AssetLookupStats before = asset_lookup_stats();
+  check(asset_file_exists(present) && !asset_file_exists(absent),
+        "pack: a mounted root's probes are right");
+  AssetLookupStats after = asset_lookup_stats();
+  check(after.in_memory == before.in_memory + 2 &&
+            after.on_disk == before.on_disk,
+        "pack: a mounted root's probes open no file");
+
+  check(!asset_file_exists("test_pack_nowhere.txt") &&
+            asset_lookup_stats().on_disk == after.on_disk + 1,
+        "pack: a path outside every root is probed on disk");
+}
+
+int test_pack(void) {
+  failures = 0;
+  // Packs are ignored outright then, though roots are still listed.
+  if (SDL_getenv("VANIA_NO_PACKS") != NULL) {
+    fprintf(stderr, "SKIP  pack: $VANIA_NO_PACKS is set\n");
+  } else {
+    test_mounted();
+    test_unpacked();
+  }
+  test_listed();
+  return failures;
+}
@@ -0,0 +1,11 @@
+//
+//  test_pack.h
+//
+
+#ifndef test_pack_h
+#define test_pack_h
+
+// Runs the packed asset archive tests; returns the number of failed checks.
+int test_pack(void);
+
+#endif /* test_pack_h */
@@ -0,0 +1,115 @@
+//
+//  test_profile.c
+//  Tests for the frame-phase profiler (profile.{c,h}): the ring's order and
+//  wrap, nearest-rank percentiles over synthetic frames, and that a stepped
+//  frame of the depth demo's field times the game_update/game_render stages.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "depth_demo.h"
+#include "game.h"
+#include "harness.h"
+#include "profile.h"
+#include "test_profile.h"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+static void record_ms(float ms) { profile_record(&(ProfileFrame){ms, {0}}); }
+
+// ── ring ─────────────────────────────────────────────────────────────────────
+
+static void test_ring(void) {
+  profile_reset();
+  check(profile_frame_count() == 0 && profile_frame(0) == NULL,
+        "profile: reset empties the ring");
+  check(profile_percentile(50) == 0.0F, "profile: empty ring's p50 is 0");
+
+  record_ms(1);
+  record_ms(2);
+  record_ms(3);
+  check(profile_frame_count() == 3, "profile: three frames recorded");
+  check(profile_frame(0)->total_ms == 3 && profile_frame(2)->total_ms == 1,
+        "profile: age 0 is the newest frame");
+  check(profile_frame(3) == NULL && profile_frame(-1) == NULL,
+        "profile: no frame past the oldest");
+
+  // Overfill by ten: the ring keeps the newest PROFILE_FRAMES.
+  profile_reset();
+  for (int i = 1; i <= PROFILE_FRAMES + 10; i++) {
+    record_ms((float)i);
+  }
+  check(profile_frame_count() == PROFILE_FRAMES, "profile: ring stays full");
+  check(profile_frame(0)->total_ms == PROFILE_FRAMES + 10 &&
+            profile_frame(PROFILE_FRAMES - 1)->total_ms == 11,
+        "profile: wrap drops the oldest frames");
+}
+
+// ── percentiles ──────────────────────────────────────────────────────────────
+
+static void test_percentiles(void) {
+  // 1..100 ms, recorded out of order: nearest rank gives the p-th value.
+  profile_reset();
+  for (int i = 0; i < 100; i++) {
+    record_ms((float)((i * 37) % 100 + 1));
+  }
+  check(profile_percentile(50) == 50, "profile: p50 of 1..100 ms is 50");
+  check(profile_percentile(95) == 95, "profile: p95 of 1..100 ms is 95");
+  check(profile_percentile(99) == 99, "profile: p99 of 1..100 ms is 99");
+  check(profile_percentile(100) == 100 && profile_percentile(0) == 1,
+        "profile: p100 is the slowest frame and p0 the fastest");
+
+  // A steady 16 ms with three 90 ms hitches in 100 frames: the median hides
+  // them, p99 doesn't.
+  profile_reset();
+  for (int i = 0; i < 100; i++) {
+    record_ms(i % 33 == 32 ? 90.0F : 16.0F);
+  }
+  check(profile_percentile(50) == 16 && profile_percentile(95) == 16,
+        "profile: p50 and p95 ignore 3% of hitches");
+  check(profile_percentile(99) == 90, "profile: p99 catches them");
+}
+
+// ── stepped frames ───────────────────────────────────────────────────────────
+
+static void test_stepped_frame(void) {
+  adventure_switch_to(&depth_demo);
+  profile_reset();
+  harness_step_frame();
+  harness_step_frame();
+  const ProfileFrame *frame = profile_frame(0);
+  check(profile_frame_count() == 2, "profile: a stepped frame is recorded");
+  check(frame != NULL && frame->total_ms > 0, "profile: the frame took time");
+  // The field has planes and a fox, so drawing them takes measurable time;
+  // the two plane passes (bg and fg) land in the one phase.
+  check(frame != NULL && frame->phase_ms[PROFILE_PLANES] > 0 &&
+            frame->phase_ms[PROFILE_ACTION_LAYER] > 0,
+        "profile: planes and the action layer are timed");
+  check(frame != NULL &&
+            frame->phase_ms[PROFILE_PLANES] +
+                    frame->phase_ms[PROFILE_SPRITES] +
+                    frame->phase_ms[PROFILE_ACTION_LAYER] <=
+                frame->total_ms,
+        "profile: render stages fit inside the frame");
+  return_to_hub();
+  profile_reset();
+}
+
+int test_profile(void) {
+  failures = 0;
+  test_ring();
+  test_percentiles();
+  test_stepped_frame();
+  return failures;
+}
@@ -0,0 +1,12 @@
+//
+//  test_profile.h
+//
+
+#ifndef test_profile_h
+#define test_profile_h
+
+// Runs the frame-profiler tests against the started game; returns the number
+// of failed checks.
+int test_profile(void);
+
+#endif /* test_profile_h */
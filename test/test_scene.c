@@ -2,9 +2,9 @@
 //  test_scene.c
 //  Unit tests for the y-sorted action layer, parallax planes, hotspot boils,
 //  idle fidgets and depth scaling: actor_feet_y, action_layer_order,
-//  plane_screen_pos, scale_ramp_at and the scaled draw geometry. Everything is
-//  synthetic — no window, renderer, or assets; actors get hand-built animation
-//  frames where the checks need them.
+//  plane_screen_pos, plane repeat and paging, scene exits, scale_ramp_at and
+//  the scaled draw geometry. Everything is synthetic — no window, renderer, or assets;
+//  actors get hand-built animation frames where the checks need them.
 //
 
 #include <math.h>
@@ -12,6 +12,7 @@
 
 #include "actor.h"
 #include "clock.h"
+#include "constants.h"
 #include "scene.h"
 
 #include "test_scene.h"
@@ -197,6 +198,13 @@ int test_scene(void) {
   check(order_is(lifted, count, (int[]){1, 0, 4, 3}, 4),
         "a lifted actor and her shadow both sort at the landing, shadow under");
 
+  // The shadow's quad is centred on her x at the landing line: 0.30 of the
+  // 220px frame wide each side (66), flattened to 0.32 of that (21).
+  SDL_Rect shadow = actor_shadow_rect(actor);
+  check(shadow.x == 400 - 66 && shadow.w == 2 * 66 + 1 &&
+            shadow.y == 600 - 21 && shadow.h == 2 * 21 + 1,
+        "the shadow quad is an ellipse box centred on the landing point");
+
   actor->state = IDLE;
   actor_free(actor);
 
@@ -247,6 +255,52 @@ int test_scene(void) {
   check(plane_covers_view(&hills, wide),
         "a 1120px parallax-0.4 plane exactly covers");
 
+  // Repeating planes: the first copy wraps into (-period, 0] however far the
+  // plane has scrolled, either way, and a repeated axis always covers.
+  check(plane_wrap_start(0, 64) == 0 && plane_wrap_start(-130, 64) == -2 &&
+            plane_wrap_start(-128, 64) == 0 && plane_wrap_start(70, 64) == -58,
+        "a repeating plane's first copy wraps to just left of the window");
+  Plane strip = {.image = {NULL, "sky.png", "field", 64, 600},
+                 .parallax = 0.5F,
+                 .repeat = PLANE_REPEAT_X};
+  check(plane_covers_view(&strip, wide),
+        "a repeated 64px strip covers a wide scene");
+  strip.image.height = 300;
+  check(!plane_covers_view(&strip, wide),
+        "a horizontal repeat doesn't cover a short strip's missing height");
+  strip.repeat = PLANE_REPEAT_XY;
+  check(plane_covers_view(&strip, wide), "a repeat on both axes covers");
+
+  // Paging (load_image_paged): what the window shows of a plane, in image
+  // coordinates, and what is kept resident — reaching ahead to where the
+  // camera is easing.
+  SDL_Rect view = plane_view_rect(&hills, (SDL_FPoint){500, 0});
+  check(view.x == 200 && view.y == 0 && view.w == WINDOW_WIDTH &&
+            view.h == WINDOW_HEIGHT,
+        "a plane's view rect is the window at its parallax offset");
+  Actor *followed = make_actor(&BARE_SPEC, (SDL_FPoint){1200, 300}, NULL);
+  Camera camera = {.pos = {0, 0}, .scene_size = wide, .follow = followed};
+  SDL_Rect page = plane_page_rect(&ground, &camera);
+  check(page.x == -PLANE_PAGE_MARGIN && page.y == -PLANE_PAGE_MARGIN &&
+            page.w == 1600 + 2 * PLANE_PAGE_MARGIN &&
+            page.h == WINDOW_HEIGHT + 2 * PLANE_PAGE_MARGIN,
+        "the page rect spans the view and where the camera is heading");
+  camera.follow = NULL;
+  page = plane_page_rect(&hills, &camera);
+  check(page.x == -PLANE_PAGE_MARGIN &&
+            page.w == WINDOW_WIDTH + 2 * PLANE_PAGE_MARGIN,
+        "a resting camera pages only around its view");
+  actor_free(followed);
+
+  // ── exits ─────────────────────────────────────────────────────────────────
+
+  static const int pool_exits[] = {2, 3, 5};
+  Scene pool = {.exits = pool_exits, .exits_length = LEN(pool_exits)};
+  Scene end_card = {0};
+  check(scene_has_exit(&pool, 3) && !scene_has_exit(&pool, 4),
+        "a scene leads to exactly its declared exits");
+  check(!scene_has_exit(&end_card, 0), "a scene with no exits leads nowhere");
+
   // ── boiling hotspots: sync_hotspot_active_anims ───────────────────────────
 
   fprintf(stderr, "\nboiling hotspots:\n");
@@ -0,0 +1,101 @@
+//
+//  test_trace.c
+//  Tests for the trace-event export (trace.{c,h}): a recorded run is written
+//  as Chrome trace-event JSON with balanced scopes, escaped details and the
+//  frame phases of a stepped frame. Compiled down to nothing in a PROD build,
+//  where tracing is.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "harness.h"
+#include "test_trace.h"
+#include "trace.h"
+
+#define TRACE_TEST_PATH "test_trace.json"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+#ifndef PROD
+
+static int count(const char *haystack, const char *needle) {
+  int n = 0;
+  for (const char *at = strstr(haystack, needle); at != NULL;
+       at = strstr(at + 1, needle)) {
+    n++;
+  }
+  return n;
+}
+
+static void test_export(void) {
+  // A run traced through $VANIA_TRACE owns the one trace; leave it be.
+  if (trace_recording()) {
+    fprintf(stderr, "SKIP  trace: $VANIA_TRACE is already recording\n");
+    return;
+  }
+  check(!trace_start(NULL) && !trace_start(""),
+        "trace: no path, no recording");
+  trace_begin("untraced", NULL);
+
+  check(trace_start(TRACE_TEST_PATH), "trace: recording starts");
+  check(!trace_start(TRACE_TEST_PATH), "trace: one trace at a time");
+  trace_begin("outer", "C:\\art\\\"quoted\".png");
+  trace_begin("inner", NULL);
+  trace_end("inner");
+  trace_end("outer");
+  trace_instant("marker");
+  harness_step_frame();
+  check(trace_stop(), "trace: the file is written");
+  check(!trace_recording(), "trace: stopping stops recording");
+
+  size_t size = 0;
+  char *json = SDL_LoadFile(TRACE_TEST_PATH, &size);
+  check(json != NULL, "trace: the file reads back");
+  if (json == NULL) {
+    return;
+  }
+  const char *head = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  check(strncmp(json, head, strlen(head)) == 0 &&
+            strstr(json, "\n]}\n") != NULL,
+        "trace: a trace-event JSON object");
+  check(strstr(json, "untraced") == NULL,
+        "trace: nothing recorded before the start");
+  check(count(json, "\"ph\":\"B\"") == count(json, "\"ph\":\"E\"") &&
+            count(json, "\"ph\":\"B\"") > 2,
+        "trace: every begin has its end");
+  const char *detail = "\"detail\":\"C:\\\\art\\\\\\\"quoted\\\".png\"";
+  check(strstr(json, detail) != NULL, "trace: details are JSON-escaped");
+  check(strstr(json, "\"name\":\"marker\",\"s\":\"g\"") != NULL,
+        "trace: an instant spans every track");
+  // The stepped frame's game_render stages, and its end.
+  check(strstr(json, "\"name\":\"planes\"") != NULL &&
+            strstr(json, "\"name\":\"action layer\"") != NULL &&
+            strstr(json, "\"name\":\"frame\"") != NULL,
+        "trace: a frame's phases are scopes");
+  SDL_free(json);
+  remove(TRACE_TEST_PATH);
+}
+
+#endif /* PROD */
+
+int test_trace(void) {
+  failures = 0;
+#ifndef PROD
+  test_export();
+#else
+  check(true, "trace: PROD build: tracing compiled out");
+#endif
+  return failures;
+}
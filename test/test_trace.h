@@ -0,0 +1,12 @@
+//
+//  test_trace.h
+//
+
+#ifndef test_trace_h
+#define test_trace_h
+
+// Runs the trace-export tests against the started game; returns the number of
+// failed checks.
+int test_trace(void);
+
+#endif /* test_trace_h */
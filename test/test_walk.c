@@ -192,6 +192,10 @@ static void test_walk_mask_format(void) {
   check(length > 0 && walk_grid_parse(buffer, (size_t)length, &parsed) &&
             grids_equal(&parsed, &built),
         "walk mask serialize -> parse round-trips");
+  Uint32 generation = built.generation;
+  walk_grid_build(&built, &PLAYGROUND_AREA, WINDOW_SIZE);
+  check(built.generation != generation && parsed.generation != generation,
+        "each build or load gives the grid a fresh generation");
 
   // Strict parser: each corruption rejects the whole file.
   check(!walk_grid_parse("walk 80 59\n", 11, &parsed),
@@ -0,0 +1,159 @@
+//
+//  test_warm_cache.c
+//  Tests for the warm-start cache (warm_cache.{c,h}) and its codec (lz4.h):
+//  a block round-trips and a damaged one is refused; an entry written for a
+//  file reads back until the file changes, another variant of it is a miss,
+//  and a damaged entry is a miss that deletes itself.
+//
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lz4.h"
+#include "test_warm_cache.h"
+#include "warm_cache.h"
+
+// The cache's directory is a prefix: entries land in the working directory
+// as test_warm_cache_warm-<hash>.lz4, and are removed at the end.
+#define CACHE_DIR "test_warm_cache_"
+#define ASSET_FILE "test_warm_cache_asset.txt"
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+  if (ok) {
+    fprintf(stderr, "OK    %s\n", what);
+  } else {
+    fprintf(stderr, "MISS  %s\n", what);
+    failures++;
+  }
+}
+
+static bool write_file(const char *path, const void *data, size_t size) {
+  SDL_RWops *rw = SDL_RWFromFile(path, "wb");
+  if (rw == NULL) {
+    return false;
+  }
+  bool ok = SDL_RWwrite(rw, data, 1, size) == size;
+  return SDL_RWclose(rw) == 0 && ok;
+}
+
+static bool file_exists(const char *path) {
+  SDL_RWops *rw = SDL_RWFromFile(path, "rb");
+  if (rw != NULL) {
+    SDL_RWclose(rw);
+  }
+  return rw != NULL;
+}
+
+// ── lz4 ──────────────────────────────────────────────────────────────────────
+
+static void test_lz4(void) {
+  // Runs of one pixel and a few distinct ones, like a sprite's transparent
+  // margin around its drawing.
+  static Uint8 pixels[4096];
+  for (size_t i = 0; i < sizeof(pixels); i++) {
+    pixels[i] = i % 1024 < 600 ? 0 : (Uint8)(i * 7 + i / 13);
+  }
+  static Uint8 packed[sizeof(pixels) + sizeof(pixels) / 255 + 16];
+  static Uint8 unpacked[sizeof(pixels)];
+  size_t size = lz4_compress(pixels, sizeof(pixels), packed, sizeof(packed));
+  check(size > 0 && size < sizeof(pixels) / 2,
+        "lz4: a mostly transparent strip compresses");
+  check(lz4_decompress(packed, size, unpacked, sizeof(unpacked)) &&
+            memcmp(pixels, unpacked, sizeof(pixels)) == 0,
+        "lz4: a block round-trips");
+  Uint8 tiny[3] = {1, 2, 3};
+  Uint8 out[3] = {0};
+  size_t tiny_size = lz4_compress(tiny, sizeof(tiny), packed, sizeof(packed));
+  check(lz4_decompress(packed, tiny_size, out, sizeof(out)) &&
+            memcmp(tiny, out, sizeof(tiny)) == 0,
+        "lz4: input too short to match round-trips as literals");
+
+  check(!lz4_decompress(packed, size - 1, unpacked, sizeof(unpacked)) &&
+            !lz4_decompress(packed, size, unpacked, sizeof(unpacked) - 1),
+        "lz4: a truncated block or a short output is refused");
+  Uint8 bad[] = {0x0f, 0x00, 0x10, 0x00}; // a match reaching before the start
+  check(!lz4_decompress(bad, sizeof(bad), unpacked, 19),
+        "lz4: a match before the output's start is refused");
+}
+
+// ── entries ──────────────────────────────────────────────────────────────────
+
+static void test_entries(void) {
+  const char *first = "the asset as first written";
+  check(write_file(ASSET_FILE, first, strlen(first)), "warm: asset written");
+  warm_cache_set_dir(NULL);
+  check(!warm_cache_key(WARM_IMAGE, ASSET_FILE, 0).usable,
+        "warm: no directory, no cache");
+
+  warm_cache_set_dir(CACHE_DIR);
+  WarmKey key = warm_cache_key(WARM_IMAGE, ASSET_FILE, 1);
+  size_t size = 0;
+  check(key.usable && warm_cache_read(&key, &size) == NULL,
+        "warm: nothing is cached at first");
+  const char payload[] = "what loading made of it, what loading made of it";
+  WarmCacheStats before = warm_cache_stats();
+  warm_cache_write(&key, payload, sizeof(payload));
+  check(warm_cache_stats().written == before.written + 1,
+        "warm: an entry is written");
+
+  key = warm_cache_key(WARM_IMAGE, ASSET_FILE, 1);
+  char *read = warm_cache_read(&key, &size);
+  check(read != NULL && size == sizeof(payload) &&
+            memcmp(read, payload, size) == 0,
+        "warm: the entry reads back");
+  SDL_free(read);
+
+  WarmKey other = warm_cache_key(WARM_IMAGE, ASSET_FILE, 2);
+  WarmKey kind = warm_cache_key(WARM_CLIPS, ASSET_FILE, 1);
+  check(warm_cache_read(&other, &size) == NULL &&
+            warm_cache_read(&kind, &size) == NULL,
+        "warm: another variant or kind of the file is a miss");
+
+  const char *second = "the asset, edited since it was cached";
+  check(write_file(ASSET_FILE, second, strlen(second)), "warm: asset edited");
+  WarmKey edited = warm_cache_key(WARM_IMAGE, ASSET_FILE, 1);
+  char entry[ASSET_PATH_MAX];
+  before = warm_cache_stats();
+  check(warm_cache_read(&edited, &size) == NULL &&
+            warm_cache_stats().dropped == before.dropped &&
+            warm_cache_entry_path(&edited, entry, sizeof(entry)) &&
+            file_exists(entry),
+        "warm: an edited file misses, leaving its stale entry to be replaced");
+  warm_cache_write(&edited, payload, sizeof(payload));
+  read = warm_cache_read(&edited, &size);
+  check(read != NULL && size == sizeof(payload),
+        "warm: the replaced entry reads back");
+  SDL_free(read);
+
+  // Cut the entry short, as a failing disk or a stray edit might.
+  size_t entry_size = 0;
+  void *bytes = SDL_LoadFile(entry, &entry_size);
+  check(bytes != NULL && write_file(entry, bytes, entry_size - 3),
+        "warm: entry damaged");
+  SDL_free(bytes);
+  before = warm_cache_stats();
+  check(warm_cache_read(&edited, &size) == NULL &&
+            warm_cache_stats().dropped == before.dropped + 1,
+        "warm: a damaged entry is a miss");
+  check(!file_exists(entry), "warm: a damaged entry is deleted");
+
+  WarmKey keys[] = {key, other, kind};
+  for (size_t i = 0; i < SDL_arraysize(keys); i++) {
+    if (warm_cache_entry_path(&keys[i], entry, sizeof(entry))) {
+      remove(entry);
+    }
+  }
+  warm_cache_set_dir(NULL);
+  remove(ASSET_FILE);
+}
+
+int test_warm_cache(void) {
+  failures = 0;
+  test_lz4();
+  test_entries();
+  return failures;
+}
@@ -0,0 +1,11 @@
+//
+//  test_warm_cache.h
+//
+
+#ifndef test_warm_cache_h
+#define test_warm_cache_h
+
+// Runs the warm-start cache unit tests; returns the number of failed checks.
+int test_warm_cache(void);
+
+#endif /* test_warm_cache_h */
@@ -44,7 +44,7 @@ def makefile_sources():
     mk = open(os.path.join(REPO, MAKEFILE)).read()
     block = mk[mk.index("GAME_SRCS = "):mk.index("SRCS = src/main.c")]
     out = ["src/main.c"]
-    for raw in re.findall(r"(?:src|\$\((?:VFTS|GINA|DEMO)_DIR\))/[a-z_/]+\.c",
+    for raw in re.findall(r"(?:src|\$\((?:VFTS|GINA|DEMO)_DIR\))/[a-z0-9_/]+\.c",
                           block):
         for key, value in ADVENTURE_DIRS.items():
             raw = raw.replace(key, value)
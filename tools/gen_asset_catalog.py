@@ -34,6 +34,11 @@ REFERENCE_LOCALE = "it_IT"
 # reads that CSV (one "x,y,w,h" frame rect per line) at 12 FPS.
 ANIM_EXT = ".anim"
 JSON_EXT = ".json"
+# Build-time QOI twins of the PNGs (tools/gen_qoi.py) and binary twins of the
+# lip-sync sidecars (tools/gen_lipsync.py --compile).
+TWIN_EXTS = (".qoi", ".bcues", ".bwords")
+# Generated resolution tiers (tools/gen_asset_tiers.py): "<base>@0.5x.png".
+TIER_RE = re.compile(r"@[0-9.]+x\.[^.]+$")
 
 
 def adventure_title(adv_dir, adv_name):
@@ -62,7 +67,11 @@ def png_size(path):
 
 
 def parse_anim(path):
-    """Parse an .anim CSV into a list of {x,y,w,h} frame rectangles."""
+    """Parse an .anim CSV into a list of {x,y,w,h,ox,oy,cw,ch} frames.
+
+    A trimmed row (tools/trim_sheets.py) carries where its clip sits (ox, oy)
+    in its untrimmed cw x ch cell; a plain x,y,w,h row is its own whole cell.
+    """
     frames = []
     try:
         with open(path, encoding="utf-8") as handle:
@@ -71,10 +80,13 @@ def parse_anim(path):
                 if not line:
                     continue
                 parts = line.split(",")
-                if len(parts) != 4:
+                if len(parts) not in (4, 8):
                     continue
-                x, y, w, h = (int(p) for p in parts)
-                frames.append({"x": x, "y": y, "w": w, "h": h})
+                values = [int(p) for p in parts]
+                x, y, w, h = values[:4]
+                ox, oy, cw, ch = values[4:] if len(values) == 8 else (0, 0, w, h)
+                frames.append({"x": x, "y": y, "w": w, "h": h,
+                               "ox": ox, "oy": oy, "cw": cw, "ch": ch})
     except (OSError, ValueError):
         pass
     return frames
@@ -107,6 +119,11 @@ def collect_layer(adv_id, layer, layer_dir, url_base):
     files = []
     for dirpath, _dirs, filenames in os.walk(layer_dir):
         for name in sorted(filenames):
+            # Resolution tiers (name@0.5x.png) and build-time twins (name.qoi,
+            # name.bcues) are generated copies of an asset already listed, not
+            # assets of their own.
+            if TIER_RE.search(name) or name.lower().endswith(TWIN_EXTS):
+                continue
             files.append(os.path.join(dirpath, name))
     present = {os.path.relpath(p, layer_dir).replace(os.sep, "/") for p in files}
 
@@ -13,6 +13,12 @@ the manifest instead of repeating filenames and frame counts inline:
 Zero runtime parsing: like the playthrough scripts (tools/gen_playtest.py),
 the JSON is consumed at build time. Run by make; output under build/gen/.
 
+Each .anim clip table on disk (every layer's, not just the manifest's
+entries) is compiled in too, as a static const SDL_Rect array keyed by its
+layer-relative path in <PREFIX>_ANIM_CLIPS_INIT: the adventure registers the
+list and load_animation copies the rects from it instead of opening and
+parsing the file (the file stays the fallback, and the authoring source).
+
 The generator also validates what it can see:
 - an animation's `frames` must match its committed .anim row count;
 - finished entries (no "task": true flag) must have their files on disk.
@@ -67,6 +73,33 @@ def runtime_dir(entry):
     return d
 
 
+def anim_clips(path):
+    """An .anim file's rows as (clip, trim) tuples, trim None if untrimmed.
+
+    As strict as parse_animation_data: a file the game would reject fails the
+    build instead.
+    """
+    rows = []
+    with open(path, encoding="utf-8") as f:
+        for n, line in enumerate(f.read().splitlines(), 1):
+            line = line.rstrip("\r")
+            if not line:
+                continue
+            fields = line.split(",")
+            if (len(fields) not in (4, 8)
+                    or not all(f.isdigit() and len(f) <= 5 for f in fields)):
+                die(f"{path}:{n}: malformed clip row")
+            fields = [int(f) for f in fields]
+            trim = None
+            if len(fields) == 8:
+                x, y, w, h, ox, oy, cw, ch = fields
+                if cw <= 0 or ch <= 0 or ox + w > cw or oy + h > ch:
+                    die(f"{path}:{n}: clip spills out of its cell")
+                trim = tuple(fields[4:])
+            rows.append((tuple(fields[:4]), trim))
+    return rows
+
+
 def anim_rows(path):
     rows = 0
     with open(path, encoding="utf-8") as f:
@@ -201,6 +234,52 @@ def emit_group(out, prefix, rel_dir, entries):
     out.append("")
 
 
+def rects(rows):
+    return ", ".join("{%d, %d, %d, %d}" % r for r in rows)
+
+
+def emit_clips(out, prefix, root, manifest):
+    # Every .anim under the root, by layer-relative path — the localized
+    # layers' too, since the resolver may pick one of those over common/. Rows
+    # come out as AnimationClips initializers (image.h); an untrimmed sheet's
+    # trims are NULL, leaving its frames untrimmed.
+    assets = os.path.join(root, manifest["assets_root"])
+    tables = []
+    for layer in sorted(os.listdir(assets)):
+        if layer.startswith((".", "_")):
+            continue  # dotfiles, _inbox/, _sources/: never shipped
+        layer_dir = os.path.join(assets, layer)
+        if not os.path.isdir(layer_dir):
+            continue
+        for rel_dir in sorted(os.listdir(layer_dir)):
+            d = os.path.join(layer_dir, rel_dir)
+            if not os.path.isdir(d):
+                continue
+            for name in sorted(os.listdir(d)):
+                # Not the trimmed twins (trim_sheets.py): build products, which
+                # the loader reads from disk when they are there.
+                if name.endswith(".anim") and not name.endswith(".trim.anim"):
+                    tables.append((f"{layer}/{rel_dir}/{name}",
+                                   anim_clips(os.path.join(d, name))))
+    if not tables:
+        return
+    out.append("// ── animation clip tables (the .anim files, compiled in) ──")
+    rows = []
+    for path, clips in tables:
+        c = f"{prefix}_CLIPS_{sym(path[:-len('.anim')])}"
+        out.append(f"static const SDL_Rect {c}[] = "
+                   f"{{{rects(clip for clip, _ in clips)}}};")
+        trims = "NULL"
+        if any(trim is not None for _, trim in clips):
+            trims = f"{c}_TRIMS"
+            out.append(f"static const SDL_Rect {trims}[] = "
+                       f"{{{rects(t or (0, 0, 0, 0) for _, t in clips)}}};")
+        rows.append(f'{{"{path}", {len(clips)}, {c}, {trims}}}')
+    out.append(f"#define {prefix}_ANIM_CLIPS_COUNT {len(tables)}")
+    out.append(f"#define {prefix}_ANIM_CLIPS_INIT {{{', '.join(rows)}}}")
+    out.append("")
+
+
 def emit_sfx(out, prefix, sfx):
     # The adventure's shared sound-effect bank (SCENES.md milestone 4): the
     # framework loads it once per adventure, and scenes trigger a sound by its
@@ -264,6 +343,8 @@ def main():
         f"#ifndef {guard}",
         f"#define {guard}",
         "",
+        "#include <SDL2/SDL.h>",
+        "",
     ]
     # A generated say_<name>() helper (dialogue dirs) calls scene_say; declare it
     # once so the header stands alone.
@@ -274,6 +355,7 @@ def main():
         out += ["void scene_say(int index);", ""]
     for rel_dir in sorted(groups):
         emit_group(out, prefix, rel_dir, groups[rel_dir])
+    emit_clips(out, prefix, root, manifest)
     emit_sfx(out, prefix, sfx)
     out.append(f"#endif // {guard}")
 
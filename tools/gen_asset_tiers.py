@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Write the half-size resolution tier of every PNG asset (image.c, ASSETS.md).
+
+The art is authored for the 800x600 logical screen. On a display drawn at half
+that or less, image.c uploads <name>@0.5x.png instead of <name>.png when the
+variant sits beside it — a quarter of the texture memory and upload time for
+pixels the screen couldn't show anyway. Sizes and sprite-sheet clips stay
+those of the original (the loader reads its PNG header and scales the .anim
+clips), so nothing else has to know a tier exists.
+
+For each PNG under the asset roots this writes <name>@0.5x.png, Lanczos
+downscaled to half size (rounded, at least 1 px), unless the variant is
+already newer than its source. Art too small to be worth a second file is
+skipped, as are the _inbox/ and _sources/ folders gen_qoi.py skips. Sprite
+sheets are best laid out on even coordinates: an odd clip edge moves inward to
+the next whole half-size pixel, so a frame may lose a sliver of its edge but
+never samples its neighbour's.
+
+Usage:
+  tools/gen_asset_tiers.py [--dry-run] [--force] [root ...]
+
+The roots default to assets/ and every src/adventures/*/assets/.
+
+Requires Pillow (pip install Pillow).
+"""
+
+import argparse
+import glob
+import os
+import re
+
+from PIL import Image
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+TIER = 0.5
+SUFFIX = "@0.5x"
+# Below this on both sides a variant saves next to nothing.
+MIN_SIDE = 64
+TIER_RE = re.compile(r"@[0-9.]+x\.png$")
+SKIP_DIRS = {"_inbox", "_sources"}
+
+
+def default_roots():
+    return [os.path.join(ROOT, "assets")] + sorted(
+        glob.glob(os.path.join(ROOT, "src", "adventures", "*", "assets")))
+
+
+def sources(roots):
+    for root in roots:
+        for dirpath, dirs, filenames in os.walk(root):
+            dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+            for name in sorted(filenames):
+                # trim_sheets.py cuts the trimmed twins' tiers itself.
+                if (name.lower().endswith(".png") and not TIER_RE.search(name)
+                        and not name.endswith(".trim.png")):
+                    yield os.path.join(dirpath, name)
+
+
+def write_tier(path, force, dry_run):
+    """Write path's variant if it is missing or stale; True if it did."""
+    out = path[:-4] + SUFFIX + ".png"
+    if (not force and os.path.exists(out)
+            and os.path.getmtime(out) >= os.path.getmtime(path)):
+        return False
+    with Image.open(path) as image:
+        if image.width < MIN_SIDE and image.height < MIN_SIDE:
+            return False
+        size = (max(1, round(image.width * TIER)),
+                max(1, round(image.height * TIER)))
+        print(f"{os.path.relpath(out, ROOT)}: {image.width}x{image.height} "
+              f"-> {size[0]}x{size[1]}")
+        if dry_run:
+            return True
+        # Keep the mode: an RGB plate stays RGB (and opaque, see
+        # surface_is_opaque), a sprite keeps its alpha.
+        image.resize(size, Image.LANCZOS).save(out, optimize=True)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("roots", nargs="*",
+                        help="asset directories to walk (default: all)")
+    parser.add_argument("--force", action="store_true",
+                        help="rewrite variants even when up to date")
+    parser.add_argument("--dry-run", action="store_true",
+                        help="list what would be written, write nothing")
+    args = parser.parse_args()
+    written = sum(write_tier(path, args.force, args.dry_run)
+                  for path in sources(args.roots or default_roots()))
+    print(f"{written} tier(s) {'to write' if args.dry_run else 'written'}")
+
+
+if __name__ == "__main__":
+    main()
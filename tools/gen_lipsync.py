@@ -13,9 +13,17 @@ the WAV:
   transcript. A forced aligner could replace the estimate later by emitting
   the same format.
 
-Sidecars are committed to the repo, so builds and CI never run this script.
+Sidecars are committed to the repo, so builds and CI never run Rhubarb.
 Regenerate only when a recording or transcript changes.
 
+Each sidecar also gets a binary twin, <name>.bcues / <name>.bwords: the same
+data with delta-encoded times, packed shapes and the words in one string pool
+(layouts in SPEECH.md), which the engine loads without parsing a line. The
+twins are build products (git-ignored). `--compile` writes them from the
+committed text alone, without Rhubarb: `make lipsync` runs it, and every
+build target depends on that. A twin newer than its text, written by this
+version of the tool, is left alone.
+
 Requires the Rhubarb Lip Sync CLI (https://github.com/DanielSWolf/rhubarb-lip-sync,
 tested with 1.13.0): either on PATH or pointed at by $RHUBARB. English locales
 use the transcript-guided recognizer; everything else uses the language-
@@ -24,6 +32,7 @@ agnostic phonetic one.
 
 import argparse
 import os
+import struct
 import subprocess
 import sys
 import tempfile
@@ -32,6 +41,13 @@ import wave
 ADVENTURES_DIR = os.path.join(os.path.dirname(__file__), "..", "src", "adventures")
 ENGLISH_LOCALES = ("en_US",)
 
+# lipsync.h: LIPSYNC_BINARY_VERSION, and the frame each letter plays (the
+# extended shapes G and H collapse onto B and C, as in shape_of).
+BINARY_VERSION = 1
+SHAPES = {"X": 0, "A": 1, "B": 2, "C": 3, "D": 4, "E": 5, "F": 6, "G": 2, "H": 3}
+MAX_CUES = 512
+MAX_WORDS = 64
+
 
 def find_rhubarb():
     exe = os.environ.get("RHUBARB")
@@ -139,10 +155,130 @@ def newer(a, b):
     return os.path.getmtime(a) > os.path.getmtime(b)
 
 
+def sidecar_lines(path):
+    with open(path, encoding="utf-8") as f:
+        return [line.rstrip("\r\n") for line in f if line.strip("\r\n")]
+
+
+def read_cues(path):
+    """[(ms, shape letter), ...] from a .cues file, as strictly as
+    lipsync_parse reads it."""
+    cues = []
+    for line in sidecar_lines(path):
+        ms, _, shape = line.partition(" ")
+        if not ms.isdigit() or shape not in SHAPES:
+            sys.exit(f"{path}: malformed cue {line!r}")
+        if cues and int(ms) < cues[-1][0]:
+            sys.exit(f"{path}: cues out of order at {line!r}")
+        cues.append((int(ms), shape))
+    if not cues or len(cues) > MAX_CUES:
+        sys.exit(f"{path}: {len(cues)} cues (1 to {MAX_CUES} allowed)")
+    return cues
+
+
+def read_words(path):
+    """[(start_ms, end_ms, word), ...] from a .words file, as strictly as
+    lipsync_parse_words reads it."""
+    words = []
+    for line in sidecar_lines(path):
+        parts = line.split(" ", 2)
+        if (len(parts) != 3 or not parts[0].isdigit() or not parts[1].isdigit()
+                or not parts[2] or int(parts[0]) > int(parts[1])):
+            sys.exit(f"{path}: malformed word {line!r}")
+        if words and int(parts[0]) < words[-1][0]:
+            sys.exit(f"{path}: words out of order at {line!r}")
+        words.append((int(parts[0]), int(parts[1]), parts[2]))
+    if not words or len(words) > MAX_WORDS:
+        sys.exit(f"{path}: {len(words)} words (1 to {MAX_WORDS} allowed)")
+    return words
+
+
+def varint(value):
+    """Seven bits a byte, low bits first, the high bit on all but the last."""
+    out = bytearray()
+    while value >= 0x80:
+        out.append(value & 0x7F | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def header(magic, count):
+    return struct.pack("<4sBBH", magic, BINARY_VERSION, 0, count)
+
+
+def encode_cues(cues):
+    """A .bcues: the header, each cue's ms after the previous one, then the
+    shapes two to a byte, the earlier cue in the low nibble."""
+    out = bytearray(header(b"VLCU", len(cues)))
+    last = 0
+    for ms, _shape in cues:
+        out += varint(ms - last)
+        last = ms
+    shapes = [SHAPES[shape] for _ms, shape in cues] + [0]
+    for i in range(0, len(cues), 2):
+        out.append(shapes[i] | shapes[i + 1] << 4)
+    return bytes(out)
+
+
+def encode_words(words):
+    """A .bwords: the header, the pool's size, each word's start after the
+    previous start and its length in ms, then the pool of NUL-terminated
+    words."""
+    pool = b"".join(word.encode("utf-8") + b"\0" for _s, _e, word in words)
+    out = bytearray(header(b"VLWD", len(words)) + struct.pack("<I", len(pool)))
+    last = 0
+    for start, end, _word in words:
+        out += varint(start - last) + varint(end - start)
+        last = start
+    return bytes(out + pool)
+
+
+def twin_is_current(text_path, twin_path):
+    if not os.path.exists(twin_path) or newer(text_path, twin_path):
+        return False
+    with open(twin_path, "rb") as f:
+        return f.read(5)[4:] == bytes((BINARY_VERSION,))
+
+
+def compile_twin(text_path, force=False):
+    """Write the binary twin of a .cues or .words file unless it is
+    current; whether it was written."""
+    base, extension = os.path.splitext(text_path)
+    twin_path = base + ".b" + extension[1:]
+    if not force and twin_is_current(text_path, twin_path):
+        return False
+    if extension == ".cues":
+        data = encode_cues(read_cues(text_path))
+    else:
+        data = encode_words(read_words(text_path))
+    with open(twin_path, "wb") as f:
+        f.write(data)
+    return True
+
+
+def compile_all(force):
+    """`--compile`: a twin for every committed sidecar; no Rhubarb needed."""
+    written = current = 0
+    for root, _dirs, files in sorted(os.walk(ADVENTURES_DIR)):
+        for name in sorted(files):
+            if name.endswith((".cues", ".words")):
+                if compile_twin(os.path.join(root, name), force):
+                    written += 1
+                else:
+                    current += 1
+    print(f"lipsync: {written} binary twins written, {current} up to date")
+
+
 def main():
     parser = argparse.ArgumentParser(description=__doc__)
     parser.add_argument("--force", action="store_true", help="regenerate everything")
+    parser.add_argument("--compile", action="store_true",
+                        help="only write the binary twins of existing sidecars")
     args = parser.parse_args()
+    if args.compile:
+        compile_all(args.force)
+        return
 
     exe = find_rhubarb()
     generated = skipped = 0
@@ -186,6 +322,8 @@ def main():
                 with open(words_path, "w") as f:
                     for start, end, word in estimate_words(text, cues, duration):
                         f.write(f"{start} {end} {word}\n")
+                compile_twin(words_path, force=True)
+            compile_twin(cues_path, force=True)
             rel = os.path.relpath(wav, os.path.join(ADVENTURES_DIR, ".."))
             print(f"lipsync: {rel} -> {len(cues)} cues" + (" + words" if txt_path else ""))
             generated += 1
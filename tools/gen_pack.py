@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Fold each asset root into one <root>.pack (pack.h, ASSETS.md).
+
+A scene load opens dozens of loose files, and a cold start opens hundreds:
+every frame sheet, .anim table, WAV and sidecar, each a syscall round trip
+(and on Android a lookup in the APK's zip directory). The pack is one file per
+asset root holding all of them behind a sorted, hashed directory, so the
+engine opens it once — desktop builds map it into memory — and finds a file
+with a binary search.
+
+The roots are the ones the manifests name (assets/index.json and every
+src/adventures/*/assets/index.json, "assets_root"). A pack holds every shipped
+layer of its root — each locale and common/ — under root-relative paths, so
+the resolver's locale-then-common lookup works unchanged inside it. What ships
+is what the web build preloads: no _inbox/ or _sources/, no manifest, and no
+PNG that has a QOI twin (run `make qoi` first; `make pack` does).
+
+The packs are build products (git-ignored). A pack newer than every file and
+directory of its root is left alone.
+
+Usage:
+  tools/gen_pack.py [--force] [manifest ...]
+
+Standard library only.
+"""
+
+import argparse
+import glob
+import json
+import os
+import struct
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+SKIP_DIRS = {"_inbox", "_sources"}
+MAGIC = b"VPAK"
+VERSION = 1
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<IIII")
+ALIGN = 16
+
+
+def fnv1a(name):
+    """pack_hash: FNV-1a, 32-bit, over the path's UTF-8 bytes."""
+    h = 2166136261
+    for byte in name.encode("utf-8"):
+        h = ((h ^ byte) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def shipped_files(root):
+    """(root-relative path, absolute path) of every file the root ships."""
+    for dirpath, dirs, filenames in os.walk(root):
+        dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+        for name in sorted(filenames):
+            path = os.path.join(dirpath, name)
+            rel = os.path.relpath(path, root).replace(os.sep, "/")
+            if rel == "index.json" or name.startswith("."):
+                continue
+            if (name.lower().endswith(".png")
+                    and os.path.exists(path[:-4] + ".qoi")):
+                continue
+            yield rel, path
+
+
+def newest_mtime(root):
+    newest = os.path.getmtime(root)
+    for dirpath, dirs, filenames in os.walk(root):
+        dirs[:] = [d for d in dirs if d not in SKIP_DIRS]
+        for name in dirs + filenames:
+            newest = max(newest, os.path.getmtime(os.path.join(dirpath, name)))
+    return newest
+
+
+def build_pack(root):
+    """The pack's bytes, and how many files went into it."""
+    files = sorted(shipped_files(root),
+                   key=lambda f: (fnv1a(f[0]), f[0].encode("utf-8")))
+    strings = bytearray()
+    names = []
+    for rel, _path in files:
+        names.append(len(strings))
+        strings += rel.encode("utf-8") + b"\0"
+    base = HEADER.size + ENTRY.size * len(files) + len(strings)
+    entries = bytearray()
+    blobs = bytearray()
+    for (rel, path), name in zip(files, names):
+        blobs += b"\0" * (-(base + len(blobs)) % ALIGN)
+        with open(path, "rb") as f:
+            data = f.read()
+        entries += ENTRY.pack(fnv1a(rel), name, base + len(blobs), len(data))
+        blobs += data
+    header = HEADER.pack(MAGIC, VERSION, len(files), len(strings))
+    return header + entries + strings + blobs, len(files)
+
+
+def manifest_roots(manifests):
+    roots = []
+    for manifest in manifests:
+        with open(manifest) as f:
+            root = json.load(f).get("assets_root")
+        if root is None:
+            sys.exit(f"{manifest}: no assets_root")
+        roots.append(root)
+    return roots
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("manifests", nargs="*",
+                        help="index.json manifests (default: every one)")
+    parser.add_argument("--force", action="store_true",
+                        help="rewrite packs even when up to date")
+    args = parser.parse_args()
+    manifests = args.manifests or [os.path.join(ROOT, "assets", "index.json")]
+    if not args.manifests:
+        manifests += sorted(glob.glob(os.path.join(
+            ROOT, "src", "adventures", "*", "assets", "index.json")))
+    for root in manifest_roots(manifests):
+        path = os.path.join(ROOT, root)
+        out = path + ".pack"
+        if (not args.force and os.path.exists(out)
+                and os.path.getmtime(out) >= newest_mtime(path)):
+            continue
+        data, count = build_pack(path)
+        with open(out, "wb") as f:
+            f.write(data)
+        print(f"gen_pack: {root}.pack, {count} file(s), "
+              f"{len(data) // 1024} KB")
+
+
+if __name__ == "__main__":
+    main()
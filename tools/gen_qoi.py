@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""Write a QOI twin next to every shipped PNG (qoi.c, ASSETS.md).
+
+QOI (https://qoiformat.org) is lossless like PNG but decodes several times
+faster: no inflate, one pass of byte ops. Startup spends most of its time
+inflating PNGs, so the build writes <name>.qoi beside each <name>.png and the
+resolver (asset_prefer_fast) loads the .qoi instead whenever it's there. No
+scene changes: tables keep naming the .png.
+
+The .qoi files are build products (git-ignored). `make qoi` runs this, and
+every build target depends on it. A .qoi newer than its PNG is left alone.
+Run it after `make tiers` so the tier variants get twins too.
+
+Usage:
+  tools/gen_qoi.py [--force] [path ...]
+
+Paths are PNGs or directories to walk; the default is every shipped asset
+root (assets/ and src/adventures/*/assets/, minus _inbox/ and _sources/).
+
+Standard library only: PNGs are read with zlib, so it runs wherever the build
+does. Handles 8-bit non-interlaced PNGs (what the art pipeline writes) and
+fails loudly on anything else rather than shipping a wrong image.
+"""
+
+import argparse
+import glob
+import os
+import struct
+import sys
+import zlib
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+SKIP_DIRS = {"_inbox", "_sources"}
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}  # PNG colour type -> samples/pixel
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Return (width, height, has_alpha, rgba bytes) for an 8-bit PNG."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != PNG_SIGNATURE:
+        sys.exit(f"{path}: not a PNG")
+    pos = 8
+    idat = []
+    palette = b""
+    trns = b""
+    header = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = body
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat.append(body)
+        elif kind == b"IEND":
+            break
+    width, height, depth, color, _comp, _filter, interlace = header
+    if depth != 8 or interlace != 0 or color not in CHANNELS:
+        sys.exit(f"{path}: only 8-bit non-interlaced PNGs are supported "
+                 f"(depth {depth}, colour type {color}, interlace {interlace})")
+    bpp = CHANNELS[color]
+    stride = width * bpp
+    raw = zlib.decompress(b"".join(idat))
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - bpp] if i >= bpp else 0
+            up = prev[i]
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                corner = prev[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + paeth(left, up, corner)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    rgba = bytearray(width * height * 4)
+    o = 0
+    for line in rows:
+        for x in range(width):
+            s = line[x * bpp:(x + 1) * bpp]
+            if color == 6:
+                px = s
+            elif color == 2:
+                px = (s[0], s[1], s[2], 255)
+            elif color == 0:
+                px = (s[0], s[0], s[0], 255)
+            elif color == 4:
+                px = (s[0], s[0], s[0], s[1])
+            else:  # palette
+                i = s[0]
+                a = trns[i] if i < len(trns) else 255
+                px = (palette[3 * i], palette[3 * i + 1], palette[3 * i + 2], a)
+            rgba[o:o + 4] = bytes(px)
+            o += 4
+    has_alpha = color in (4, 6) or bool(trns)
+    return width, height, has_alpha, bytes(rgba)
+
+
+def encode_qoi(width, height, channels, rgba):
+    """The reference encoder's byte stream, op for op."""
+    out = bytearray(b"qoif" + struct.pack(">IIBB", width, height, channels, 0))
+    index = [(0, 0, 0, 0)] * 64
+    prev = (0, 0, 0, 255)
+    run = 0
+    last = width * height - 1
+    for i in range(width * height):
+        px = tuple(rgba[i * 4:i * 4 + 4])
+        if px == prev:
+            run += 1
+            if run == 62 or i == last:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+        if run > 0:
+            out.append(0xC0 | (run - 1))
+            run = 0
+        r, g, b, a = px
+        h = (r * 3 + g * 5 + b * 7 + a * 11) % 64
+        if index[h] == px:
+            out.append(h)
+        else:
+            index[h] = px
+            if a == prev[3]:
+                vr = (r - prev[0] + 128) % 256 - 128
+                vg = (g - prev[1] + 128) % 256 - 128
+                vb = (b - prev[2] + 128) % 256 - 128
+                vg_r = vr - vg
+                vg_b = vb - vg
+                if -3 < vr < 2 and -3 < vg < 2 and -3 < vb < 2:
+                    out.append(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2))
+                elif -9 < vg_r < 8 and -33 < vg < 32 and -9 < vg_b < 8:
+                    out.append(0x80 | (vg + 32))
+                    out.append((vg_r + 8) << 4 | (vg_b + 8))
+                else:
+                    out += bytes((0xFE, r, g, b))
+            else:
+                out += bytes((0xFF, r, g, b, a))
+        prev = px
+    out += b"\x00" * 7 + b"\x01"
+    return bytes(out)
+
+
+def shipped_pngs(paths):
+    roots = paths or [os.path.join(ROOT, "assets")] + sorted(
+        glob.glob(os.path.join(ROOT, "src", "adventures", "*", "assets")))
+    for root in roots:
+        if os.path.isfile(root):
+            yield root
+            continue
+        for dirpath, dirs, filenames in os.walk(root):
+            dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+            for name in sorted(filenames):
+                if name.lower().endswith(".png"):
+                    yield os.path.join(dirpath, name)
+
+
+def write_qoi(path, force):
+    """Write path's .qoi twin unless it is up to date; its sizes if written."""
+    out = path[:-4] + ".qoi"
+    if (not force and os.path.exists(out)
+            and os.path.getmtime(out) >= os.path.getmtime(path)):
+        return None
+    width, height, has_alpha, rgba = read_png(path)
+    data = encode_qoi(width, height, 4 if has_alpha else 3, rgba)
+    with open(out, "wb") as f:
+        f.write(data)
+    return os.path.getsize(path), len(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("paths", nargs="*",
+                        help="PNGs or directories (default: every asset root)")
+    parser.add_argument("--force", action="store_true",
+                        help="rewrite twins even when up to date")
+    args = parser.parse_args()
+    count = png_bytes = qoi_bytes = 0
+    for path in shipped_pngs(args.paths):
+        sizes = write_qoi(path, args.force)
+        if sizes is not None:
+            count += 1
+            png_bytes += sizes[0]
+            qoi_bytes += sizes[1]
+    if count:
+        print(f"gen_qoi: {count} QOI file(s) written, {qoi_bytes // 1024} KB "
+              f"(from {png_bytes // 1024} KB of PNG)")
+
+
+if __name__ == "__main__":
+    main()
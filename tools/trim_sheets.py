@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""Write trimmed twins of the sprite sheets (image.c, .anim format).
+
+Character sheets are authored as fixed-size cells (the hen's walk is 120x120 a
+frame) with a lot of transparent padding around the drawing. Every pixel of
+that padding is uploaded and blended each frame for nothing. For each sheet
+this crops every frame to the bounding box of its non-transparent pixels,
+repacks the crops as the usual vertical strip, and writes the result beside
+the sheet as build products:
+
+    <name>.trim.png        the repacked sheet
+    <name>.trim@0.5x.png   its half-size tier, when the sheet has one
+    <name>.trim.anim       eight fields a row: x,y,w,h,ox,oy,cw,ch
+
+the clip in the new sheet, then where it sat (ox, oy) in its original cw x ch
+cell. The renderers (render_animation and friends) add that offset back and
+measure the frame by its cell, so scenes, anchors and hit boxes don't move.
+The loader takes the twins over the authored pair whenever both are there.
+
+The authored sheet and its .anim stay the source of truth. The twins are
+git-ignored: `make trim` writes them, and `make qoi` (which every build target
+depends on) runs it first. A twin newer than its sheet, .anim and tier is left
+alone; a sheet that would shrink by less than MIN_SAVING gets none (and loses
+a stale one).
+
+Each crop sits in a GUTTER of the original cell's own pixels, transparent
+outside the cell, so a linear-filtered draw at the edge of a clip samples what
+the untrimmed cell had there rather than the next frame. The crops are laid
+out on even coordinates so the tier lines up pixel for pixel with the
+sheet's: each of its frames is cut from the authored sheet's committed tier
+(gen_asset_tiers.py) at the same place, border included, rather than
+downscaled again from the packed strip. A sheet whose tier can't line up (an
+odd width or height) is only trimmed when the trimmed sheet is smaller than
+that tier, and then ships without one.
+
+Usage:
+  tools/trim_sheets.py [--force] [--dry-run] [path ...]
+
+Paths are sheets (PNGs with a sibling .anim) or directories to walk; the
+default is every shipped asset root, as for gen_qoi.py.
+
+Standard library only (PNGs are read with gen_qoi.py's reader), so it runs
+wherever the build does.
+"""
+
+import argparse
+import glob
+import json
+import os
+import struct
+import sys
+import zlib
+
+from gen_qoi import SKIP_DIRS, read_png
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+# Sheets found to have nothing to lose, by path, with the newest of their
+# inputs' mtimes then: later runs pass them over without decoding them.
+UNTRIMMED = os.path.join(ROOT, "build", "trim_sheets.json")
+TWIN = ".trim"
+TIER = "@0.5x"
+# Two pixels, so the half-size tier keeps one.
+GUTTER = 2
+# A sheet trimming would shrink by less than this is left as authored: the
+# twins aren't worth their files.
+MIN_SAVING = 0.1
+
+
+class Image:
+    """RGBA pixels, row-major."""
+
+    def __init__(self, width, height, pixels=None):
+        self.width = width
+        self.height = height
+        self.pixels = bytearray(pixels or bytes(width * height * 4))
+
+    @classmethod
+    def load(cls, path):
+        width, height, _, rgba = read_png(path)
+        return cls(width, height, rgba)
+
+    def alpha_bounds(self, x, y, w, h):
+        """The box (x0, y0, x1, y1) of the visible pixels in a rect, or None."""
+        alpha = self.pixels[3::4]
+        box = None
+        for row in range(y, y + h):
+            line = alpha[row * self.width + x:row * self.width + x + w]
+            if not any(line):
+                continue
+            left = x + len(line) - len(line.lstrip(b"\0"))
+            right = x + len(line.rstrip(b"\0"))
+            if box is None:
+                box = [left, row, right, row + 1]
+            box[0] = min(box[0], left)
+            box[2] = max(box[2], right)
+            box[3] = row + 1
+        return box
+
+    def copy(self, source, box, clip, at):
+        """Copy `box` of `source` to `at`, keeping only what lies in `clip`
+        (the rest stays transparent)."""
+        x0, y0, x1, y1 = box
+        cx0, cy0, cx1, cy1 = clip
+        for row in range(max(y0, cy0), min(y1, cy1)):
+            left, right = max(x0, cx0), min(x1, cx1)
+            if left >= right:
+                return
+            src = (row * source.width + left) * 4
+            dst = ((at[1] + row - y0) * self.width + at[0] + left - x0) * 4
+            self.pixels[dst:dst + (right - left) * 4] = \
+                source.pixels[src:src + (right - left) * 4]
+
+    def save(self, path):
+        stride = self.width * 4
+        raw = b"".join(b"\0" + bytes(self.pixels[y * stride:(y + 1) * stride])
+                       for y in range(self.height))
+
+        def chunk(kind, body):
+            crc = zlib.crc32(kind + body) & 0xFFFFFFFF
+            return struct.pack(">I", len(body)) + kind + body + \
+                struct.pack(">I", crc)
+
+        header = struct.pack(">IIBBBBB", self.width, self.height, 8, 6, 0, 0, 0)
+        with open(path, "wb") as f:
+            f.write(b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", header) +
+                    chunk(b"IDAT", zlib.compress(raw, 9)) +
+                    chunk(b"IEND", b""))
+
+
+def read_anim(path):
+    with open(path, encoding="utf-8") as f:
+        rows = [line.strip() for line in f if line.strip()]
+    return [[int(n) for n in row.split(",")] for row in rows]
+
+
+def even_down(n):
+    return n - n % 2
+
+
+def even_up(n):
+    return n + n % 2
+
+
+def layout(sheet, cells):
+    """Each frame's crop, the padded box it is cut with, and where that box
+    goes in the trimmed strip; and the strip's size."""
+    frames = []
+    top = 0
+    width = 0
+    for x, y, w, h in cells:
+        cell = (x, y, x + w, y + h)
+        # An empty frame keeps a 2x2 corner: the .anim format has no empty
+        # clips.
+        box = sheet.alpha_bounds(x, y, w, h) or [x, y, x + 2, y + 2]
+        # Out to even sheet coordinates (within the cell), so the tier's
+        # pixels cover the crop exactly as they cover the cell.
+        crop = (max(even_down(box[0]), x), max(even_down(box[1]), y),
+                min(even_up(box[2]), x + w), min(even_up(box[3]), y + h))
+        padded = (even_down(crop[0] - GUTTER), even_down(crop[1] - GUTTER),
+                  even_up(crop[2] + GUTTER), even_up(crop[3] + GUTTER))
+        frames.append((cell, crop, padded, top))
+        width = max(width, padded[2] - padded[0])
+        top += padded[3] - padded[1]
+    return frames, width, top
+
+
+def twin_paths(base):
+    return base + TWIN + ".png", base + TWIN + TIER + ".png", base + TWIN + \
+        ".anim"
+
+
+def remove_twins(base):
+    for path in twin_paths(base):
+        if os.path.exists(path):
+            os.remove(path)
+
+
+def trim_sheet(png, force, dry_run, untrimmed):
+    """Write png's twins if it has padding to lose; True if it did. Sheets
+    with none are noted in `untrimmed`."""
+    base = png[:-4]
+    anim = base + ".anim"
+    tier_png = base + TIER + ".png"
+    out_png, out_tier, out_anim = twin_paths(base)
+    newest = max(os.path.getmtime(p) for p in (png, anim, tier_png)
+                 if os.path.exists(p))
+    key = os.path.relpath(png, ROOT)
+    if not force and (untrimmed.get(key) == newest or (
+            os.path.exists(out_anim) and
+            os.path.getmtime(out_anim) >= newest)):
+        return False
+    untrimmed.pop(key, None)
+    cells = read_anim(anim)
+    if any(len(row) != 4 for row in cells):
+        untrimmed[key] = newest  # authored trimmed already
+        return False
+
+    sheet = Image.load(png)
+    frames, width, height = layout(sheet, cells)
+    tier = Image.load(tier_png) if os.path.exists(tier_png) else None
+    aligned = tier is not None and (tier.width * 2, tier.height * 2) == \
+        (sheet.width, sheet.height)
+    after = width * height
+    smaller = after <= sheet.width * sheet.height * (1 - MIN_SAVING)
+    if tier is not None and not aligned:
+        smaller = after <= tier.width * tier.height * (1 - MIN_SAVING)
+    if not smaller:
+        if not dry_run:
+            remove_twins(base)
+            untrimmed[key] = newest
+        return False
+    print(f"{key}: {sheet.width}x{sheet.height} -> {width}x{height} "
+          f"({100 - after * 100 // (sheet.width * sheet.height)}% fewer "
+          f"pixels){'' if aligned or tier is None else ', no tier'}")
+    if dry_run:
+        return True
+
+    out = Image(width, height)
+    half = Image(width // 2, height // 2) if aligned else None
+    lines = []
+    for (cell, crop, padded, top), (_, _, cw, ch) in zip(frames, cells):
+        out.copy(sheet, padded, cell, (0, top))
+        if half is not None:
+            out_box = tuple(n // 2 for n in padded)
+            out_cell = tuple(n // 2 for n in cell)
+            half.copy(tier, out_box, out_cell, (0, top // 2))
+        lines.append(f"{crop[0] - padded[0]},{top + crop[1] - padded[1]},"
+                     f"{crop[2] - crop[0]},{crop[3] - crop[1]},"
+                     f"{crop[0] - cell[0]},{crop[1] - cell[1]},{cw},{ch}")
+
+    # The .anim last: the loader takes the twins only once it is there.
+    out.save(out_png)
+    if half is not None:
+        half.save(out_tier)
+    elif os.path.exists(out_tier):
+        os.remove(out_tier)
+    with open(out_anim, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    return True
+
+
+def sheets(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for dirpath, dirs, filenames in os.walk(path):
+            dirs[:] = sorted(d for d in dirs if d not in SKIP_DIRS)
+            for name in sorted(filenames):
+                stem = name[:-4]
+                if (name.endswith(".png") and not stem.endswith(TWIN) and
+                        TIER not in stem and stem + ".anim" in filenames):
+                    yield os.path.join(dirpath, name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("paths", nargs="*",
+                        help="sheets or directories (default: every asset "
+                             "root)")
+    parser.add_argument("--force", action="store_true",
+                        help="rewrite twins even when up to date")
+    parser.add_argument("--dry-run", action="store_true",
+                        help="report the savings without writing anything")
+    args = parser.parse_args()
+    try:
+        with open(UNTRIMMED, encoding="utf-8") as f:
+            untrimmed = json.load(f)
+    except (OSError, ValueError):
+        untrimmed = {}
+    roots = args.paths or [os.path.join(ROOT, "assets")] + sorted(
+        glob.glob(os.path.join(ROOT, "src", "adventures", "*", "assets")))
+    written = sum(trim_sheet(png, args.force, args.dry_run, untrimmed)
+                  for png in sheets(roots))
+    if not args.dry_run:
+        os.makedirs(os.path.dirname(UNTRIMMED), exist_ok=True)
+        with open(UNTRIMMED, "w", encoding="utf-8") as f:
+            json.dump(untrimmed, f, indent=1, sort_keys=True)
+    if written:
+        print(f"trim_sheets: {written} sheet(s) "
+              f"{'to trim' if args.dry_run else 'trimmed'}")
+
+
+if __name__ == "__main__":
+    main()